@@ -0,0 +1,209 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan>
+#include <experimental/mdspan_algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "fill.hpp"
+
+namespace stdex = std::experimental;
+
+//================================================================================
+
+// Mappings for an n0 x n1 array: layout_right, layout_left, and a layout_stride
+// with row-major order and each row padded by 16 elements.
+template <class Layout>
+struct make_mapping {
+  static typename Layout::template mapping<stdex::dextents<2>> apply(size_t n0, size_t n1) {
+    return typename Layout::template mapping<stdex::dextents<2>>(stdex::dextents<2>(n0, n1));
+  }
+};
+
+template <>
+struct make_mapping<stdex::layout_stride> {
+  static stdex::layout_stride::mapping<stdex::dextents<2>> apply(size_t n0, size_t n1) {
+    return stdex::layout_stride::mapping<stdex::dextents<2>>(
+      stdex::dextents<2>(n0, n1), std::array<size_t, 2>{n1 + 16, 1});
+  }
+};
+
+template <class T, class SrcLayout, class DstLayout>
+struct copy_2d_fixture {
+  using src_type = stdex::mdspan<T, stdex::dextents<2>, SrcLayout>;
+  using dst_type = stdex::mdspan<T, stdex::dextents<2>, DstLayout>;
+  copy_2d_fixture(size_t n0, size_t n1)
+    : src_map(make_mapping<SrcLayout>::apply(n0, n1)),
+      dst_map(make_mapping<DstLayout>::apply(n0, n1)),
+      src_buffer(std::make_unique<T[]>(src_map.required_span_size())),
+      dst_buffer(std::make_unique<T[]>(dst_map.required_span_size()))
+  {
+    mdspan_benchmark::fill_random(src());
+  }
+  src_type src() const { return src_type(src_buffer.get(), src_map); }
+  dst_type dst() const { return dst_type(dst_buffer.get(), dst_map); }
+  typename src_type::mapping_type src_map;
+  typename dst_type::mapping_type dst_map;
+  std::unique_ptr<T[]> src_buffer;
+  std::unique_ptr<T[]> dst_buffer;
+};
+
+// The loop most code writes: row-major over the index space, whatever the
+// layouts are.
+template <class T, class SrcLayout, class DstLayout>
+void BM_MDSpan_Copy_2D_loop(benchmark::State& state, T, SrcLayout, DstLayout, size_t n0, size_t n1) {
+  copy_2d_fixture<T, SrcLayout, DstLayout> f(n0, n1);
+  auto s = f.src();
+  auto d = f.dst();
+  for (auto _ : state) {
+    for(size_t i = 0; i < s.extent(0); ++i) {
+      for (size_t j = 0; j < s.extent(1); ++j) {
+        d(i, j) = s(i, j);
+      }
+    }
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(d.data());
+  }
+  state.SetBytesProcessed(2 * s.size() * sizeof(T) * state.iterations());
+}
+
+template <class T, class SrcLayout, class DstLayout>
+void BM_MDSpan_Copy_2D_copy(benchmark::State& state, T, SrcLayout, DstLayout, size_t n0, size_t n1) {
+  copy_2d_fixture<T, SrcLayout, DstLayout> f(n0, n1);
+  auto s = f.src();
+  auto d = f.dst();
+  for (auto _ : state) {
+    stdex::copy(s, d);
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(d.data());
+  }
+  state.SetBytesProcessed(2 * s.size() * sizeof(T) * state.iterations());
+}
+
+#define MDSPAN_BENCHMARK_COPY_LAYOUTS(T, src, dst, n0, n1) \
+  BENCHMARK_CAPTURE(BM_MDSpan_Copy_2D_loop, T##_##src##_to_##dst##_##n0##_##n1, \
+    T(), stdex::layout_##src(), stdex::layout_##dst(), n0, n1); \
+  BENCHMARK_CAPTURE(BM_MDSpan_Copy_2D_copy, T##_##src##_to_##dst##_##n0##_##n1, \
+    T(), stdex::layout_##src(), stdex::layout_##dst(), n0, n1)
+
+#define MDSPAN_BENCHMARK_COPY_ALL_LAYOUTS(T, n0, n1) \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, right, right, n0, n1); \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, right, left, n0, n1); \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, right, stride, n0, n1); \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, left, right, n0, n1); \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, left, left, n0, n1); \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, left, stride, n0, n1); \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, stride, right, n0, n1); \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, stride, left, n0, n1); \
+  MDSPAN_BENCHMARK_COPY_LAYOUTS(T, stride, stride, n0, n1)
+
+MDSPAN_BENCHMARK_COPY_ALL_LAYOUTS(float, 100, 100);
+MDSPAN_BENCHMARK_COPY_ALL_LAYOUTS(float, 2000, 2000);
+MDSPAN_BENCHMARK_COPY_ALL_LAYOUTS(double, 2000, 2000);
+
+//================================================================================
+
+// 3D layout_right to layout_left: no loop order is contiguous for both sides.
+template <class T>
+struct copy_3d_fixture {
+  using src_type = stdex::mdspan<T, stdex::dextents<3>, stdex::layout_right>;
+  using dst_type = stdex::mdspan<T, stdex::dextents<3>, stdex::layout_left>;
+  explicit copy_3d_fixture(size_t n)
+    : src_buffer(std::make_unique<T[]>(n * n * n)),
+      dst_buffer(std::make_unique<T[]>(n * n * n)),
+      src(src_buffer.get(), n, n, n),
+      dst(dst_buffer.get(), n, n, n)
+  {
+    mdspan_benchmark::fill_random(src);
+  }
+  std::unique_ptr<T[]> src_buffer;
+  std::unique_ptr<T[]> dst_buffer;
+  src_type src;
+  dst_type dst;
+};
+
+template <class T>
+void BM_MDSpan_Copy_3D_right_to_left_loop(benchmark::State& state, T, size_t n) {
+  copy_3d_fixture<T> f(n);
+  auto s = f.src;
+  auto d = f.dst;
+  for (auto _ : state) {
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) {
+        for(size_t k = 0; k < n; ++k) {
+          d(i, j, k) = s(i, j, k);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(d.data());
+  }
+  state.SetBytesProcessed(2 * s.size() * sizeof(T) * state.iterations());
+}
+
+template <class T>
+void BM_MDSpan_Copy_3D_right_to_left_cache_oblivious(benchmark::State& state, T, size_t n) {
+  copy_3d_fixture<T> f(n);
+  auto s = f.src;
+  auto d = f.dst;
+  for (auto _ : state) {
+    stdex::for_each_index_cache_oblivious(d.mapping(), [=](size_t i, size_t j, size_t k) {
+      d(i, j, k) = s(i, j, k);
+    });
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(d.data());
+  }
+  state.SetBytesProcessed(2 * s.size() * sizeof(T) * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_MDSpan_Copy_3D_right_to_left_loop, float_200, float(), 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Copy_3D_right_to_left_cache_oblivious, float_200, float(), 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Copy_3D_right_to_left_loop, double_256, double(), 256);
+BENCHMARK_CAPTURE(BM_MDSpan_Copy_3D_right_to_left_cache_oblivious, double_256, double(), 256);
+
+//================================================================================
+
+BENCHMARK_MAIN();
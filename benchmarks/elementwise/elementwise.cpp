@@ -0,0 +1,160 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan>
+#include <experimental/mdspan_algorithm>
+
+#include <memory>
+
+#include "fill.hpp"
+
+//================================================================================
+
+template <class T, size_t... Es>
+using lmdspan = stdex::mdspan<T, stdex::extents<Es...>, stdex::layout_left>;
+template <class T, size_t... Es>
+using rmdspan = stdex::mdspan<T, stdex::extents<Es...>, stdex::layout_right>;
+
+// A five-step update of o from s and a:
+//
+//   o += s;  o *= 0.5;  o -= a;  o += 0.25 * s;  o *= 0.75
+//
+// once as five passes of transform (each reading and writing all of o), once
+// as a single fused assign of the whole expression.  Bytes are counted as for
+// the five passes, so the rates compare directly.
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Elementwise_Pipeline_Passes(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_o = std::make_unique<value_type[]>(buffer_size);
+  auto o = MDSpan{buffer_o.get(), dyn...};
+  mdspan_benchmark::fill_random(o);
+  auto buffer_s = std::make_unique<value_type[]>(buffer_size);
+  auto s = MDSpan{buffer_s.get(), dyn...};
+  mdspan_benchmark::fill_random(s);
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), dyn...};
+  mdspan_benchmark::fill_random(a);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(o.data());
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(a.data());
+    stdex::transform(stdex::execution::seq, o, s, o, [](value_type x, value_type y) { return x + y; });
+    stdex::transform(stdex::execution::seq, o, o, [](value_type x) { return x * value_type(0.5); });
+    stdex::transform(stdex::execution::seq, o, a, o, [](value_type x, value_type y) { return x - y; });
+    stdex::transform(stdex::execution::seq, o, s, o, [](value_type x, value_type y) { return x + value_type(0.25) * y; });
+    stdex::transform(stdex::execution::seq, o, o, [](value_type x) { return x * value_type(0.75); });
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed( o.size() * 13 * sizeof(value_type) * state.iterations() );
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Elementwise_Pipeline_Passes, right_, rmdspan<double, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Elementwise_Pipeline_Passes, left_, lmdspan<double, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Elementwise_Pipeline_Passes, right_static_, rmdspan<double, 200, 200, 200>());
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Elementwise_Pipeline_Fused(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_o = std::make_unique<value_type[]>(buffer_size);
+  auto o = MDSpan{buffer_o.get(), dyn...};
+  mdspan_benchmark::fill_random(o);
+  auto buffer_s = std::make_unique<value_type[]>(buffer_size);
+  auto s = MDSpan{buffer_s.get(), dyn...};
+  mdspan_benchmark::fill_random(s);
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), dyn...};
+  mdspan_benchmark::fill_random(a);
+
+  const value_type half(0.5), quarter(0.25), three_quarters(0.75);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(o.data());
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(a.data());
+    stdex::assign(o, (((stdex::elementwise(o) + s) * half - a) + quarter * stdex::elementwise(s)) * three_quarters);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed( o.size() * 13 * sizeof(value_type) * state.iterations() );
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Elementwise_Pipeline_Fused, right_, rmdspan<double, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Elementwise_Pipeline_Fused, left_, lmdspan<double, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Elementwise_Pipeline_Fused, right_static_, rmdspan<double, 200, 200, 200>());
+
+// The same update written out by hand over raw pointers.
+template <class T>
+void BM_Raw_Elementwise_Pipeline(benchmark::State& state, T, size_t n) {
+
+  using MDSpan = stdex::mdspan<T, stdex::dextents<1>>;
+  auto buffer_o = std::make_unique<T[]>(n);
+  auto buffer_s = std::make_unique<T[]>(n);
+  auto buffer_a = std::make_unique<T[]>(n);
+  mdspan_benchmark::fill_random(MDSpan{buffer_o.get(), n});
+  mdspan_benchmark::fill_random(MDSpan{buffer_s.get(), n});
+  mdspan_benchmark::fill_random(MDSpan{buffer_a.get(), n});
+  T* o = buffer_o.get();
+  T* s = buffer_s.get();
+  T* a = buffer_a.get();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(o);
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(a);
+    for(size_t i = 0; i < n; i ++) {
+      o[i] = (((o[i] + s[i]) * T(0.5) - a[i]) + T(0.25) * s[i]) * T(0.75);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed( n * 13 * sizeof(T) * state.iterations() );
+}
+BENCHMARK_CAPTURE(BM_Raw_Elementwise_Pipeline, size_200_200_200, double(), size_t(200 * 200 * 200));
+
+//================================================================================
+
+BENCHMARK_MAIN();
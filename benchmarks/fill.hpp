@@ -45,9 +45,12 @@
 #define MDSPAN_BENCHMARKS_FILL_HPP
 
 #include <experimental/mdspan>
+#include <experimental/mdspan_accessors>
+#include <experimental/mdspan_algorithm>
 
 #include <benchmark/benchmark.h>
 
+#include <array>
 #include <memory>
 #include <random>
 
@@ -81,40 +84,32 @@ std::unique_ptr<T> make_unique(Args&&... args) {
 
 namespace mdspan_benchmark {
 
-namespace _impl {
-
-template <class, class T>
-T&& _repeated_with(T&& v) noexcept { return std::forward<T>(v); }
-
-template <class T, class... Rest, class RNG, class Dist>
-void _do_fill_random(
-  std::experimental::mdspan<T, std::experimental::extents<>, Rest...> s,
-  RNG& gen,
-  Dist& dist
-)
-{
-  s() = dist(gen);
-}
-
-template <class T, size_t E, size_t... Es, class... Rest, class RNG, class Dist>
-void _do_fill_random(
-  std::experimental::mdspan<T, std::experimental::extents<E, Es...>, Rest...> s,
-  RNG& gen,
-  Dist& dist
-)
-{
-  for(size_t i = 0; i < s.extent(0); ++i) {
-    _do_fill_random(std::experimental::submdspan(s, i, _repeated_with<decltype(Es)>(std::experimental::full_extent)...), gen, dist);
-  }
-}
-
-} // end namespace _impl
-
 template <class T, class E, class... Rest>
 void fill_random(std::experimental::mdspan<T, E, Rest...> s, long long seed = 1234) {
   std::mt19937 gen(seed);
   auto val_dist = std::uniform_int_distribution<>(0, 127);
-  _impl::_do_fill_random(s, gen, val_dist);
+  // Walk the extents (not the mapping) so the values land in row-major
+  // order regardless of layout, keeping results comparable across layouts.
+  stdex::for_each_index(s.extents(), [&](auto... idxs) {
+    s[std::array<size_t, sizeof...(idxs)>{{size_t(idxs)...}}] = val_dist(gen);
+  });
+}
+
+// Run `kernel` once more, untimed, on a counting view of `s` that feeds a
+// simulated 32 KiB, 8-way L1 data cache, and report the bytes moved by the
+// simulated misses as a "traffic" rate next to SetBytesProcessed.  Call this
+// after the timing loop so the iteration count is known.
+template <class MDSpan, class Kernel>
+void report_traffic(benchmark::State& state, MDSpan s, Kernel&& kernel) {
+  stdex::cache_simulator cache(32 * 1024, 64, 8);
+  stdex::access_counters counters;
+  counters.simulate(&cache);
+  kernel(stdex::make_counting_mdspan(s, counters));
+  state.counters["traffic"] = benchmark::Counter(
+    double(cache.misses() * cache.line_bytes()),
+    benchmark::Counter::kIsIterationInvariantRate,
+    benchmark::Counter::OneK::kIs1024
+  );
 }
 
 } // namespace mdspan_benchmark
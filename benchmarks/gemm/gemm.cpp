@@ -0,0 +1,163 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan>
+#include <experimental/linalg>
+
+#include <memory>
+#include <vector>
+
+#include "fill.hpp"
+
+//================================================================================
+
+template <class T>
+using lmatrix = stdex::mdspan<T, stdex::dextents<2>, stdex::layout_left>;
+template <class T>
+using rmatrix = stdex::mdspan<T, stdex::dextents<2>, stdex::layout_right>;
+template <class T>
+using smatrix = stdex::mdspan<T, stdex::dextents<2>, stdex::layout_stride>;
+
+// n x n matrices; the strided ones are row-major with rows padded by 16
+// elements, as a block of a larger matrix would be.
+template <class T>
+size_t gemm_buffer_size(lmatrix<T>, size_t n) { return n * n; }
+template <class T>
+size_t gemm_buffer_size(rmatrix<T>, size_t n) { return n * n; }
+template <class T>
+size_t gemm_buffer_size(smatrix<T>, size_t n) { return n * (n + 16); }
+
+template <class T>
+lmatrix<T> gemm_matrix(lmatrix<T>, T* p, size_t n) { return lmatrix<T>(p, n, n); }
+template <class T>
+rmatrix<T> gemm_matrix(rmatrix<T>, T* p, size_t n) { return rmatrix<T>(p, n, n); }
+template <class T>
+smatrix<T> gemm_matrix(smatrix<T>, T* p, size_t n) {
+  return smatrix<T>(p, typename stdex::layout_stride::template mapping<stdex::dextents<2>>(
+    stdex::dextents<2>(n, n), std::array<size_t, 2>{n + 16, 1}));
+}
+
+template <class MDSpan>
+struct gemm_operands {
+  using value_type = typename MDSpan::value_type;
+  std::vector<value_type> a_buffer, b_buffer, c_buffer;
+  MDSpan A, B, C;
+
+  explicit gemm_operands(size_t n)
+    : a_buffer(gemm_buffer_size(MDSpan(), n)), b_buffer(a_buffer.size()), c_buffer(a_buffer.size()),
+      A(gemm_matrix(MDSpan(), a_buffer.data(), n)),
+      B(gemm_matrix(MDSpan(), b_buffer.data(), n)),
+      C(gemm_matrix(MDSpan(), c_buffer.data(), n))
+  {
+    mdspan_benchmark::fill_random(A);
+    mdspan_benchmark::fill_random(B, 4321);
+  }
+};
+
+template <class MDSpan>
+void set_gemm_counters(benchmark::State& state, MDSpan const& C) {
+  const double n = double(C.extent(0));
+  state.counters["FLOPS"] = benchmark::Counter(2 * n * n * n,
+    benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::OneK::kIs1000);
+}
+
+//================================================================================
+
+template <class MDSpan>
+void BM_Naive_GEMM(benchmark::State& state, MDSpan, size_t n) {
+  gemm_operands<MDSpan> op(n);
+  auto A = op.A; auto B = op.B; auto C = op.C;
+  using value_type = typename MDSpan::value_type;
+  for (auto _ : state) {
+    for(size_t i = 0; i < n; i ++) {
+      for(size_t j = 0; j < n; j ++) {
+        value_type sum = 0;
+        for(size_t p = 0; p < n; p ++) {
+          sum += A(i, p) * B(p, j);
+        }
+        C(i, j) = sum;
+      }
+    }
+    benchmark::DoNotOptimize(C.data());
+    benchmark::ClobberMemory();
+  }
+  set_gemm_counters(state, C);
+}
+BENCHMARK_CAPTURE(BM_Naive_GEMM, right_float_256, rmatrix<float>(), 256);
+BENCHMARK_CAPTURE(BM_Naive_GEMM, right_float_1024, rmatrix<float>(), 1024);
+BENCHMARK_CAPTURE(BM_Naive_GEMM, right_double_1024, rmatrix<double>(), 1024);
+BENCHMARK_CAPTURE(BM_Naive_GEMM, left_float_1024, lmatrix<float>(), 1024);
+
+template <class MDSpan>
+void BM_MDSpan_GEMM(benchmark::State& state, MDSpan, size_t n) {
+  gemm_operands<MDSpan> op(n);
+  for (auto _ : state) {
+    stdex::linalg::matrix_product(op.A, op.B, op.C);
+    benchmark::DoNotOptimize(op.C.data());
+    benchmark::ClobberMemory();
+  }
+  set_gemm_counters(state, op.C);
+}
+BENCHMARK_CAPTURE(BM_MDSpan_GEMM, right_float_256, rmatrix<float>(), 256);
+BENCHMARK_CAPTURE(BM_MDSpan_GEMM, right_float_1024, rmatrix<float>(), 1024);
+BENCHMARK_CAPTURE(BM_MDSpan_GEMM, right_double_1024, rmatrix<double>(), 1024);
+BENCHMARK_CAPTURE(BM_MDSpan_GEMM, left_float_1024, lmatrix<float>(), 1024);
+BENCHMARK_CAPTURE(BM_MDSpan_GEMM, stride_float_1024, smatrix<float>(), 1024);
+
+template <class MDSpan>
+void BM_MDSpan_GEMM_par(benchmark::State& state, MDSpan, size_t n) {
+  gemm_operands<MDSpan> op(n);
+  for (auto _ : state) {
+    stdex::linalg::matrix_product(stdex::execution::par, op.A, op.B, op.C);
+    benchmark::DoNotOptimize(op.C.data());
+    benchmark::ClobberMemory();
+  }
+  set_gemm_counters(state, op.C);
+}
+BENCHMARK_CAPTURE(BM_MDSpan_GEMM_par, right_float_1024, rmatrix<float>(), 1024)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_GEMM_par, right_double_1024, rmatrix<double>(), 1024)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -42,6 +42,10 @@
 */
 
 #include <experimental/mdspan>
+#include <experimental/mdspan_memory>
+#include <experimental/mdarray>
+#include <experimental/mdspan_algorithm>
+#include <experimental/linalg>
 
 #include <memory>
 #include <random>
@@ -69,24 +73,6 @@ void throw_runtime_exception(const std::string &msg) {
   throw std::runtime_error(o.str());
 }
 
-template<class MDSpan>
-void OpenMP_first_touch_2D(MDSpan s) {
-  #pragma omp parallel for
-  for(size_t i = 0; i < s.extent(0); i ++) {
-    for(size_t j = 0; j < s.extent(1); j ++) {
-      s(i,j) = 0;
-    }
-  }
-}
-
-template<class MDSpan>
-void OpenMP_first_touch_1D(MDSpan s) {
-  #pragma omp parallel for
-  for(size_t i = 0; i < s.extent(0); i ++) {
-    s(i) = 0;
-  }
-}
-
 //================================================================================
 
 template <class MDSpanMatrix, class... DynSizes>
@@ -95,22 +81,23 @@ void BM_MDSpan_OpenMP_MatVec(benchmark::State& state, MDSpanMatrix, DynSizes...
   using value_type = typename MDSpanMatrix::value_type;
   using MDSpanVector = lmdspan<value_type,stdex::dynamic_extent>;
 
-  auto buffer_size_A = MDSpanMatrix{nullptr, dyn...}.mapping().required_span_size();
-  auto buffer_A = std::make_unique<value_type[]>(buffer_size_A);
-  auto A = MDSpanMatrix{buffer_A.get(), dyn...};
-  OpenMP_first_touch_2D(A);
+  auto buffer_A = stdex::numa_mdarray<
+    value_type, typename MDSpanMatrix::extents_type, typename MDSpanMatrix::layout_type
+  >(typename MDSpanMatrix::extents_type(dyn...), stdex::numa_allocator<value_type>());
+  auto A = MDSpanMatrix{buffer_A.to_mdspan()};
+  stdex::first_touch(A);
   mdspan_benchmark::fill_random(A);
 
-  auto buffer_size_x = MDSpanVector{nullptr, A.extent(1)}.mapping().required_span_size();
-  auto buffer_x = std::make_unique<value_type[]>(buffer_size_x);
-  auto x = MDSpanVector{buffer_x.get(), A.extent(1)};
-  OpenMP_first_touch_1D(x);
+  auto buffer_x = stdex::numa_mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(
+    stdex::dextents<1>(A.extent(1)), stdex::numa_allocator<value_type>());
+  auto x = MDSpanVector{buffer_x.to_mdspan()};
+  stdex::first_touch(x);
   mdspan_benchmark::fill_random(x);
 
-  auto buffer_size_y = MDSpanVector{nullptr, A.extent(0)}.mapping().required_span_size();
-  auto buffer_y = std::make_unique<value_type[]>(buffer_size_y);
-  auto y = MDSpanVector{buffer_y.get(), A.extent(0)};
-  OpenMP_first_touch_1D(y);
+  auto buffer_y = stdex::numa_mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(
+    stdex::dextents<1>(A.extent(0)), stdex::numa_allocator<value_type>());
+  auto y = MDSpanVector{buffer_y.to_mdspan()};
+  stdex::first_touch(y);
   mdspan_benchmark::fill_random(y);
 
   #pragma omp parallel for
@@ -154,22 +141,23 @@ void BM_MDSpan_OpenMP_MatVec_Raw_Left(benchmark::State& state, MDSpanMatrix, Dyn
   using value_type = typename MDSpanMatrix::value_type;
   using MDSpanVector = lmdspan<value_type,stdex::dynamic_extent>;
 
-  auto buffer_size_A = MDSpanMatrix{nullptr, dyn...}.mapping().required_span_size();
-  auto buffer_A = std::make_unique<value_type[]>(buffer_size_A);
-  auto A = MDSpanMatrix{buffer_A.get(), dyn...};
-  OpenMP_first_touch_2D(A);
+  auto buffer_A = stdex::numa_mdarray<
+    value_type, typename MDSpanMatrix::extents_type, typename MDSpanMatrix::layout_type
+  >(typename MDSpanMatrix::extents_type(dyn...), stdex::numa_allocator<value_type>());
+  auto A = MDSpanMatrix{buffer_A.to_mdspan()};
+  stdex::first_touch(A);
   mdspan_benchmark::fill_random(A);
 
-  auto buffer_size_x = MDSpanVector{nullptr, A.extent(1)}.mapping().required_span_size();
-  auto buffer_x = std::make_unique<value_type[]>(buffer_size_x);
-  auto x = MDSpanVector{buffer_x.get(), A.extent(1)};
-  OpenMP_first_touch_1D(x);
+  auto buffer_x = stdex::numa_mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(
+    stdex::dextents<1>(A.extent(1)), stdex::numa_allocator<value_type>());
+  auto x = MDSpanVector{buffer_x.to_mdspan()};
+  stdex::first_touch(x);
   mdspan_benchmark::fill_random(x);
 
-  auto buffer_size_y = MDSpanVector{nullptr, A.extent(0)}.mapping().required_span_size();
-  auto buffer_y = std::make_unique<value_type[]>(buffer_size_y);
-  auto y = MDSpanVector{buffer_y.get(), A.extent(0)};
-  OpenMP_first_touch_1D(y);
+  auto buffer_y = stdex::numa_mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(
+    stdex::dextents<1>(A.extent(0)), stdex::numa_allocator<value_type>());
+  auto y = MDSpanVector{buffer_y.to_mdspan()};
+  stdex::first_touch(y);
   mdspan_benchmark::fill_random(y);
 
   size_t N = A.extent(0);
@@ -218,22 +206,23 @@ void BM_MDSpan_OpenMP_MatVec_Raw_Right(benchmark::State& state, MDSpanMatrix, Dy
   using value_type = typename MDSpanMatrix::value_type;
   using MDSpanVector = lmdspan<value_type,stdex::dynamic_extent>;
 
-  auto buffer_size_A = MDSpanMatrix{nullptr, dyn...}.mapping().required_span_size();
-  auto buffer_A = std::make_unique<value_type[]>(buffer_size_A);
-  auto A = MDSpanMatrix{buffer_A.get(), dyn...};
-  OpenMP_first_touch_2D(A);
+  auto buffer_A = stdex::numa_mdarray<
+    value_type, typename MDSpanMatrix::extents_type, typename MDSpanMatrix::layout_type
+  >(typename MDSpanMatrix::extents_type(dyn...), stdex::numa_allocator<value_type>());
+  auto A = MDSpanMatrix{buffer_A.to_mdspan()};
+  stdex::first_touch(A);
   mdspan_benchmark::fill_random(A);
 
-  auto buffer_size_x = MDSpanVector{nullptr, A.extent(1)}.mapping().required_span_size();
-  auto buffer_x = std::make_unique<value_type[]>(buffer_size_x);
-  auto x = MDSpanVector{buffer_x.get(), A.extent(1)};
-  OpenMP_first_touch_1D(x);
+  auto buffer_x = stdex::numa_mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(
+    stdex::dextents<1>(A.extent(1)), stdex::numa_allocator<value_type>());
+  auto x = MDSpanVector{buffer_x.to_mdspan()};
+  stdex::first_touch(x);
   mdspan_benchmark::fill_random(x);
 
-  auto buffer_size_y = MDSpanVector{nullptr, A.extent(0)}.mapping().required_span_size();
-  auto buffer_y = std::make_unique<value_type[]>(buffer_size_y);
-  auto y = MDSpanVector{buffer_y.get(), A.extent(0)};
-  OpenMP_first_touch_1D(y);
+  auto buffer_y = stdex::numa_mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(
+    stdex::dextents<1>(A.extent(0)), stdex::numa_allocator<value_type>());
+  auto y = MDSpanVector{buffer_y.to_mdspan()};
+  stdex::first_touch(y);
   mdspan_benchmark::fill_random(y);
 
   size_t N = A.extent(0);
@@ -278,4 +267,183 @@ BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatVec_Raw_Right, right, rmdspan<double,stdex
 
 //================================================================================
 
+// linalg::matrix_vector_product picks the kernel from the layout of A: dot
+// products over the rows of layout_right, column updates of a block of y for
+// layout_left.
+
+template <class MDSpanMatrix, class... DynSizes>
+void BM_MDSpan_Linalg_MatVec(benchmark::State& state, MDSpanMatrix, DynSizes... dyn) {
+
+  using value_type = typename MDSpanMatrix::value_type;
+  using MDSpanVector = lmdspan<value_type,stdex::dynamic_extent>;
+
+  auto buffer_A = stdex::numa_mdarray<
+    value_type, typename MDSpanMatrix::extents_type, typename MDSpanMatrix::layout_type
+  >(typename MDSpanMatrix::extents_type(dyn...), stdex::numa_allocator<value_type>());
+  auto A = MDSpanMatrix{buffer_A.to_mdspan()};
+  stdex::first_touch(A);
+  mdspan_benchmark::fill_random(A);
+
+  auto buffer_x = stdex::numa_mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(
+    stdex::dextents<1>(A.extent(1)), stdex::numa_allocator<value_type>());
+  auto x = MDSpanVector{buffer_x.to_mdspan()};
+  stdex::first_touch(x);
+  mdspan_benchmark::fill_random(x);
+
+  auto buffer_y = stdex::numa_mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(
+    stdex::dextents<1>(A.extent(0)), stdex::numa_allocator<value_type>());
+  auto y = MDSpanVector{buffer_y.to_mdspan()};
+  stdex::first_touch(y);
+  mdspan_benchmark::fill_random(y);
+
+  int R = 10;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    benchmark::DoNotOptimize(y.data());
+    benchmark::DoNotOptimize(x.data());
+    for(int r=0; r<R; r++) {
+      stdex::linalg::matrix_vector_product(stdex::execution::par, A, x, y, y);
+    }
+    benchmark::ClobberMemory();
+  }
+  size_t num_elements = 2 * A.extent(0) * A.extent(1) + 2 * A.extent(0);
+  state.SetBytesProcessed( R * num_elements * sizeof(value_type) * state.iterations() * global_repeat);
+  state.counters["repeats"] = global_repeat;
+}
+
+BENCHMARK_CAPTURE(BM_MDSpan_Linalg_MatVec, left, lmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 100000, 5000);
+BENCHMARK_CAPTURE(BM_MDSpan_Linalg_MatVec, right, rmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 100000, 5000);
+
+// Four right-hand sides at once: A is read once per pass instead of four
+// times.  Bytes are counted as for four single products, so the rate is
+// comparable with BM_MDSpan_Linalg_MatVec.
+template <class MDSpanMatrix, class... DynSizes>
+void BM_MDSpan_Linalg_MatVec_MultiRHS(benchmark::State& state, MDSpanMatrix, DynSizes... dyn) {
+
+  using value_type = typename MDSpanMatrix::value_type;
+  using MDSpanBlock = lmdspan<value_type,stdex::dynamic_extent,4>;
+
+  auto buffer_A = stdex::numa_mdarray<
+    value_type, typename MDSpanMatrix::extents_type, typename MDSpanMatrix::layout_type
+  >(typename MDSpanMatrix::extents_type(dyn...), stdex::numa_allocator<value_type>());
+  auto A = MDSpanMatrix{buffer_A.to_mdspan()};
+  stdex::first_touch(A);
+  mdspan_benchmark::fill_random(A);
+
+  auto buffer_x = stdex::numa_mdarray<value_type, stdex::extents<stdex::dynamic_extent,4>, stdex::layout_left>(
+    stdex::extents<stdex::dynamic_extent,4>(A.extent(1)), stdex::numa_allocator<value_type>());
+  auto x = MDSpanBlock{buffer_x.to_mdspan()};
+  stdex::first_touch(x);
+  mdspan_benchmark::fill_random(x);
+
+  auto buffer_y = stdex::numa_mdarray<value_type, stdex::extents<stdex::dynamic_extent,4>, stdex::layout_left>(
+    stdex::extents<stdex::dynamic_extent,4>(A.extent(0)), stdex::numa_allocator<value_type>());
+  auto y = MDSpanBlock{buffer_y.to_mdspan()};
+  stdex::first_touch(y);
+  mdspan_benchmark::fill_random(y);
+
+  int R = 10;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    benchmark::DoNotOptimize(y.data());
+    benchmark::DoNotOptimize(x.data());
+    for(int r=0; r<R; r++) {
+      stdex::linalg::matrix_vector_product(stdex::execution::par, A, x, y, y);
+    }
+    benchmark::ClobberMemory();
+  }
+  size_t num_elements = 4 * (2 * A.extent(0) * A.extent(1) + 2 * A.extent(0));
+  state.SetBytesProcessed( R * num_elements * sizeof(value_type) * state.iterations() * global_repeat);
+  state.counters["repeats"] = global_repeat;
+}
+
+BENCHMARK_CAPTURE(BM_MDSpan_Linalg_MatVec_MultiRHS, left, lmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 100000, 5000);
+BENCHMARK_CAPTURE(BM_MDSpan_Linalg_MatVec_MultiRHS, right, rmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 100000, 5000);
+
+//================================================================================
+
+// Lower-triangular y += L x: row i costs i+1 multiply-adds, so a static split
+// of the rows gives the last thread almost twice the average work.
+
+template <class MDSpanMatrix, class MDSpanVector>
+void triangular_matvec_rows(MDSpanMatrix A, MDSpanVector x, MDSpanVector y, size_t row_begin, size_t row_end) {
+  using value_type = typename MDSpanMatrix::value_type;
+  for(size_t i = row_begin; i < row_end; i ++) {
+    value_type y_i = 0;
+    for(size_t j = 0; j <= i; j ++) {
+      y_i += A(i,j) * x(j);
+    }
+    y(i) += y_i;
+  }
+}
+
+template <class MDSpanMatrix, class... DynSizes>
+void BM_MDSpan_OpenMP_TriangularMatVec(benchmark::State& state, MDSpanMatrix, DynSizes... dyn) {
+
+  using value_type = typename MDSpanMatrix::value_type;
+  using MDSpanVector = lmdspan<value_type,stdex::dynamic_extent>;
+
+  auto buffer_A = stdex::mdarray<
+    value_type, typename MDSpanMatrix::extents_type, typename MDSpanMatrix::layout_type
+  >(dyn...);
+  auto A = MDSpanMatrix{buffer_A.to_mdspan()};
+  stdex::first_touch(A);
+  mdspan_benchmark::fill_random(A);
+
+  auto buffer_x = stdex::mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(A.extent(1));
+  auto x = MDSpanVector{buffer_x.to_mdspan()};
+  mdspan_benchmark::fill_random(x);
+  auto buffer_y = stdex::mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(A.extent(0));
+  auto y = MDSpanVector{buffer_y.to_mdspan()};
+  mdspan_benchmark::fill_random(y);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    #pragma omp parallel for schedule(static)
+    for(size_t i = 0; i < A.extent(0); i ++) {
+      triangular_matvec_rows(A, x, y, i, i + 1);
+    }
+    benchmark::ClobberMemory();
+  }
+  size_t num_elements = A.extent(0) * (A.extent(0) + 1) / 2;
+  state.SetBytesProcessed( num_elements * sizeof(value_type) * state.iterations());
+}
+
+template <class MDSpanMatrix, class... DynSizes>
+void BM_MDSpan_WorkStealing_TriangularMatVec(benchmark::State& state, MDSpanMatrix, DynSizes... dyn) {
+
+  using value_type = typename MDSpanMatrix::value_type;
+  using MDSpanVector = lmdspan<value_type,stdex::dynamic_extent>;
+
+  auto buffer_A = stdex::mdarray<
+    value_type, typename MDSpanMatrix::extents_type, typename MDSpanMatrix::layout_type
+  >(dyn...);
+  auto A = MDSpanMatrix{buffer_A.to_mdspan()};
+  stdex::first_touch(A);
+  mdspan_benchmark::fill_random(A);
+
+  auto buffer_x = stdex::mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(A.extent(1));
+  auto x = MDSpanVector{buffer_x.to_mdspan()};
+  mdspan_benchmark::fill_random(x);
+  auto buffer_y = stdex::mdarray<value_type, stdex::dextents<1>, stdex::layout_left>(A.extent(0));
+  auto y = MDSpanVector{buffer_y.to_mdspan()};
+  mdspan_benchmark::fill_random(y);
+
+  // tiles of y: at most 64 rows, cut on whole cache lines of y
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    stdex::for_each_tile(stdex::execution::par, y, 64, [&](auto y_tile, std::array<size_t, 1> const& origin) {
+      triangular_matvec_rows(A, x, y, origin[0], origin[0] + y_tile.extent(0));
+    });
+    benchmark::ClobberMemory();
+  }
+  size_t num_elements = A.extent(0) * (A.extent(0) + 1) / 2;
+  state.SetBytesProcessed( num_elements * sizeof(value_type) * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_TriangularMatVec, right, rmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 4000, 4000);
+BENCHMARK_CAPTURE(BM_MDSpan_WorkStealing_TriangularMatVec, right, rmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 4000, 4000);
+
+//================================================================================
+
 BENCHMARK_MAIN();
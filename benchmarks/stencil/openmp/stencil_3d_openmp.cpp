@@ -44,6 +44,7 @@
 #include "fill.hpp"
 
 #include <experimental/mdspan>
+#include <experimental/mdspan_algorithm>
 
 #include <benchmark/benchmark.h>
 
@@ -147,6 +148,245 @@ MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_OpenMP_Stencil_3D, left_, lmdspan, 400, 400, 4
 
 //================================================================================
 
+// The same stencil without hand-written pragmas: fill(par, ...) does the first
+// touch and for_each_index(par, ...) splits the interior of o into slabs along
+// its slowest-varying dimension, whichever layout that is.
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Parallel_Stencil_3D(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_s = std::make_unique<value_type[]>(buffer_size);
+  auto s = MDSpan{buffer_s.get(), dyn...};
+  stdex::fill(stdex::execution::par, s, value_type(0));
+  mdspan_benchmark::fill_random(s);
+
+  auto buffer_o = std::make_unique<value_type[]>(buffer_size);
+  auto o = MDSpan{buffer_o.get(), dyn...};
+  stdex::fill(stdex::execution::par, o, value_type(0));
+  mdspan_benchmark::fill_random(o);
+
+  const size_t d = global_delta;
+  auto interior = stdex::submdspan(o,
+    std::make_pair(d, o.extent(0) - d),
+    std::make_pair(d, o.extent(1) - d),
+    std::make_pair(d, o.extent(2) - d));
+  auto kernel = [=](size_t ii, size_t jj, size_t kk) {
+    const size_t i = ii + d, j = jj + d, k = kk + d;
+    value_type sum_local = 0;
+    for(size_t di = i-d; di < i+d+1; di++) {
+    for(size_t dj = j-d; dj < j+d+1; dj++) {
+    for(size_t dk = k-d; dk < k+d+1; dk++) {
+      sum_local += s(di, dj, dk);
+    }}}
+    interior(ii, jj, kk) = sum_local;
+  };
+
+  stdex::for_each_index(stdex::execution::par, interior, kernel);
+  for (auto _ : state) {
+    stdex::for_each_index(stdex::execution::par, interior, kernel);
+  }
+  size_t num_inner_elements = (s.extent(0)-d) * (s.extent(1)-d) * (s.extent(2)-d);
+  size_t stencil_num = (2*d+1) * (2*d+1) * (2*d+1);
+  state.SetBytesProcessed( num_inner_elements * stencil_num * sizeof(value_type) * state.iterations());
+}
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Parallel_Stencil_3D, right_, rmdspan, 80, 80, 80);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Parallel_Stencil_3D, left_, lmdspan, 80, 80, 80);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Parallel_Stencil_3D, right_, rmdspan, 400, 400, 400);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Parallel_Stencil_3D, left_, lmdspan, 400, 400, 400);
+
+//================================================================================
+
+// global_steps steps of the 27-point average, one parallel sweep over the grid
+// per step, against stencil_sweep(par, ...) fusing `fused` steps into a pass.
+static constexpr size_t global_steps = 8;
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_OpenMP_Stencil_3D_steps(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), dyn...};
+  OpenMP_first_touch_3D(a);
+  mdspan_benchmark::fill_random(a);
+
+  auto buffer_b = std::make_unique<value_type[]>(buffer_size);
+  auto b = MDSpan{buffer_b.get(), dyn...};
+  OpenMP_first_touch_3D(b);
+  mdspan_benchmark::fill_random(b);
+
+  int d = global_delta;
+
+  for (auto _ : state) {
+    auto s = a;
+    auto o = b;
+    for(size_t t = 0; t < global_steps; ++t) {
+      #pragma omp parallel for
+      for(size_t i = d; i < s.extent(0)-d; i ++) {
+        for(size_t j = d; j < s.extent(1)-d; j ++) {
+          for(size_t k = d; k < s.extent(2)-d; k ++) {
+            value_type sum_local = 0;
+            for(size_t di = i-d; di < i+d+1; di++) {
+            for(size_t dj = j-d; dj < j+d+1; dj++) {
+            for(size_t dk = k-d; dk < k+d+1; dk++) {
+              sum_local += s(di, dj, dk);
+            }}}
+            o(i,j,k) = sum_local / 27;
+          }
+        }
+      }
+      std::swap(s, o);
+    }
+    benchmark::DoNotOptimize(s.data());
+    benchmark::ClobberMemory();
+  }
+  size_t num_inner_elements = (a.extent(0)-2*d) * (a.extent(1)-2*d) * (a.extent(2)-2*d);
+  state.SetItemsProcessed(num_inner_elements * global_steps * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Stencil_3D_steps, right_d80_d80_d80,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 80, 80, 80);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Stencil_3D_steps, right_d400_d400_d400,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 400, 400, 400);
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Parallel_Stencil_3D_sweep(benchmark::State& state, MDSpan, size_t fused, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), dyn...};
+  stdex::fill(stdex::execution::par, a, value_type(0));
+  mdspan_benchmark::fill_random(a);
+
+  auto buffer_b = std::make_unique<value_type[]>(buffer_size);
+  auto b = MDSpan{buffer_b.get(), dyn...};
+  stdex::fill(stdex::execution::par, b, value_type(0));
+  mdspan_benchmark::fill_random(b);
+
+  auto average = [](auto const& nb) {
+    value_type sum_local = 0;
+    for(int di = -1; di <= 1; di++) {
+    for(int dj = -1; dj <= 1; dj++) {
+    for(int dk = -1; dk <= 1; dk++) {
+      sum_local += nb(di, dj, dk);
+    }}}
+    return sum_local / 27;
+  };
+
+  for (auto _ : state) {
+    auto result = stdex::stencil_sweep<1>(stdex::execution::par, a, b, global_steps, average,
+                                          stdex::stencil_blocking{fused, 0});
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  size_t num_inner_elements = (a.extent(0)-2) * (a.extent(1)-2) * (a.extent(2)-2);
+  state.SetItemsProcessed(num_inner_elements * global_steps * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Parallel_Stencil_3D_sweep, right_fused1_d80_d80_d80,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 1, 80, 80, 80);
+BENCHMARK_CAPTURE(BM_MDSpan_Parallel_Stencil_3D_sweep, right_fused4_d80_d80_d80,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 4, 80, 80, 80);
+BENCHMARK_CAPTURE(BM_MDSpan_Parallel_Stencil_3D_sweep, right_fused1_d400_d400_d400,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 1, 400, 400, 400);
+BENCHMARK_CAPTURE(BM_MDSpan_Parallel_Stencil_3D_sweep, right_fused4_d400_d400_d400,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 4, 400, 400, 400);
+
+//================================================================================
+
+// A stencil whose radius grows from 1 to 3 along the first dimension, so the
+// cost per point varies 13x across the domain: static OpenMP partitioning
+// against for_each_tile's work stealing.
+
+template <class MDSpan>
+typename MDSpan::value_type variable_stencil_point(MDSpan s, size_t i, size_t j, size_t k) {
+  const size_t d = 1 + 2 * i / s.extent(0);
+  typename MDSpan::value_type sum_local = 0;
+  for(size_t di = i-d; di < i+d+1; di++) {
+  for(size_t dj = j-d; dj < j+d+1; dj++) {
+  for(size_t dk = k-d; dk < k+d+1; dk++) {
+    sum_local += s(di, dj, dk);
+  }}}
+  return sum_local;
+}
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_OpenMP_VariableStencil_3D(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_s = std::make_unique<value_type[]>(buffer_size);
+  auto s = MDSpan{buffer_s.get(), dyn...};
+  OpenMP_first_touch_3D(s);
+  mdspan_benchmark::fill_random(s);
+
+  auto buffer_o = std::make_unique<value_type[]>(buffer_size);
+  auto o = MDSpan{buffer_o.get(), dyn...};
+  OpenMP_first_touch_3D(o);
+
+  const size_t d = 3;
+  for (auto _ : state) {
+    #pragma omp parallel for schedule(static)
+    for(size_t i = d; i < s.extent(0)-d; i ++) {
+      for(size_t j = d; j < s.extent(1)-d; j ++) {
+        for(size_t k = d; k < s.extent(2)-d; k ++) {
+          o(i,j,k) = variable_stencil_point(s, i, j, k);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(o.data());
+  }
+  size_t num_inner_elements = (s.extent(0)-2*d) * (s.extent(1)-2*d) * (s.extent(2)-2*d);
+  state.SetItemsProcessed( num_inner_elements * state.iterations());
+}
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_OpenMP_VariableStencil_3D, right_, rmdspan, 200, 200, 200);
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_WorkStealing_VariableStencil_3D(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_s = std::make_unique<value_type[]>(buffer_size);
+  auto s = MDSpan{buffer_s.get(), dyn...};
+  OpenMP_first_touch_3D(s);
+  mdspan_benchmark::fill_random(s);
+
+  auto buffer_o = std::make_unique<value_type[]>(buffer_size);
+  auto o = MDSpan{buffer_o.get(), dyn...};
+  OpenMP_first_touch_3D(o);
+
+  const size_t d = 3;
+  auto interior = stdex::submdspan(o,
+    std::make_pair(d, o.extent(0) - d),
+    std::make_pair(d, o.extent(1) - d),
+    std::make_pair(d, o.extent(2) - d));
+  for (auto _ : state) {
+    stdex::for_each_tile(stdex::execution::par, interior, 4096, [&](auto tile, std::array<size_t, 3> const& origin) {
+      // locals, so stores through tile cannot alias the captured s
+      const auto s_local = s;
+      const size_t i0 = origin[0]+d, j0 = origin[1]+d, k0 = origin[2]+d;
+      for(size_t i = 0; i < tile.extent(0); i ++) {
+        for(size_t j = 0; j < tile.extent(1); j ++) {
+          for(size_t k = 0; k < tile.extent(2); k ++) {
+            tile(i,j,k) = variable_stencil_point(s_local, i0+i, j0+j, k0+k);
+          }
+        }
+      }
+    });
+    benchmark::DoNotOptimize(o.data());
+  }
+  size_t num_inner_elements = (s.extent(0)-2*d) * (s.extent(1)-2*d) * (s.extent(2)-2*d);
+  state.SetItemsProcessed( num_inner_elements * state.iterations());
+}
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_WorkStealing_VariableStencil_3D, right_, rmdspan, 200, 200, 200);
+
+//================================================================================
+
 template <class T, class SizeX, class SizeY, class SizeZ>
 void BM_Raw_OpenMP_Stencil_3D_right(benchmark::State& state, T, SizeX x, SizeY y, SizeZ z) {
 
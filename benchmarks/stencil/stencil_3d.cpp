@@ -44,6 +44,9 @@
 #include "fill.hpp"
 
 #include <experimental/mdspan>
+#include <experimental/mdspan_algorithm>
+#include <experimental/mdspan_memory>
+#include <experimental/mdspan_simd>
 
 #include <benchmark/benchmark.h>
 
@@ -53,6 +56,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <chrono>
+#include <utility>
 
 //================================================================================
 
@@ -109,6 +113,206 @@ MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Stencil_3D, left_, lmdspan, 400, 400, 400);
 
 //================================================================================
 
+// The same stencil, eight outputs along the contiguous dimension at a time.
+// Stores go through the interior submdspan of o, so the last batch of each
+// row is clipped at the interior instead of overwriting the halo.
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Stencil_3D_simd(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  using batch_type = stdex::simd_batch<value_type, 8>;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_s = std::make_unique<value_type[]>(buffer_size);
+  auto s = MDSpan{buffer_s.get(), dyn...};
+  mdspan_benchmark::fill_random(s);
+
+  auto buffer_o = std::make_unique<value_type[]>(buffer_size);
+  auto o = MDSpan{buffer_o.get(), dyn...};
+  mdspan_benchmark::fill_random(o);
+
+  int d = global_delta;
+  auto o_inner = stdex::submdspan(o,
+    std::pair<size_t, size_t>(d, o.extent(0)-d),
+    std::pair<size_t, size_t>(d, o.extent(1)-d),
+    std::pair<size_t, size_t>(d, o.extent(2)-d));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(o);
+    for(size_t i = d; i < s.extent(0)-d; i ++) {
+      for(size_t j = d; j < s.extent(1)-d; j ++) {
+        for(size_t k = d; k < s.extent(2)-d; k += 8) {
+          batch_type sum_local{};
+          for(size_t di = i-d; di < i+d+1; di++) {
+          for(size_t dj = j-d; dj < j+d+1; dj++) {
+          for(size_t dk = k-d; dk < k+d+1; dk++) {
+            sum_local += stdex::load_simd<8>(s, di, dj, dk);
+          }}}
+          stdex::store_simd<8>(o_inner, sum_local, i-d, j-d, k-d);
+        }
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  size_t num_inner_elements = (s.extent(0)-d) * (s.extent(1)-d) * (s.extent(2)-d);
+  size_t stencil_num = (2*d+1) * (2*d+1) * (2*d+1);
+  state.SetBytesProcessed( num_inner_elements * stencil_num * sizeof(value_type) * state.iterations());
+}
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Stencil_3D_simd, right_, rmdspan, 80, 80, 80);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Stencil_3D_simd, right_, rmdspan, 400, 400, 400);
+
+//================================================================================
+
+// global_steps steps of the 27-point average: one sweep over the grid per
+// step, against stencil_sweep fusing `fused` steps into each pass.
+static constexpr size_t global_steps = 8;
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Stencil_3D_steps(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), dyn...};
+  mdspan_benchmark::fill_random(a);
+
+  // same values, so the boundary (never written) is the same in both
+  auto buffer_b = std::make_unique<value_type[]>(buffer_size);
+  auto b = MDSpan{buffer_b.get(), dyn...};
+  mdspan_benchmark::fill_random(b);
+
+  int d = global_delta;
+
+  for (auto _ : state) {
+    auto s = a;
+    auto o = b;
+    for(size_t t = 0; t < global_steps; ++t) {
+      for(size_t i = d; i < s.extent(0)-d; i ++) {
+        for(size_t j = d; j < s.extent(1)-d; j ++) {
+          for(size_t k = d; k < s.extent(2)-d; k ++) {
+            value_type sum_local = 0;
+            for(size_t di = i-d; di < i+d+1; di++) {
+            for(size_t dj = j-d; dj < j+d+1; dj++) {
+            for(size_t dk = k-d; dk < k+d+1; dk++) {
+              sum_local += s(di, dj, dk);
+            }}}
+            o(i,j,k) = sum_local / 27;
+          }
+        }
+      }
+      std::swap(s, o);
+    }
+    benchmark::DoNotOptimize(s.data());
+    benchmark::ClobberMemory();
+  }
+  size_t num_inner_elements = (a.extent(0)-2*d) * (a.extent(1)-2*d) * (a.extent(2)-2*d);
+  state.SetItemsProcessed(num_inner_elements * global_steps * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_steps, right_d80_d80_d80,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 80, 80, 80);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_steps, right_d400_d400_d400,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 400, 400, 400);
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Stencil_3D_sweep(benchmark::State& state, MDSpan, size_t fused, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, dyn...}.mapping().required_span_size();
+
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), dyn...};
+  mdspan_benchmark::fill_random(a);
+
+  auto buffer_b = std::make_unique<value_type[]>(buffer_size);
+  auto b = MDSpan{buffer_b.get(), dyn...};
+  mdspan_benchmark::fill_random(b);
+
+  auto average = [](auto const& nb) {
+    value_type sum_local = 0;
+    for(int di = -1; di <= 1; di++) {
+    for(int dj = -1; dj <= 1; dj++) {
+    for(int dk = -1; dk <= 1; dk++) {
+      sum_local += nb(di, dj, dk);
+    }}}
+    return sum_local / 27;
+  };
+
+  for (auto _ : state) {
+    auto result = stdex::stencil_sweep<1>(a, b, global_steps, average, stdex::stencil_blocking{fused, 0});
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  size_t num_inner_elements = (a.extent(0)-2) * (a.extent(1)-2) * (a.extent(2)-2);
+  state.SetItemsProcessed(num_inner_elements * global_steps * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_sweep, right_fused1_d80_d80_d80,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 1, 80, 80, 80);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_sweep, right_fused4_d80_d80_d80,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 4, 80, 80, 80);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_sweep, right_fused1_d400_d400_d400,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 1, 400, 400, 400);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_sweep, right_fused4_d400_d400_d400,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 4, 400, 400, 400);
+
+//================================================================================
+
+// The stencil on 4 KiB vs 2 MiB (transparent huge) pages.
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Stencil_3D_pages(benchmark::State& state, MDSpan, stdex::hugepage_mode mode, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  using array_type = stdex::hugepage_mdarray<
+    value_type, typename MDSpan::extents_type, typename MDSpan::layout_type>;
+  auto exts = typename MDSpan::extents_type(dyn...);
+
+  auto buffer_s = array_type(exts, stdex::hugepage_allocator<value_type>(mode));
+  auto s = MDSpan{buffer_s.to_mdspan()};
+  mdspan_benchmark::fill_random(s);
+
+  auto buffer_o = array_type(exts, stdex::hugepage_allocator<value_type>(mode));
+  auto o = MDSpan{buffer_o.to_mdspan()};
+  mdspan_benchmark::fill_random(o);
+
+  int d = global_delta;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(o);
+    for(size_t i = d; i < s.extent(0)-d; i ++) {
+      for(size_t j = d; j < s.extent(1)-d; j ++) {
+        for(size_t k = d; k < s.extent(2)-d; k ++) {
+          value_type sum_local = 0;
+          for(size_t di = i-d; di < i+d+1; di++) {
+          for(size_t dj = j-d; dj < j+d+1; dj++) {
+          for(size_t dk = k-d; dk < k+d+1; dk++) {
+            sum_local += s(di, dj, dk);
+          }}}
+          o(i,j,k) = sum_local;
+        }
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  size_t num_inner_elements = (s.extent(0)-d) * (s.extent(1)-d) * (s.extent(2)-d);
+  size_t stencil_num = (2*d+1) * (2*d+1) * (2*d+1);
+  state.SetBytesProcessed( num_inner_elements * stencil_num * sizeof(value_type) * state.iterations());
+  state.counters["huge_fraction"] = stdex::hugepage_usage(s).fraction();
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_pages, right_4k_d400_d400_d400,
+  rmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(),
+  stdex::hugepage_mode::none, 400, 400, 400);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_pages, right_2m_d400_d400_d400,
+  rmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(),
+  stdex::hugepage_mode::transparent, 400, 400, 400);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_pages, left_4k_d400_d400_d400,
+  lmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(),
+  stdex::hugepage_mode::none, 400, 400, 400);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_pages, left_2m_d400_d400_d400,
+  lmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(),
+  stdex::hugepage_mode::transparent, 400, 400, 400);
+
+//================================================================================
+
 template <class T, class SizeX, class SizeY, class SizeZ>
 void BM_Raw_Stencil_3D_right(benchmark::State& state, T, SizeX x, SizeY y, SizeZ z) {
 
@@ -42,6 +42,7 @@
 */
 
 #include <experimental/mdspan>
+#include <experimental/mdspan_algorithm>
 
 #include "sum_3d_common.hpp"
 #include "fill.hpp"
@@ -128,6 +129,30 @@ MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_loop_OpenMP, left_, lmdspan, 200, 200,
 
 //================================================================================
 
+// The same sum through the library's reduce: one slab of the slowest-varying
+// dimension per thread, each folded into a private accumulator.
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Sum_3D_reduce_par(benchmark::State& state, MDSpan, DynSizes... dyn) {
+  using value_type = typename MDSpan::value_type;
+  auto buffer = std::make_unique<value_type[]>(
+    MDSpan{nullptr, dyn...}.mapping().required_span_size()
+  );
+  auto s = MDSpan{buffer.get(), dyn...};
+
+  mdspan_benchmark::fill_random(s);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    value_type sum = stdex::reduce(stdex::execution::par, s);
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+}
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_reduce_par, right_, rmdspan, 200, 200, 200);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_reduce_par, left_, lmdspan, 200, 200, 200);
+
+//================================================================================
+
 template <class T, class SizeX, class SizeY, class SizeZ>
 void BM_Raw_Sum_3D_OpenMP(benchmark::State& state, T, SizeX x, SizeY y, SizeZ z) {
   auto buffer = std::make_unique<T[]>(x * y * z);
@@ -42,6 +42,7 @@
 */
 
 #include <experimental/mdspan>
+#include <experimental/mdarray>
 
 #include <memory>
 #include <random>
@@ -61,12 +62,12 @@ using rmdspan = stdex::mdspan<T, stdex::extents<Es...>, stdex::layout_right>;
 template <class MDSpan, class... DynSizes>
 void BM_MDSpan_Sum_3D_left(benchmark::State& state, MDSpan, DynSizes... dyn) {
   using value_type = typename MDSpan::value_type;
-  auto buffer = std::make_unique<value_type[]>(
-    MDSpan{nullptr, dyn...}.mapping().required_span_size()
-  );
-  auto s = MDSpan{buffer.get(), dyn...};
+  auto buffer = stdex::mdarray<
+    value_type, typename MDSpan::extents_type, typename MDSpan::layout_type
+  >(dyn...);
+  auto s = MDSpan{buffer.to_mdspan()};
   mdspan_benchmark::fill_random(s);
-  for (auto _ : state) {
+  auto kernel = [](auto s) {
     value_type sum = 0;
     for (size_t k = 0; k < s.extent(2); ++k) {
       for (size_t j = 0; j < s.extent(1); ++j) {
@@ -75,10 +76,15 @@ void BM_MDSpan_Sum_3D_left(benchmark::State& state, MDSpan, DynSizes... dyn) {
         }
       }
     }
+    return sum;
+  };
+  for (auto _ : state) {
+    value_type sum = kernel(s);
     benchmark::DoNotOptimize(sum);
     benchmark::DoNotOptimize(s.data());
   }
   state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+  mdspan_benchmark::report_traffic(state, s, kernel);
 }
 MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_left, left_, lmdspan, 20, 20, 20);
 MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_left, right_, rmdspan, 20, 20, 20);
@@ -42,6 +42,10 @@
 */
 
 #include <experimental/mdspan>
+#include <experimental/mdarray>
+#include <experimental/mdspan_accessors>
+#include <experimental/mdspan_algorithm>
+#include <experimental/mdspan_memory>
 
 #include <memory>
 #include <random>
@@ -62,16 +66,14 @@ template <class MDSpan, class... DynSizes>
 void BM_MDSpan_Sum_3D_right(benchmark::State& state, MDSpan, DynSizes... dyn) {
 
   using value_type = typename MDSpan::value_type;
-  auto buffer = std::make_unique<value_type[]>(
-    MDSpan{nullptr, dyn...}.mapping().required_span_size()
-  );
+  auto buffer = stdex::mdarray<
+    value_type, typename MDSpan::extents_type, typename MDSpan::layout_type
+  >(dyn...);
 
-  auto s = MDSpan{buffer.get(), dyn...};
+  auto s = MDSpan{buffer.to_mdspan()};
   mdspan_benchmark::fill_random(s);
 
-  for (auto _ : state) {
-    benchmark::DoNotOptimize(s);
-    benchmark::DoNotOptimize(s.data());
+  auto kernel = [](auto s) {
     value_type sum = 0;
     for(size_t i = 0; i < s.extent(0); ++i) {
       for (size_t j = 0; j < s.extent(1); ++j) {
@@ -80,10 +82,18 @@ void BM_MDSpan_Sum_3D_right(benchmark::State& state, MDSpan, DynSizes... dyn) {
         }
       }
     }
+    return sum;
+  };
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(s.data());
+    value_type sum = kernel(s);
     benchmark::DoNotOptimize(sum);
     benchmark::ClobberMemory();
   }
   state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+  mdspan_benchmark::report_traffic(state, s, kernel);
 }
 MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_right, right_, rmdspan, 20, 20, 20);
 MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_right, left_, lmdspan, 20, 20, 20);
@@ -92,6 +102,214 @@ MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_right, left_, lmdspan, 200, 200, 200);
 
 //================================================================================
 
+// One kernel for both layouts: for_each_index puts the stride-1 dimension in
+// the innermost loop, so left_ should match the hand-ordered left sweep.
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Sum_3D_for_each(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer = stdex::mdarray<
+    value_type, typename MDSpan::extents_type, typename MDSpan::layout_type
+  >(dyn...);
+
+  auto s = MDSpan{buffer.to_mdspan()};
+  mdspan_benchmark::fill_random(s);
+
+  auto kernel = [](auto s) {
+    value_type sum = 0;
+    stdex::for_each_index(s, [&](size_t i, size_t j, size_t k) {
+      sum += s(i, j, k);
+    });
+    return sum;
+  };
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(s.data());
+    value_type sum = kernel(s);
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+  mdspan_benchmark::report_traffic(state, s, kernel);
+}
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_for_each, right_, rmdspan, 20, 20, 20);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_for_each, left_, lmdspan, 20, 20, 20);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_for_each, right_, rmdspan, 200, 200, 200);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_for_each, left_, lmdspan, 200, 200, 200);
+
+//================================================================================
+
+// reduce: several independent accumulators on the stride-1 dimension.  The
+// float captures compare against the single-accumulator float loop of
+// BM_MDSpan_Sum_3D_right, which is bound by add latency.
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Sum_3D_reduce(benchmark::State& state, MDSpan, bool fixed_order, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer = stdex::mdarray<
+    value_type, typename MDSpan::extents_type, typename MDSpan::layout_type
+  >(dyn...);
+
+  auto s = MDSpan{buffer.to_mdspan()};
+  mdspan_benchmark::fill_random(s);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(s.data());
+    value_type sum = fixed_order ?
+      stdex::reduce(s, value_type(0), std::plus<>(), stdex::deterministic) :
+      stdex::reduce(s, value_type(0));
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right, float_right_dyn_d200_d200_d200,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_reduce, int_right_dyn_d200_d200_d200,
+  rmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), false, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_reduce, float_right_dyn_d200_d200_d200,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), false, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_reduce, float_left_dyn_d200_d200_d200,
+  lmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), false, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_reduce, float_right_deterministic_dyn_d200_d200_d200,
+  rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(), true, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_reduce, float_right_fixed_20_20_20,
+  rmdspan<float, 20, 20, 20>(), false);
+
+// Sums over one axis of a layout_right array: axis 2 is the stride-1
+// dimension (a lane reduction per output), axis 0 the slowest (whole planes
+// accumulated into the output).
+template <size_t Axis>
+void BM_MDSpan_Sum_3D_axis_loop(benchmark::State& state, std::integral_constant<size_t, Axis>, size_t n) {
+  auto buffer = stdex::mdarray<float, stdex::dextents<3>>(n, n, n);
+  auto s = buffer.to_mdspan();
+  mdspan_benchmark::fill_random(s);
+  auto out_buffer = stdex::mdarray<float, stdex::dextents<2>>(n, n);
+  auto out = out_buffer.to_mdspan();
+  for (auto _ : state) {
+    for(size_t a = 0; a < n; ++a) {
+      for(size_t b = 0; b < n; ++b) {
+        float sum = 0;
+        for(size_t k = 0; k < n; ++k) {
+          sum += Axis == 0 ? s(k, a, b) : s(a, b, k);
+        }
+        out(a, b) = sum;
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(float) * state.iterations());
+}
+
+template <size_t Axis>
+void BM_MDSpan_Sum_3D_reduce_axis(benchmark::State& state, std::integral_constant<size_t, Axis>, size_t n) {
+  auto buffer = stdex::mdarray<float, stdex::dextents<3>>(n, n, n);
+  auto s = buffer.to_mdspan();
+  mdspan_benchmark::fill_random(s);
+  auto out_buffer = stdex::mdarray<float, stdex::dextents<2>>(n, n);
+  auto out = out_buffer.to_mdspan();
+  for (auto _ : state) {
+    stdex::reduce_axis<Axis>(s, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(float) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_axis_loop, axis0_200, std::integral_constant<size_t, 0>{}, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_reduce_axis, axis0_200, std::integral_constant<size_t, 0>{}, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_axis_loop, axis2_200, std::integral_constant<size_t, 2>{}, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_reduce_axis, axis2_200, std::integral_constant<size_t, 2>{}, 200);
+
+//================================================================================
+
+// Same sweep over a smooth field read through compressed_accessor; the bytes
+// processed are the compressed bytes actually streamed from memory.
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Sum_3D_right_compressed(benchmark::State& state, MDSpan, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer = stdex::mdarray<
+    value_type, typename MDSpan::extents_type, typename MDSpan::layout_type
+  >(dyn...);
+
+  auto s = MDSpan{buffer.to_mdspan()};
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for (size_t j = 0; j < s.extent(1); ++j) {
+      for (size_t k = 0; k < s.extent(2); ++k) {
+        s(i, j, k) = value_type(i + 2 * j + k % 8);
+      }
+    }
+  }
+  auto storage = stdex::compress(s);
+  auto c = stdex::make_compressed_mdspan(storage, s.mapping());
+
+  for (auto _ : state) {
+    value_type sum = 0;
+    for(size_t i = 0; i < c.extent(0); ++i) {
+      for (size_t j = 0; j < c.extent(1); ++j) {
+        for (size_t k = 0; k < c.extent(2); ++k) {
+          sum += c(i, j, k);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(storage.compressed_bytes() * state.iterations());
+  state.counters["ratio"] = storage.compression_ratio();
+}
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_right_compressed, right_, rmdspan, 200, 200, 200);
+
+//================================================================================
+
+// The same sweep with storage on 4 KiB pages vs 2 MiB (transparent huge)
+// pages.  The layout_left views are traversed with the large strides, where
+// TLB reach is what runs out first.
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Sum_3D_right_pages(benchmark::State& state, MDSpan, stdex::hugepage_mode mode, DynSizes... dyn) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer = stdex::hugepage_mdarray<
+    value_type, typename MDSpan::extents_type, typename MDSpan::layout_type
+  >(typename MDSpan::extents_type(dyn...), stdex::hugepage_allocator<value_type>(mode));
+
+  auto s = MDSpan{buffer.to_mdspan()};
+  mdspan_benchmark::fill_random(s);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    value_type sum = 0;
+    for(size_t i = 0; i < s.extent(0); ++i) {
+      for (size_t j = 0; j < s.extent(1); ++j) {
+        for (size_t k = 0; k < s.extent(2); ++k) {
+          sum += s(i, j, k);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+  state.counters["huge_fraction"] = stdex::hugepage_usage(s).fraction();
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right_pages, right_4k_d400_d400_d400,
+  rmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(),
+  stdex::hugepage_mode::none, 400, 400, 400);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right_pages, right_2m_d400_d400_d400,
+  rmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(),
+  stdex::hugepage_mode::transparent, 400, 400, 400);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right_pages, left_4k_d400_d400_d400,
+  lmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(),
+  stdex::hugepage_mode::none, 400, 400, 400);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right_pages, left_2m_d400_d400_d400,
+  lmdspan<int, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>(),
+  stdex::hugepage_mode::transparent, 400, 400, 400);
+
+//================================================================================
+
 BENCHMARK_CAPTURE(
   BM_Raw_Sum_3D_right, size_20_20_20, int(), size_t(20), size_t(20), size_t(20)
 );
@@ -42,9 +42,12 @@
 */
 
 #include <experimental/mdspan>
+#include <experimental/mdspan_memory>
+#include <experimental/mdspan_algorithm>
 
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include "fill.hpp"
 
@@ -129,6 +132,28 @@ BENCHMARK_CAPTURE(BM_Raw_Static_TinyMatrixSum_right, size_1000000_3_3, int(), 10
 
 //================================================================================
 
+// The tiny matrices as a contiguous array of inline-storage static_mdarrays:
+// no per-matrix allocation, and batched_add runs over batch_view() of them.
+template <class T, size_t N>
+void BM_StaticMDArray_TinyMatrixSum(benchmark::State& state, T, std::integral_constant<size_t, N>) {
+
+  using matrix_t = stdex::static_mdarray<T, stdex::extents<3, 3>>;
+  std::vector<matrix_t> s(N), o(N);
+  mdspan_benchmark::fill_random(stdex::batch_view(s.data(), N));
+  mdspan_benchmark::fill_random(stdex::batch_view(o.data(), N));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(o.data());
+    benchmark::DoNotOptimize(s.data());
+    stdex::batched_add(o.data(), s.data(), o.data(), N);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed( N * 9 * 3 * sizeof(T) * state.iterations() );
+}
+BENCHMARK_CAPTURE(BM_StaticMDArray_TinyMatrixSum, size_1000000_3_3, int(), std::integral_constant<size_t, 1000000>());
+
+//================================================================================
+
 template <class T, class SizeX, class SizeY, class SizeZ>
 void BM_Raw_TinyMatrixSum_right(benchmark::State& state, T, SizeX x, SizeY y, SizeZ z) {
 
@@ -172,4 +197,133 @@ BENCHMARK_CAPTURE(BM_Raw_TinyMatrixSum_right, size_1000000_3_3, int(), size_t(10
 
 //================================================================================
 
+// The batch as a single mdspan over extents<dynamic_extent, 3, 3>: the batched
+// kernels put one matrix in each SIMD lane, so layout_left (batch index fastest)
+// loads straight into vectors while layout_right goes through a transpose.
+template <class MDSpan>
+void BM_MDSpan_Batched_TinyMatrixSum(benchmark::State& state, MDSpan, size_t n) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, n}.mapping().required_span_size();
+
+  auto buffer_s = std::make_unique<value_type[]>(buffer_size);
+  auto s = MDSpan{buffer_s.get(), n};
+  mdspan_benchmark::fill_random(s);
+
+  auto buffer_o = std::make_unique<value_type[]>(buffer_size);
+  auto o = MDSpan{buffer_o.get(), n};
+  mdspan_benchmark::fill_random(o);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(o.data());
+    benchmark::DoNotOptimize(s.data());
+    stdex::batched_add(o, s, o);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed( n * 9 * 3 * sizeof(value_type) * state.iterations() );
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Batched_TinyMatrixSum, left_float_1000000,
+  lmdspan<float, stdex::dynamic_extent, 3, 3>(), size_t(1000000));
+BENCHMARK_CAPTURE(BM_MDSpan_Batched_TinyMatrixSum, right_float_1000000,
+  rmdspan<float, stdex::dynamic_extent, 3, 3>(), size_t(1000000));
+
+//================================================================================
+
+template <class MDSpan>
+void BM_MDSpan_Batched_TinyMatrixProduct(benchmark::State& state, MDSpan, size_t n) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, n}.mapping().required_span_size();
+
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), n};
+  mdspan_benchmark::fill_random(a);
+  auto buffer_b = std::make_unique<value_type[]>(buffer_size);
+  auto b = MDSpan{buffer_b.get(), n};
+  mdspan_benchmark::fill_random(b);
+  auto buffer_c = std::make_unique<value_type[]>(buffer_size);
+  auto c = MDSpan{buffer_c.get(), n};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    benchmark::DoNotOptimize(b.data());
+    stdex::batched_matrix_product(a, b, c);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( n * state.iterations() );
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Batched_TinyMatrixProduct, left_float_100000,
+  lmdspan<float, stdex::dynamic_extent, 3, 3>(), size_t(100000));
+BENCHMARK_CAPTURE(BM_MDSpan_Batched_TinyMatrixProduct, right_float_100000,
+  rmdspan<float, stdex::dynamic_extent, 3, 3>(), size_t(100000));
+
+template <class MDSpan>
+void BM_MDSpan_Naive_TinyMatrixProduct(benchmark::State& state, MDSpan, size_t n) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, n}.mapping().required_span_size();
+
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), n};
+  mdspan_benchmark::fill_random(a);
+  auto buffer_b = std::make_unique<value_type[]>(buffer_size);
+  auto b = MDSpan{buffer_b.get(), n};
+  mdspan_benchmark::fill_random(b);
+  auto buffer_c = std::make_unique<value_type[]>(buffer_size);
+  auto c = MDSpan{buffer_c.get(), n};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    benchmark::DoNotOptimize(b.data());
+    for(size_t m = 0; m < n; m ++) {
+      for(size_t i = 0; i < 3; i ++) {
+        for(size_t j = 0; j < 3; j ++) {
+          value_type sum = 0;
+          for(size_t k = 0; k < 3; k ++) {
+            sum += a(m,i,k) * b(m,k,j);
+          }
+          c(m,i,j) = sum;
+        }
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( n * state.iterations() );
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Naive_TinyMatrixProduct, left_float_100000,
+  lmdspan<float, stdex::dynamic_extent, 3, 3>(), size_t(100000));
+BENCHMARK_CAPTURE(BM_MDSpan_Naive_TinyMatrixProduct, right_float_100000,
+  rmdspan<float, stdex::dynamic_extent, 3, 3>(), size_t(100000));
+
+//================================================================================
+
+template <class MDSpan>
+void BM_MDSpan_Batched_TinyMatrixInverse(benchmark::State& state, MDSpan, size_t n) {
+
+  using value_type = typename MDSpan::value_type;
+  auto buffer_size = MDSpan{nullptr, n}.mapping().required_span_size();
+
+  auto buffer_a = std::make_unique<value_type[]>(buffer_size);
+  auto a = MDSpan{buffer_a.get(), n};
+  mdspan_benchmark::fill_random(a);
+  for(size_t m = 0; m < n; m ++) {
+    for(size_t i = 0; i < 3; i ++) a(m,i,i) += value_type(4);
+  }
+  auto buffer_c = std::make_unique<value_type[]>(buffer_size);
+  auto c = MDSpan{buffer_c.get(), n};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    stdex::batched_inverse(a, c);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( n * state.iterations() );
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Batched_TinyMatrixInverse, left_double_100000,
+  lmdspan<double, stdex::dynamic_extent, 3, 3>(), size_t(100000));
+BENCHMARK_CAPTURE(BM_MDSpan_Batched_TinyMatrixInverse, right_double_100000,
+  rmdspan<double, stdex::dynamic_extent, 3, 3>(), size_t(100000));
+
+//================================================================================
+
 BENCHMARK_MAIN();
@@ -0,0 +1,121 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p1684_bits/mdarray.hpp"
+
+#include <cstddef> // size_t
+#include <cstdlib> // free, posix_memalign
+#include <limits>
+#include <new> // bad_alloc, bad_array_new_length
+#include <vector>
+
+#if defined(_WIN32)
+#include <malloc.h> // _aligned_malloc
+#endif
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// aligned_allocator: a standard allocator whose allocations start on an
+// Alignment-byte boundary (a cache line by default), so the first element of
+// an mdarray is aligned for vector loads and rows of a padded layout don't
+// straddle lines needlessly.
+
+template <class T, size_t Alignment = 64>
+struct aligned_allocator {
+  static_assert((Alignment & (Alignment - 1)) == 0, "std::experimental::aligned_allocator alignment must be a power of two.");
+  static_assert(Alignment >= alignof(T), "std::experimental::aligned_allocator alignment must be at least alignof(T).");
+
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using propagate_on_container_move_assignment = true_type;
+  using is_always_equal = true_type;
+
+  template <class U>
+  struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+  aligned_allocator() noexcept = default;
+
+  template <class U>
+  aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept { } // NOLINT(google-explicit-constructor)
+
+  T* allocate(size_t n) {
+    if(n > std::numeric_limits<size_t>::max() / sizeof(T) - Alignment) throw std::bad_array_new_length();
+    // round up so aligned_alloc-style implementations accept the size
+    const size_t bytes = (n * sizeof(T) + Alignment - 1) & ~(Alignment - 1);
+    void* p = nullptr;
+#if defined(_WIN32)
+    p = _aligned_malloc(bytes, Alignment);
+#else
+    if(posix_memalign(&p, Alignment < sizeof(void*) ? sizeof(void*) : Alignment, bytes) != 0) p = nullptr;
+#endif
+    if(p == nullptr && bytes != 0) throw std::bad_alloc();
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, size_t) noexcept {
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+  }
+};
+
+template <class T, class U, size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) noexcept { return true; }
+template <class T, class U, size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) noexcept { return false; }
+
+template <class T, class Extents, class LayoutPolicy = layout_right, size_t Alignment = 64>
+using aligned_mdarray = mdarray<T, Extents, LayoutPolicy, vector<T, aligned_allocator<T, Alignment>>>;
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,207 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "aligned_allocator.hpp"
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <cstring> // memset
+#include <memory> // unique_ptr
+#include <stdexcept> // invalid_argument
+#include <type_traits>
+#include <utility> // move
+#include <vector>
+
+// Debug mode: fill memory handed back by reset()/rewind() (and fresh chunks)
+// with arena_poison_byte so reads of stale temporaries stand out.
+#ifndef MDSPAN_ARENA_POISON
+#  define MDSPAN_ARENA_POISON 0
+#endif
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// arena: a monotonic bump allocator for short-lived mdspan storage, e.g. the
+// temporaries of one solver iteration.  Allocation is a pointer bump inside a
+// 64-byte aligned chunk; nothing is freed individually.  reset() (or rewind()
+// to a mark()) makes the memory reusable without returning it to the system,
+// so steady-state iterations neither call malloc nor fault in new pages.
+
+_MDSPAN_INLINE_VARIABLE constexpr unsigned char arena_poison_byte = 0xA5;
+
+struct arena_marker {
+  size_t chunk = 0;
+  size_t used = 0;
+};
+
+class arena {
+public:
+  static constexpr size_t default_alignment = 64;
+
+  explicit arena(size_t chunk_bytes = size_t(1) << 20, bool poison = MDSPAN_ARENA_POISON != 0)
+    : __chunk_bytes(chunk_bytes), __poison(poison)
+  {
+    if(chunk_bytes == 0) throw std::invalid_argument("arena: chunk size must be nonzero");
+  }
+
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+  arena(arena&&) noexcept = default;
+  arena& operator=(arena&&) noexcept = default;
+  ~arena() = default;
+
+  // Returns `bytes` bytes aligned to `alignment` (a power of two).
+  void* allocate(size_t bytes, size_t alignment = default_alignment) {
+    if(alignment == 0 || (alignment & (alignment - 1)) != 0) {
+      throw std::invalid_argument("arena: alignment must be a power of two");
+    }
+    for(size_t c = __current; c < __chunks.size(); ++c) {
+      if(void* p = __try_allocate(__chunks[c], bytes, alignment)) {
+        __current = c;
+        return p;
+      }
+    }
+    // Nothing retained fits: add a chunk large enough for this request.
+    const size_t size = bytes + alignment > __chunk_bytes ? bytes + alignment : __chunk_bytes;
+    __chunks.push_back(__chunk(size));
+    if(__poison) std::memset(__chunks.back().data.get(), arena_poison_byte, size);
+    __reserved += size;
+    __current = __chunks.size() - 1;
+    return __try_allocate(__chunks.back(), bytes, alignment);
+  }
+
+  arena_marker mark() const noexcept {
+    return arena_marker{__current, __chunks.empty() ? 0 : __chunks[__current].used};
+  }
+
+  // Release everything allocated since `m` was taken.
+  void rewind(arena_marker m) noexcept {
+    for(size_t c = __chunks.size(); c-- > m.chunk; ) {
+      __chunk& ch = __chunks[c];
+      const size_t keep = c == m.chunk ? m.used : 0;
+      if(ch.used > keep) {
+        if(__poison) std::memset(ch.data.get() + keep, arena_poison_byte, ch.used - keep);
+        ch.used = keep;
+      }
+    }
+    __current = m.chunk;
+  }
+
+  // Release everything; the chunks are kept for reuse.
+  void reset() noexcept { rewind(arena_marker{}); }
+
+  // Return the chunks to the system.
+  void release() noexcept {
+    __chunks.clear();
+    __current = 0;
+    __reserved = 0;
+  }
+
+  size_t bytes_used() const noexcept {
+    size_t used = 0;
+    for(const __chunk& ch : __chunks) used += ch.used;
+    return used;
+  }
+  size_t bytes_reserved() const noexcept { return __reserved; }
+  size_t chunk_count() const noexcept { return __chunks.size(); }
+  bool poisoning() const noexcept { return __poison; }
+
+private:
+  using __chunk_allocator = aligned_allocator<unsigned char, default_alignment>;
+
+  struct __chunk_deleter {
+    size_t size;
+    void operator()(unsigned char* p) const noexcept { __chunk_allocator().deallocate(p, size); }
+  };
+
+  // The storage is left uninitialized: pages are only touched (and, with a
+  // first-touch NUMA policy, placed) by whoever writes them first.
+  struct __chunk {
+    explicit __chunk(size_t n) : data(__chunk_allocator().allocate(n), __chunk_deleter{n}), size(n) { }
+    unique_ptr<unsigned char[], __chunk_deleter> data;
+    size_t size;
+    size_t used = 0;
+  };
+
+  static void* __try_allocate(__chunk& ch, size_t bytes, size_t alignment) noexcept {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(ch.data.get());
+    const uintptr_t start = (base + ch.used + alignment - 1) & ~uintptr_t(alignment - 1);
+    const size_t offset = size_t(start - base);
+    if(offset > ch.size || ch.size - offset < bytes) return nullptr;
+    ch.used = offset + bytes;
+    return ch.data.get() + offset;
+  }
+
+  size_t __chunk_bytes;
+  bool __poison;
+  size_t __current = 0;
+  size_t __reserved = 0;
+  vector<__chunk> __chunks;
+};
+
+// Allocate storage for an mdspan from `a`, sized by the mapping's
+// required_span_size().  The elements are left uninitialized (or poisoned),
+// which is why T must be trivial; the storage lives until the arena is reset
+// or rewound past it.
+template <class T, class Extents, class LayoutPolicy = layout_right, class... SizeTypes>
+mdspan<T, Extents, LayoutPolicy>
+make_mdspan(arena& a, SizeTypes... dynamic_extents) {
+  static_assert(_MDSPAN_TRAIT(is_trivially_default_constructible, T) && _MDSPAN_TRAIT(is_trivially_destructible, T),
+    "std::experimental::make_mdspan(arena&, ...) requires a trivial element type.");
+  using mapping_type = typename LayoutPolicy::template mapping<Extents>;
+  const mapping_type map{Extents(dynamic_extents...)};
+  void* p = a.allocate(map.required_span_size() * sizeof(T),
+                       alignof(T) > arena::default_alignment ? alignof(T) : arena::default_alignment);
+  return mdspan<T, Extents, LayoutPolicy>(static_cast<T*>(p), map);
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,567 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "for_each_index.hpp"
+#include "simd.hpp"
+
+#include <algorithm> // min
+#include <cmath> // abs
+#include <cstddef> // size_t
+#include <type_traits>
+#include <utility> // swap, index_sequence
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// Batched kernels over mdspans whose dimension 0 indexes the batch and whose
+// other extents are compile-time constants, e.g. extents<dynamic_extent, 3, 3>
+// for a batch of 3x3 matrices:
+//
+//   batched_add(a, b, c)              c[m] = a[m] + b[m]
+//   batched_matrix_product(a, b, c)   c[m] = a[m] * b[m]
+//   batched_determinant(a, d)         d[m] = det(a[m])
+//   batched_inverse(a, c)             c[m] = a[m]^-1
+//   batched_solve(a, b, x)            a[m] * x[m] = b[m]
+//
+// The kernels work on one simd batch of matrices at a time, one matrix per
+// lane: every element of the (fully unrolled) per-matrix formula becomes one
+// vector operation over as many matrices as a register holds, whatever the
+// size of the matrices.  This needs dimension 0 to have stride 1 in every
+// operand (layout_left, i.e. structure-of-arrays), so that each element of a
+// batch is one vector load; otherwise the kernels run the same unrolled
+// formulas one matrix at a time.
+//
+// Determinant, inverse and solve use the adjugate for matrices up to 3x3, so
+// they are branch-free and vectorize across the batch.  Larger matrices are
+// factored one at a time with partial pivoting.  Neither checks for singular
+// matrices (floating-point results are then inf or NaN).
+
+namespace detail {
+
+// Matrices per batch: one native vector of T.
+template <class T>
+struct __batched_lanes : integral_constant<size_t,
+  __simd_vectorizable<T>::value && sizeof(T) < __simd_native_bytes ? __simd_native_bytes / sizeof(T) : 1
+> { };
+
+// Product of the static extents of dimensions R ... rank-1.
+template <class Extents>
+constexpr size_t __batched_inner(size_t r) noexcept {
+  return r >= Extents::rank() ? 1 : Extents::static_extent(r) * __batched_inner<Extents>(r + 1);
+}
+
+template <class Extents>
+constexpr bool __batched_all_static(size_t r) noexcept {
+  return r >= Extents::rank() || (Extents::static_extent(r) != dynamic_extent && __batched_all_static<Extents>(r + 1));
+}
+
+// Elements per matrix (of dimensions 1 ... rank-1), which must be static.
+template <class MDSpan>
+struct __batched_elements : integral_constant<size_t, __batched_inner<typename MDSpan::extents_type>(1)> {
+  static_assert(MDSpan::extents_type::rank() >= 1 && __batched_all_static<typename MDSpan::extents_type>(1),
+    "std::experimental::batched_* require static extents past the batch dimension.");
+  static_assert(__batched_inner<typename MDSpan::extents_type>(1) != 0,
+    "std::experimental::batched_* require non-empty matrices.");
+};
+
+// Offset of element e (row-major over dimensions 1 ... rank-1) of matrix b.
+template <class MDSpan, size_t... Rs>
+MDSPAN_INLINE_FUNCTION
+size_t __batched_offset(MDSpan const& m, size_t b, size_t e, index_sequence<Rs...>) {
+  using extents_type = typename MDSpan::extents_type;
+  (void)e; // rank 1: one element per matrix
+  return size_t(m.mapping()(b,
+    (e / __batched_inner<extents_type>(Rs + 2)) % extents_type::static_extent(Rs + 1)...));
+}
+
+template <class MDSpan>
+MDSPAN_INLINE_FUNCTION
+size_t __batched_offset(MDSpan const& m, size_t b, size_t e) {
+  return __batched_offset(m, b, e, make_index_sequence<MDSpan::extents_type::rank() - 1>());
+}
+
+// Whether a batch of consecutive matrices can be read with vector loads:
+// plain pointer access and stride 1 along the batch dimension.
+template <class MDSpan>
+struct __batched_may_be_direct : integral_constant<bool,
+  __simd_is_raw<MDSpan>::value && MDSpan::mapping_type::is_always_strided()
+> { };
+
+template <class MDSpan>
+bool __batched_is_direct(MDSpan const& m, true_type) { return m.stride(0) == 1; }
+
+template <class MDSpan>
+bool __batched_is_direct(MDSpan const&, false_type) { return false; }
+
+template <class T, size_t Lanes = __batched_lanes<T>::value>
+struct __batched_io {
+  using __batch = __simd_batch<T, Lanes>;
+  using vector = typename __batch::type;
+
+  template <size_t N>
+  using __unrolled = __static_for<0, N>;
+
+  static constexpr size_t __batch_size() noexcept { return Lanes; }
+
+  // v[e], lane l = element e of matrix b0 + l.  Lanes past count repeat matrix
+  // b0, so they hold valid (if redundant) input.
+  template <class MDSpan>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __load(MDSpan const& m, size_t b0, size_t count, vector* v) {
+    constexpr size_t elements = __batched_elements<MDSpan>::value;
+    if(count == Lanes && __batched_is_direct(m, __batched_may_be_direct<MDSpan>())) {
+      __load_direct(m, b0, v, __batched_may_be_direct<MDSpan>());
+      return;
+    }
+    const auto acc = m.accessor();
+    T buffer[elements][Lanes];
+    for(size_t l = 0; l < Lanes; ++l) {
+      const size_t b = b0 + (l < count ? l : 0);
+      __unrolled<elements>::__apply([&](size_t e) { buffer[e][l] = T(acc.access(m.data(), __batched_offset(m, b, e))); });
+    }
+    __unrolled<elements>::__apply([&](size_t e) { __batch::__load(v[e], buffer[e]); });
+  }
+
+  // Element e of matrix b0 + l = v[e], lane l, for l < count.
+  template <class MDSpan>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __store(MDSpan const& m, size_t b0, size_t count, vector const* v) {
+    constexpr size_t elements = __batched_elements<MDSpan>::value;
+    if(count == Lanes && __batched_is_direct(m, __batched_may_be_direct<MDSpan>())) {
+      __store_direct(m, b0, v, __batched_may_be_direct<MDSpan>());
+      return;
+    }
+    const auto acc = m.accessor();
+    T buffer[elements][Lanes];
+    __unrolled<elements>::__apply([&](size_t e) { __batch::__store(v[e], buffer[e]); });
+    for(size_t l = 0; l < count; ++l) {
+      __unrolled<elements>::__apply([&](size_t e) { acc.access(m.data(), __batched_offset(m, b0 + l, e)) = buffer[e][l]; });
+    }
+  }
+
+private:
+  template <class MDSpan>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __load_direct(MDSpan const& m, size_t b0, vector* v, true_type) {
+    __unrolled<__batched_elements<MDSpan>::value>::__apply([&](size_t e) {
+      __batch::__load(v[e], m.data() + __batched_offset(m, b0, e));
+    });
+  }
+
+  template <class MDSpan>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __load_direct(MDSpan const&, size_t, vector*, false_type) { }
+
+  template <class MDSpan>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __store_direct(MDSpan const& m, size_t b0, vector const* v, true_type) {
+    __unrolled<__batched_elements<MDSpan>::value>::__apply([&](size_t e) {
+      __batch::__store(v[e], m.data() + __batched_offset(m, b0, e));
+    });
+  }
+
+  template <class MDSpan>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __store_direct(MDSpan const&, size_t, vector const*, false_type) { }
+};
+
+//------------------------------------------------------------------------------
+// Per-batch formulas on simd batches (one matrix per lane), row-major.
+
+template <class T, size_t N, class V>
+struct __batched_adjugate;
+
+template <class T, class V>
+struct __batched_adjugate<T, 1, V> {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __apply(V const*, V* adj) { adj[0] = V() + T(1); }
+};
+
+template <class T, class V>
+struct __batched_adjugate<T, 2, V> {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __apply(V const* a, V* adj) {
+    adj[0] = a[3];
+    adj[1] = T(0) - a[1];
+    adj[2] = T(0) - a[2];
+    adj[3] = a[0];
+  }
+};
+
+template <class T, class V>
+struct __batched_adjugate<T, 3, V> {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __apply(V const* a, V* adj) {
+    adj[0] = a[4] * a[8] - a[5] * a[7];
+    adj[1] = a[2] * a[7] - a[1] * a[8];
+    adj[2] = a[1] * a[5] - a[2] * a[4];
+    adj[3] = a[5] * a[6] - a[3] * a[8];
+    adj[4] = a[0] * a[8] - a[2] * a[6];
+    adj[5] = a[2] * a[3] - a[0] * a[5];
+    adj[6] = a[3] * a[7] - a[4] * a[6];
+    adj[7] = a[1] * a[6] - a[0] * a[7];
+    adj[8] = a[0] * a[4] - a[1] * a[3];
+  }
+};
+
+// det(a) from the first row of a and the first column of its adjugate.
+template <size_t N, class V>
+MDSPAN_INLINE_FUNCTION
+V __batched_det_from_adjugate(V const* a, V const* adj) {
+  V det = a[0] * adj[0];
+  __static_for<1, N>::__apply([&](size_t k) { det += a[k] * adj[k * N]; });
+  return det;
+}
+
+//------------------------------------------------------------------------------
+// One matrix at a time, for N > 3: LU factorization with partial pivoting of a
+// copy, row-major in lu; row i of the factors is row perm[i] of the matrix.
+
+template <class T, size_t N>
+struct __batched_lu {
+  T lu[N * N];
+  size_t perm[N];
+  T sign;
+
+  template <class MDSpan>
+  void __factor(MDSpan const& m, size_t b) {
+    const auto acc = m.accessor();
+    for(size_t e = 0; e < N * N; ++e) lu[e] = T(acc.access(m.data(), __batched_offset(m, b, e)));
+    for(size_t i = 0; i < N; ++i) perm[i] = i;
+    sign = T(1);
+    using std::abs; // not std::experimental::abs (for simd)
+    for(size_t k = 0; k < N; ++k) {
+      size_t pivot = k;
+      for(size_t i = k + 1; i < N; ++i) {
+        if(abs(lu[i * N + k]) > abs(lu[pivot * N + k])) pivot = i;
+      }
+      if(pivot != k) {
+        for(size_t j = 0; j < N; ++j) std::swap(lu[k * N + j], lu[pivot * N + j]);
+        std::swap(perm[k], perm[pivot]);
+        sign = T(0) - sign;
+      }
+      const T inverse_pivot = T(1) / lu[k * N + k];
+      for(size_t i = k + 1; i < N; ++i) {
+        const T factor = lu[i * N + k] * inverse_pivot;
+        lu[i * N + k] = factor;
+        for(size_t j = k + 1; j < N; ++j) lu[i * N + j] -= factor * lu[k * N + j];
+      }
+    }
+  }
+
+  T __determinant() const {
+    T det = sign;
+    for(size_t k = 0; k < N; ++k) det *= lu[k * N + k];
+    return det;
+  }
+
+  // x = a^-1 rhs, rhs already permuted into x.
+  void __solve_in_place(T* x) const {
+    for(size_t i = 1; i < N; ++i) {
+      for(size_t j = 0; j < i; ++j) x[i] -= lu[i * N + j] * x[j];
+    }
+    for(size_t i = N; i-- > 0;) {
+      for(size_t j = i + 1; j < N; ++j) x[i] -= lu[i * N + j] * x[j];
+      x[i] = x[i] / lu[i * N + i];
+    }
+  }
+};
+
+template <class MDSpan>
+struct __batched_square : integral_constant<size_t, MDSpan::extents_type::static_extent(1)> {
+  static_assert(MDSpan::extents_type::rank() == 3 &&
+    MDSpan::extents_type::static_extent(1) == MDSpan::extents_type::static_extent(2),
+    "std::experimental::batched_* require a batch of square matrices.");
+};
+
+template <size_t Lanes, class A, class D>
+void __batched_determinant(A const& a, D const& d, true_type /* adjugate */) {
+  using T = typename D::value_type;
+  using io = __batched_io<T, Lanes>;
+  using vector = typename io::vector;
+  constexpr size_t N = __batched_square<A>::value;
+  const size_t n = a.extent(0);
+  for(size_t b0 = 0; b0 < n; b0 += io::__batch_size()) {
+    const size_t count = std::min(io::__batch_size(), n - b0);
+    vector va[N * N], adj[N * N];
+    io::__load(a, b0, count, va);
+    __batched_adjugate<T, N, vector>::__apply(va, adj);
+    const vector det = __batched_det_from_adjugate<N>(va, adj);
+    io::__store(d, b0, count, &det);
+  }
+}
+
+template <size_t, class A, class D>
+void __batched_determinant(A const& a, D const& d, false_type /* adjugate */) {
+  using T = typename D::value_type;
+  constexpr size_t N = __batched_square<A>::value;
+  const auto acc = d.accessor();
+  for(size_t b = 0; b < a.extent(0); ++b) {
+    __batched_lu<T, N> lu;
+    lu.__factor(a, b);
+    acc.access(d.data(), d.mapping()(b)) = lu.__determinant();
+  }
+}
+
+template <size_t Lanes, class A, class C>
+void __batched_inverse(A const& a, C const& c, true_type /* adjugate */) {
+  using T = typename C::value_type;
+  using io = __batched_io<T, Lanes>;
+  using vector = typename io::vector;
+  constexpr size_t N = __batched_square<A>::value;
+  const size_t n = a.extent(0);
+  for(size_t b0 = 0; b0 < n; b0 += io::__batch_size()) {
+    const size_t count = std::min(io::__batch_size(), n - b0);
+    vector va[N * N], adj[N * N];
+    io::__load(a, b0, count, va);
+    __batched_adjugate<T, N, vector>::__apply(va, adj);
+    const vector r = T(1) / __batched_det_from_adjugate<N>(va, adj);
+    __static_for<0, N * N>::__apply([&](size_t e) { adj[e] = adj[e] * r; });
+    io::__store(c, b0, count, adj);
+  }
+}
+
+template <size_t, class A, class C>
+void __batched_inverse(A const& a, C const& c, false_type /* adjugate */) {
+  using T = typename C::value_type;
+  constexpr size_t N = __batched_square<A>::value;
+  const auto acc = c.accessor();
+  for(size_t b = 0; b < a.extent(0); ++b) {
+    __batched_lu<T, N> lu;
+    lu.__factor(a, b);
+    for(size_t j = 0; j < N; ++j) {
+      T x[N];
+      for(size_t i = 0; i < N; ++i) x[i] = lu.perm[i] == j ? T(1) : T(0);
+      lu.__solve_in_place(x);
+      for(size_t i = 0; i < N; ++i) acc.access(c.data(), c.mapping()(b, i, j)) = x[i];
+    }
+  }
+}
+
+template <size_t Lanes, class A, class B, class X>
+void __batched_solve(A const& a, B const& rhs, X const& x, true_type /* adjugate */) {
+  using T = typename X::value_type;
+  using io = __batched_io<T, Lanes>;
+  using vector = typename io::vector;
+  constexpr size_t N = __batched_square<A>::value;
+  const size_t n = a.extent(0);
+  for(size_t b0 = 0; b0 < n; b0 += io::__batch_size()) {
+    const size_t count = std::min(io::__batch_size(), n - b0);
+    vector va[N * N], adj[N * N], vb[N], vx[N];
+    io::__load(a, b0, count, va);
+    io::__load(rhs, b0, count, vb);
+    __batched_adjugate<T, N, vector>::__apply(va, adj);
+    const vector r = T(1) / __batched_det_from_adjugate<N>(va, adj);
+    __static_for<0, N>::__apply([&](size_t i) {
+      vector s = adj[i * N] * vb[0];
+      __static_for<1, N>::__apply([&](size_t j) { s += adj[i * N + j] * vb[j]; });
+      vx[i] = s * r;
+    });
+    io::__store(x, b0, count, vx);
+  }
+}
+
+template <size_t, class A, class B, class X>
+void __batched_solve(A const& a, B const& rhs, X const& x, false_type /* adjugate */) {
+  using T = typename X::value_type;
+  constexpr size_t N = __batched_square<A>::value;
+  const auto rhs_acc = rhs.accessor();
+  const auto x_acc = x.accessor();
+  for(size_t b = 0; b < a.extent(0); ++b) {
+    __batched_lu<T, N> lu;
+    lu.__factor(a, b);
+    T v[N];
+    for(size_t i = 0; i < N; ++i) v[i] = T(rhs_acc.access(rhs.data(), rhs.mapping()(b, lu.perm[i])));
+    lu.__solve_in_place(v);
+    for(size_t i = 0; i < N; ++i) x_acc.access(x.data(), x.mapping()(b, i)) = v[i];
+  }
+}
+
+template <size_t Lanes, class A, class B, class C>
+void __batched_add(A const& a, B const& b, C const& c) {
+  using T = typename C::value_type;
+  using io = __batched_io<T, Lanes>;
+  using vector = typename io::vector;
+  constexpr size_t S = __batched_elements<C>::value;
+  const size_t n = c.extent(0);
+  for(size_t b0 = 0; b0 < n; b0 += io::__batch_size()) {
+    const size_t count = std::min(io::__batch_size(), n - b0);
+    vector va[S], vb[S];
+    io::__load(a, b0, count, va);
+    io::__load(b, b0, count, vb);
+    __static_for<0, S>::__apply([&](size_t e) { va[e] += vb[e]; });
+    io::__store(c, b0, count, va);
+  }
+}
+
+template <size_t Lanes, class A, class B, class C>
+void __batched_matrix_product(A const& a, B const& b, C const& c) {
+  using T = typename C::value_type;
+  using io = __batched_io<T, Lanes>;
+  using vector = typename io::vector;
+  constexpr size_t M = C::extents_type::static_extent(1);
+  constexpr size_t N = C::extents_type::static_extent(2);
+  constexpr size_t K = A::extents_type::static_extent(2);
+  const size_t n = c.extent(0);
+  for(size_t b0 = 0; b0 < n; b0 += io::__batch_size()) {
+    const size_t count = std::min(io::__batch_size(), n - b0);
+    vector va[M * K], vb[K * N], vc[M * N];
+    io::__load(a, b0, count, va);
+    io::__load(b, b0, count, vb);
+    __static_for<0, M * N>::__apply([&](size_t ij) {
+      const size_t i = ij / N, j = ij % N;
+      vector sum = va[i * K] * vb[j];
+      __static_for<1, K>::__apply([&](size_t k) { sum += va[i * K + k] * vb[k * N + j]; });
+      vc[ij] = sum;
+    });
+    io::__store(c, b0, count, vc);
+  }
+}
+
+// Whether every operand has stride 1 along the batch.  The kernels then run a
+// full simd batch of matrices per step; otherwise gathering the lanes costs
+// more than it saves, and they run the same formulas one matrix at a time.
+inline bool __batched_all_direct() { return true; }
+
+template <class MDSpan, class... MDSpans>
+bool __batched_all_direct(MDSpan const& m, MDSpans const&... ms) {
+  return __batched_is_direct(m, __batched_may_be_direct<MDSpan>()) && __batched_all_direct(ms...);
+}
+
+} // end namespace detail
+
+// c[m] = a[m] + b[m] for every m < a.extent(0).  c may alias a or b.
+MDSPAN_TEMPLATE_REQUIRES(
+  class A, class B, class C,
+  /* requires */ (detail::__is_mdspan<A>::value && detail::__is_mdspan<B>::value && detail::__is_mdspan<C>::value)
+)
+void batched_add(A const& a, B const& b, C const& c) {
+  static_assert(A::extents_type::rank() == C::extents_type::rank() && B::extents_type::rank() == C::extents_type::rank() &&
+    detail::__static_extents_match<typename A::extents_type, typename C::extents_type>() &&
+    detail::__static_extents_match<typename B::extents_type, typename C::extents_type>(),
+    "std::experimental::batched_add requires matrices of the same size.");
+  _MDSPAN_CHECK_EXTENT("batched_add", a.extent(0), c.extent(0));
+  _MDSPAN_CHECK_EXTENT("batched_add", b.extent(0), c.extent(0));
+  constexpr size_t lanes = detail::__batched_lanes<typename C::value_type>::value;
+  if(detail::__batched_all_direct(a, b, c)) detail::__batched_add<lanes>(a, b, c);
+  else detail::__batched_add<1>(a, b, c);
+}
+
+// c[m] = a[m] * b[m] (matrix product) for a batch of M x K matrices a and
+// K x N matrices b.  c must not alias a or b.
+MDSPAN_TEMPLATE_REQUIRES(
+  class A, class B, class C,
+  /* requires */ (detail::__is_mdspan<A>::value && detail::__is_mdspan<B>::value && detail::__is_mdspan<C>::value)
+)
+void batched_matrix_product(A const& a, B const& b, C const& c) {
+  static_assert(A::extents_type::rank() == 3 && B::extents_type::rank() == 3 && C::extents_type::rank() == 3,
+    "std::experimental::batched_matrix_product requires batches of matrices (rank 3).");
+  static_assert(
+    detail::__batched_elements<A>::value == C::extents_type::static_extent(1) * A::extents_type::static_extent(2) &&
+    detail::__batched_elements<B>::value == A::extents_type::static_extent(2) * C::extents_type::static_extent(2),
+    "std::experimental::batched_matrix_product requires M x K times K x N matrices.");
+  _MDSPAN_CHECK_EXTENT("batched_matrix_product", a.extent(0), c.extent(0));
+  _MDSPAN_CHECK_EXTENT("batched_matrix_product", b.extent(0), c.extent(0));
+  constexpr size_t lanes = detail::__batched_lanes<typename C::value_type>::value;
+  if(detail::__batched_all_direct(a, b, c)) detail::__batched_matrix_product<lanes>(a, b, c);
+  else detail::__batched_matrix_product<1>(a, b, c);
+}
+
+// d[m] = det(a[m]) for a batch of square matrices a and a rank-1 d.
+MDSPAN_TEMPLATE_REQUIRES(
+  class A, class D,
+  /* requires */ (detail::__is_mdspan<A>::value && detail::__is_mdspan<D>::value)
+)
+void batched_determinant(A const& a, D const& d) {
+  static_assert(D::extents_type::rank() == 1,
+    "std::experimental::batched_determinant writes one value per matrix (rank 1).");
+  _MDSPAN_CHECK_EXTENT("batched_determinant", a.extent(0), d.extent(0));
+  constexpr size_t lanes = detail::__batched_lanes<typename D::value_type>::value;
+  using adjugate = integral_constant<bool, (detail::__batched_square<A>::value <= 3)>;
+  if(detail::__batched_all_direct(a, d)) detail::__batched_determinant<lanes>(a, d, adjugate());
+  else detail::__batched_determinant<1>(a, d, adjugate());
+}
+
+// c[m] = inverse of a[m] for a batch of square matrices.  c may be a.
+MDSPAN_TEMPLATE_REQUIRES(
+  class A, class C,
+  /* requires */ (detail::__is_mdspan<A>::value && detail::__is_mdspan<C>::value)
+)
+void batched_inverse(A const& a, C const& c) {
+  static_assert(detail::__batched_square<C>::value == detail::__batched_square<A>::value,
+    "std::experimental::batched_inverse requires matrices of the same size.");
+  _MDSPAN_CHECK_EXTENT("batched_inverse", a.extent(0), c.extent(0));
+  constexpr size_t lanes = detail::__batched_lanes<typename C::value_type>::value;
+  using adjugate = integral_constant<bool, (detail::__batched_square<A>::value <= 3)>;
+  if(detail::__batched_all_direct(a, c)) detail::__batched_inverse<lanes>(a, c, adjugate());
+  else detail::__batched_inverse<1>(a, c, adjugate());
+}
+
+// Solves a[m] * x[m] = b[m] for a batch of square matrices a and vectors b
+// and x (rank 2).  x may alias b.
+MDSPAN_TEMPLATE_REQUIRES(
+  class A, class B, class X,
+  /* requires */ (detail::__is_mdspan<A>::value && detail::__is_mdspan<B>::value && detail::__is_mdspan<X>::value)
+)
+void batched_solve(A const& a, B const& b, X const& x) {
+  static_assert(B::extents_type::rank() == 2 && X::extents_type::rank() == 2,
+    "std::experimental::batched_solve requires batches of vectors (rank 2) for b and x.");
+  static_assert(B::extents_type::static_extent(1) == detail::__batched_square<A>::value &&
+    X::extents_type::static_extent(1) == detail::__batched_square<A>::value,
+    "std::experimental::batched_solve requires vectors of the size of the matrices.");
+  _MDSPAN_CHECK_EXTENT("batched_solve", a.extent(0), x.extent(0));
+  _MDSPAN_CHECK_EXTENT("batched_solve", b.extent(0), x.extent(0));
+  constexpr size_t lanes = detail::__batched_lanes<typename X::value_type>::value;
+  using adjugate = integral_constant<bool, (detail::__batched_square<A>::value <= 3)>;
+  if(detail::__batched_all_direct(a, b, x)) detail::__batched_solve<lanes>(a, b, x, adjugate());
+  else detail::__batched_solve<1>(a, b, x, adjugate());
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,471 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "for_each_index.hpp"
+
+#include <climits> // CHAR_BIT
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <limits>
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// bitpacked_accessor: one bit per element, packed into unsigned words.
+//
+// The pointer carries a bit offset in addition to the word pointer so that
+// submdspan can start a view in the middle of a word.  The reference type is a
+// proxy (bit_reference) for mutable words and plain bool for const words.
+// Note that writes to different bits of the same word are *not* atomic, so
+// concurrent writers must partition the index space on word boundaries.
+
+template <class Word>
+struct bitpacked_pointer {
+
+  static_assert(_MDSPAN_TRAIT(is_unsigned, remove_const_t<Word>),
+    "std::experimental::bitpacked_pointer requires an unsigned integral word type.");
+
+  using word_type = Word;
+
+  Word* word = nullptr;
+  size_t bit = 0;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr bitpacked_pointer() noexcept = default;
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr bitpacked_pointer(Word* w, size_t b = 0) noexcept // NOLINT(google-explicit-constructor)
+    : word(w), bit(b)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherWord,
+    /* requires */ (
+      !_MDSPAN_TRAIT(is_same, OtherWord, Word) &&
+      _MDSPAN_TRAIT(is_convertible, OtherWord(*)[], Word(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr bitpacked_pointer(bitpacked_pointer<OtherWord> const& other) noexcept // NOLINT(google-explicit-constructor)
+    : word(other.word), bit(other.bit)
+  { }
+
+  MDSPAN_INLINE_FUNCTION
+  friend constexpr bool operator==(bitpacked_pointer const& lhs, bitpacked_pointer const& rhs) noexcept {
+    return lhs.word == rhs.word && lhs.bit == rhs.bit;
+  }
+  MDSPAN_INLINE_FUNCTION
+  friend constexpr bool operator!=(bitpacked_pointer const& lhs, bitpacked_pointer const& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+};
+
+template <class Word>
+class bit_reference {
+private:
+  Word* __word;
+  Word __mask;
+
+public:
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr bit_reference(Word* w, Word mask) noexcept
+    : __word(w), __mask(mask)
+  { }
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr bit_reference(bit_reference const&) noexcept = default;
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr operator bool() const noexcept { return (*__word & __mask) != 0; } // NOLINT(google-explicit-constructor)
+
+  MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+  bit_reference const& operator=(bool value) const noexcept {
+    if(value) *__word |= __mask;
+    else *__word &= Word(~__mask);
+    return *this;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+  bit_reference const& operator=(bit_reference const& other) const noexcept {
+    return *this = bool(other);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+  bit_reference const& operator|=(bool value) const noexcept {
+    if(value) *__word |= __mask;
+    return *this;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+  bit_reference const& operator&=(bool value) const noexcept {
+    if(!value) *__word &= Word(~__mask);
+    return *this;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+  bit_reference const& operator^=(bool value) const noexcept {
+    if(value) *__word ^= __mask;
+    return *this;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+  void flip() const noexcept { *__word ^= __mask; }
+};
+
+template <class Word = uint64_t>
+struct bitpacked_accessor {
+
+  static_assert(_MDSPAN_TRAIT(is_unsigned, remove_const_t<Word>),
+    "std::experimental::bitpacked_accessor requires an unsigned integral word type.");
+
+  using offset_policy = bitpacked_accessor;
+  using word_type = Word;
+  using element_type = conditional_t<_MDSPAN_TRAIT(is_const, Word), const bool, bool>;
+  using reference = conditional_t<_MDSPAN_TRAIT(is_const, Word), bool, bit_reference<Word>>;
+  using pointer = bitpacked_pointer<Word>;
+
+  static constexpr size_t bits_per_word = sizeof(Word) * CHAR_BIT;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr bitpacked_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherWord,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherWord(*)[], Word(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr bitpacked_accessor(bitpacked_accessor<OtherWord>) noexcept {}
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr pointer
+  offset(pointer p, size_t i) const noexcept {
+    return pointer(p.word + (p.bit + i) / bits_per_word, (p.bit + i) % bits_per_word);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const noexcept {
+    return __access(p.word + (p.bit + i) / bits_per_word,
+                    Word(remove_const_t<Word>(1) << ((p.bit + i) % bits_per_word)));
+  }
+
+private:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static constexpr bit_reference<Word> __access_impl(Word* w, Word mask, false_type) noexcept {
+    return bit_reference<Word>(w, mask);
+  }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static constexpr bool __access_impl(Word* w, Word mask, true_type) noexcept {
+    return (*w & mask) != 0;
+  }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static constexpr reference __access(Word* w, Word mask) noexcept {
+    return __access_impl(w, mask, integral_constant<bool, _MDSPAN_TRAIT(is_const, Word)>{});
+  }
+
+};
+
+template <class Word>
+constexpr size_t bitpacked_accessor<Word>::bits_per_word;
+
+template <class Extents, class LayoutPolicy = layout_right, class Word = uint64_t>
+using bitpacked_mdspan = mdspan<
+  conditional_t<_MDSPAN_TRAIT(is_const, Word), const bool, bool>,
+  Extents, LayoutPolicy, bitpacked_accessor<Word>
+>;
+
+// Number of words needed to back a mapping (or any span of `bits` elements).
+template <class Word = uint64_t>
+MDSPAN_INLINE_FUNCTION
+constexpr size_t bitpacked_word_count(size_t bits) noexcept {
+  return (bits + sizeof(Word) * CHAR_BIT - 1) / (sizeof(Word) * CHAR_BIT);
+}
+
+//==============================================================================
+// Word-at-a-time mask algorithms
+//
+// These take the fast path whenever every operand is contiguous, starts on a
+// word boundary, and (for multi-operand algorithms) shares the same mapping.
+// Otherwise they fall back to an element loop over the multi-index space.
+
+namespace detail {
+
+template <class Word>
+MDSPAN_FORCE_INLINE_FUNCTION
+_MDSPAN_CONSTEXPR_14 size_t __popcount(Word w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<size_t>(__builtin_popcountll(static_cast<unsigned long long>(w)));
+#else
+  size_t result = 0;
+  while(w) { w &= Word(w - 1); ++result; }
+  return result;
+#endif
+}
+
+template <class Word>
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr Word __low_bits_mask(size_t n) noexcept {
+  return n >= sizeof(Word) * CHAR_BIT ? Word(~Word(0)) : Word((Word(1) << n) - Word(1));
+}
+
+template <class MDSpan>
+MDSPAN_INLINE_FUNCTION
+constexpr bool __bitpacked_word_aligned(MDSpan const& m) noexcept {
+  return m.data().bit == 0 && m.is_contiguous();
+}
+
+// Mappings of different layouts never compare equal (and aren't comparable).
+template <class Mapping>
+MDSPAN_INLINE_FUNCTION
+constexpr bool __bitpacked_same_mapping(Mapping const& lhs, Mapping const& rhs) noexcept {
+  return lhs == rhs;
+}
+template <class MappingA, class MappingB>
+MDSPAN_INLINE_FUNCTION
+constexpr bool __bitpacked_same_mapping(MappingA const&, MappingB const&) noexcept {
+  return false;
+}
+
+struct __mask_and { template <class W> MDSPAN_FORCE_INLINE_FUNCTION constexpr W operator()(W a, W b) const noexcept { return W(a & b); } };
+struct __mask_or { template <class W> MDSPAN_FORCE_INLINE_FUNCTION constexpr W operator()(W a, W b) const noexcept { return W(a | b); } };
+struct __mask_xor { template <class W> MDSPAN_FORCE_INLINE_FUNCTION constexpr W operator()(W a, W b) const noexcept { return W(a ^ b); } };
+struct __mask_andnot { template <class W> MDSPAN_FORCE_INLINE_FUNCTION constexpr W operator()(W a, W b) const noexcept { return W(a & ~b); } };
+struct __mask_not { template <class W> MDSPAN_FORCE_INLINE_FUNCTION constexpr W operator()(W a, W) const noexcept { return W(~a); } };
+
+// Store the low `nbits` of `value` into `*dst`, leaving the other bits alone.
+template <class Word>
+MDSPAN_FORCE_INLINE_FUNCTION
+_MDSPAN_CONSTEXPR_14 void __store_masked(Word* dst, Word value, size_t nbits) noexcept {
+  Word keep = __low_bits_mask<Word>(nbits);
+  *dst = Word((*dst & Word(~keep)) | (value & keep));
+}
+
+template <class ETA, class ETB, class Extents, class LA, class LB, class LO, class WA, class WB, class WO, class Op>
+void __mask_binary_op(
+  mdspan<ETA, Extents, LA, bitpacked_accessor<WA>> const& a,
+  mdspan<ETB, Extents, LB, bitpacked_accessor<WB>> const& b,
+  mdspan<bool, Extents, LO, bitpacked_accessor<WO>> const& out,
+  Op op
+) {
+  using word_t = remove_const_t<WO>;
+  constexpr size_t bits = sizeof(word_t) * CHAR_BIT;
+  constexpr bool same_words =
+    _MDSPAN_TRAIT(is_same, remove_const_t<WA>, word_t) &&
+    _MDSPAN_TRAIT(is_same, remove_const_t<WB>, word_t);
+  if(same_words &&
+     __bitpacked_word_aligned(a) && __bitpacked_word_aligned(b) && __bitpacked_word_aligned(out) &&
+     __bitpacked_same_mapping(a.mapping(), out.mapping()) &&
+     __bitpacked_same_mapping(b.mapping(), out.mapping())) {
+    const size_t n = out.size();
+    const size_t full = n / bits;
+    auto* pa = a.data().word;
+    auto* pb = b.data().word;
+    word_t* po = out.data().word;
+    for(size_t w = 0; w < full; ++w) {
+      po[w] = op(word_t(pa[w]), word_t(pb[w]));
+    }
+    if(n % bits) {
+      __store_masked(po + full, op(word_t(pa[full]), word_t(pb[full])), n % bits);
+    }
+    return;
+  }
+  auto const acc_a = a.accessor();
+  auto const acc_b = b.accessor();
+  auto const acc_o = out.accessor();
+  auto const map_a = a.mapping();
+  auto const map_b = b.mapping();
+  auto const map_o = out.mapping();
+  experimental::for_each_index(map_o, [&](auto... idxs) {
+    const word_t va = bool(acc_a.access(a.data(), map_a(idxs...))) ? word_t(~word_t(0)) : word_t(0);
+    const word_t vb = bool(acc_b.access(b.data(), map_b(idxs...))) ? word_t(~word_t(0)) : word_t(0);
+    acc_o.access(out.data(), map_o(idxs...)) = bool(op(va, vb) & word_t(1));
+  });
+}
+
+} // end namespace detail
+
+// Number of set elements.
+template <class ET, class Extents, class Layout, class Word>
+size_t mask_count(mdspan<ET, Extents, Layout, bitpacked_accessor<Word>> const& m) {
+  using word_t = remove_const_t<Word>;
+  constexpr size_t bits = sizeof(word_t) * CHAR_BIT;
+  size_t result = 0;
+  if(detail::__bitpacked_word_aligned(m)) {
+    const size_t n = m.size();
+    const size_t full = n / bits;
+    Word* p = m.data().word;
+    for(size_t w = 0; w < full; ++w) {
+      result += detail::__popcount(word_t(p[w]));
+    }
+    if(n % bits) {
+      result += detail::__popcount(word_t(p[full] & detail::__low_bits_mask<word_t>(n % bits)));
+    }
+    return result;
+  }
+  auto const acc = m.accessor();
+  auto const map = m.mapping();
+  for_each_index(map, [&](auto... idxs) {
+    result += size_t(bool(acc.access(m.data(), map(idxs...))));
+  });
+  return result;
+}
+
+// True if any element is set.
+template <class ET, class Extents, class Layout, class Word>
+bool mask_any(mdspan<ET, Extents, Layout, bitpacked_accessor<Word>> const& m) {
+  using word_t = remove_const_t<Word>;
+  constexpr size_t bits = sizeof(word_t) * CHAR_BIT;
+  if(detail::__bitpacked_word_aligned(m)) {
+    const size_t n = m.size();
+    const size_t full = n / bits;
+    Word* p = m.data().word;
+    for(size_t w = 0; w < full; ++w) {
+      if(p[w] != word_t(0)) return true;
+    }
+    return (n % bits) && (p[full] & detail::__low_bits_mask<word_t>(n % bits)) != word_t(0);
+  }
+  return mask_count(m) != 0;
+}
+
+// True if every element is set (vacuously true for empty views).
+template <class ET, class Extents, class Layout, class Word>
+bool mask_all(mdspan<ET, Extents, Layout, bitpacked_accessor<Word>> const& m) {
+  using word_t = remove_const_t<Word>;
+  constexpr size_t bits = sizeof(word_t) * CHAR_BIT;
+  if(detail::__bitpacked_word_aligned(m)) {
+    const size_t n = m.size();
+    const size_t full = n / bits;
+    Word* p = m.data().word;
+    for(size_t w = 0; w < full; ++w) {
+      if(p[w] != word_t(~word_t(0))) return false;
+    }
+    const word_t tail = detail::__low_bits_mask<word_t>(n % bits);
+    return (n % bits) == 0 || (p[full] & tail) == tail;
+  }
+  return mask_count(m) == m.size();
+}
+
+// Set every element of `out` to `value`.
+template <class Extents, class Layout, class Word>
+void mask_fill(mdspan<bool, Extents, Layout, bitpacked_accessor<Word>> const& out, bool value) {
+  constexpr size_t bits = sizeof(Word) * CHAR_BIT;
+  if(detail::__bitpacked_word_aligned(out)) {
+    const size_t n = out.size();
+    const size_t full = n / bits;
+    const Word fill = value ? Word(~Word(0)) : Word(0);
+    Word* p = out.data().word;
+    for(size_t w = 0; w < full; ++w) {
+      p[w] = fill;
+    }
+    if(n % bits) {
+      detail::__store_masked(p + full, fill, n % bits);
+    }
+    return;
+  }
+  auto const acc = out.accessor();
+  auto const map = out.mapping();
+  for_each_index(map, [&](auto... idxs) {
+    acc.access(out.data(), map(idxs...)) = value;
+  });
+}
+
+// out = a & b
+template <class ETA, class ETB, class Extents, class LA, class LB, class LO, class WA, class WB, class WO>
+void mask_and(
+  mdspan<ETA, Extents, LA, bitpacked_accessor<WA>> const& a,
+  mdspan<ETB, Extents, LB, bitpacked_accessor<WB>> const& b,
+  mdspan<bool, Extents, LO, bitpacked_accessor<WO>> const& out
+) {
+  detail::__mask_binary_op(a, b, out, detail::__mask_and{});
+}
+
+// out = a | b
+template <class ETA, class ETB, class Extents, class LA, class LB, class LO, class WA, class WB, class WO>
+void mask_or(
+  mdspan<ETA, Extents, LA, bitpacked_accessor<WA>> const& a,
+  mdspan<ETB, Extents, LB, bitpacked_accessor<WB>> const& b,
+  mdspan<bool, Extents, LO, bitpacked_accessor<WO>> const& out
+) {
+  detail::__mask_binary_op(a, b, out, detail::__mask_or{});
+}
+
+// out = a ^ b
+template <class ETA, class ETB, class Extents, class LA, class LB, class LO, class WA, class WB, class WO>
+void mask_xor(
+  mdspan<ETA, Extents, LA, bitpacked_accessor<WA>> const& a,
+  mdspan<ETB, Extents, LB, bitpacked_accessor<WB>> const& b,
+  mdspan<bool, Extents, LO, bitpacked_accessor<WO>> const& out
+) {
+  detail::__mask_binary_op(a, b, out, detail::__mask_xor{});
+}
+
+// out = a & ~b
+template <class ETA, class ETB, class Extents, class LA, class LB, class LO, class WA, class WB, class WO>
+void mask_andnot(
+  mdspan<ETA, Extents, LA, bitpacked_accessor<WA>> const& a,
+  mdspan<ETB, Extents, LB, bitpacked_accessor<WB>> const& b,
+  mdspan<bool, Extents, LO, bitpacked_accessor<WO>> const& out
+) {
+  detail::__mask_binary_op(a, b, out, detail::__mask_andnot{});
+}
+
+// out = ~a
+template <class ETA, class Extents, class LA, class LO, class WA, class WO>
+void mask_not(
+  mdspan<ETA, Extents, LA, bitpacked_accessor<WA>> const& a,
+  mdspan<bool, Extents, LO, bitpacked_accessor<WO>> const& out
+) {
+  detail::__mask_binary_op(a, a, out, detail::__mask_not{});
+}
+
+} // end namespace experimental
+} // end namespace std
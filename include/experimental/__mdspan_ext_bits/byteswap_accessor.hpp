@@ -0,0 +1,437 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/bounds_check.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "for_each_index.hpp"
+
+#include <complex>
+#include <cstddef> // size_t
+#include <cstdint>
+#include <cstring> // memcpy
+#include <type_traits>
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#  include <immintrin.h>
+#endif
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// Accessors for foreign binary data: unaligned_accessor loads and stores
+// elements with memcpy, so the data need not be aligned for T, and
+// byteswap_accessor additionally reverses the byte order of every element.
+//
+// Both use a byte pointer, and the optional ByteStride is the distance in
+// bytes between consecutive elements of the codomain, so a field of a packed
+// record (e.g. the double in a 12-byte {int32, double} record) can be viewed
+// directly with ByteStride = 12.
+//
+// byteswap_accessor reverses the bytes of each scalar: the element itself for
+// arithmetic and enum types, the real and imaginary parts of a std::complex.
+// Other types have no single byte order to reverse and are rejected.
+
+namespace detail {
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+_MDSPAN_INLINE_VARIABLE constexpr bool __host_is_little_endian = false;
+#else
+_MDSPAN_INLINE_VARIABLE constexpr bool __host_is_little_endian = true;
+#endif
+
+template <size_t N>
+MDSPAN_INLINE_FUNCTION
+void __reverse_bytes(unsigned char* bytes) noexcept {
+  for(size_t i = 0; i < N / 2; ++i) {
+    unsigned char tmp = bytes[i];
+    bytes[i] = bytes[N - 1 - i];
+    bytes[N - 1 - i] = tmp;
+  }
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+template <>
+MDSPAN_INLINE_FUNCTION
+void __reverse_bytes<2>(unsigned char* bytes) noexcept {
+  uint16_t v; std::memcpy(&v, bytes, 2); v = __builtin_bswap16(v); std::memcpy(bytes, &v, 2);
+}
+template <>
+MDSPAN_INLINE_FUNCTION
+void __reverse_bytes<4>(unsigned char* bytes) noexcept {
+  uint32_t v; std::memcpy(&v, bytes, 4); v = __builtin_bswap32(v); std::memcpy(bytes, &v, 4);
+}
+template <>
+MDSPAN_INLINE_FUNCTION
+void __reverse_bytes<8>(unsigned char* bytes) noexcept {
+  uint64_t v; std::memcpy(&v, bytes, 8); v = __builtin_bswap64(v); std::memcpy(bytes, &v, 8);
+}
+#endif
+
+// The unit whose bytes are reversed; void for types without one.
+template <class T>
+struct __byteswap_scalar {
+  using type = conditional_t<_MDSPAN_TRAIT(is_arithmetic, T) || _MDSPAN_TRAIT(is_enum, T), T, void>;
+};
+
+template <class T>
+struct __byteswap_scalar<complex<T>> : __byteswap_scalar<T> { };
+
+template <class T>
+struct __byteswap_scalar<const T> : __byteswap_scalar<T> { };
+
+template <class T>
+using __byteswap_scalar_t = typename __byteswap_scalar<T>::type;
+
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __reverse_scalars(unsigned char* bytes, true_type /* swap */) noexcept {
+  constexpr size_t scalar_size = sizeof(__byteswap_scalar_t<T>);
+  for(size_t i = 0; i < sizeof(T); i += scalar_size) __reverse_bytes<scalar_size>(bytes + i);
+}
+
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __reverse_scalars(unsigned char*, false_type) noexcept { }
+
+template <class T, bool Swap>
+MDSPAN_INLINE_FUNCTION
+T __load_bytes(const unsigned char* p) noexcept {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, p, sizeof(T));
+  __reverse_scalars<T>(bytes, integral_constant<bool, Swap>{});
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+template <class T, bool Swap>
+MDSPAN_INLINE_FUNCTION
+void __store_bytes(unsigned char* p, T const& value) noexcept {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  __reverse_scalars<T>(bytes, integral_constant<bool, Swap>{});
+  std::memcpy(p, bytes, sizeof(T));
+}
+
+} // end namespace detail
+
+template <class T, bool Swap>
+class byte_reference {
+public:
+  explicit byte_reference(unsigned char* p) noexcept : __ptr(p) { }
+  byte_reference(byte_reference const&) = default;
+
+  operator T() const noexcept { return detail::__load_bytes<T, Swap>(__ptr); } // NOLINT(google-explicit-constructor)
+
+  byte_reference const& operator=(T const& v) const noexcept {
+    detail::__store_bytes<T, Swap>(__ptr, v);
+    return *this;
+  }
+  byte_reference const& operator=(byte_reference const& other) const noexcept { return *this = T(other); }
+  byte_reference const& operator+=(T const& v) const noexcept { return *this = T(*this) + v; }
+  byte_reference const& operator-=(T const& v) const noexcept { return *this = T(*this) - v; }
+  byte_reference const& operator*=(T const& v) const noexcept { return *this = T(*this) * v; }
+  byte_reference const& operator/=(T const& v) const noexcept { return *this = T(*this) / v; }
+
+private:
+  unsigned char* __ptr;
+};
+
+namespace detail {
+
+template <class ElementType, bool Swap, size_t ByteStride>
+struct __byte_accessor_base {
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, remove_const_t<ElementType>),
+    "std::experimental byte accessors require a trivially copyable element type.");
+  static_assert(ByteStride >= sizeof(ElementType),
+    "The byte stride of a byte accessor must be at least sizeof(ElementType).");
+  static_assert(!Swap || !_MDSPAN_TRAIT(is_void, __byteswap_scalar_t<ElementType>),
+    "std::experimental::byteswap_accessor requires an arithmetic, enum or std::complex element type.");
+
+  using element_type = ElementType;
+  using pointer = conditional_t<_MDSPAN_TRAIT(is_const, ElementType), const unsigned char*, unsigned char*>;
+  using reference = conditional_t<
+    _MDSPAN_TRAIT(is_const, ElementType),
+    remove_const_t<ElementType>,
+    byte_reference<ElementType, Swap>
+  >;
+
+  static constexpr size_t byte_stride = ByteStride;
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr pointer offset(pointer p, size_t i) const noexcept { return p + i * ByteStride; }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference access(pointer p, size_t i) const noexcept {
+    return __access(p + i * ByteStride, integral_constant<bool, _MDSPAN_TRAIT(is_const, ElementType)>{});
+  }
+
+private:
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static reference __access(pointer p, true_type) noexcept { return __load_bytes<remove_const_t<ElementType>, Swap>(p); }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static reference __access(pointer p, false_type) noexcept { return reference(p); }
+};
+
+} // end namespace detail
+
+template <class ElementType, size_t ByteStride = sizeof(ElementType)>
+struct unaligned_accessor : detail::__byte_accessor_base<ElementType, false, ByteStride> {
+  using offset_policy = unaligned_accessor;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr unaligned_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherElementType(*)[], ElementType(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr unaligned_accessor(unaligned_accessor<OtherElementType, ByteStride>) noexcept {}
+};
+
+template <class ElementType, size_t ByteStride = sizeof(ElementType)>
+struct byteswap_accessor : detail::__byte_accessor_base<ElementType, true, ByteStride> {
+  using offset_policy = byteswap_accessor;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr byteswap_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherElementType(*)[], ElementType(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr byteswap_accessor(byteswap_accessor<OtherElementType, ByteStride>) noexcept {}
+};
+
+// Accessors for data in a fixed byte order, whatever the host's.
+template <class ElementType, size_t ByteStride = sizeof(ElementType)>
+using big_endian_accessor = conditional_t<
+  detail::__host_is_little_endian,
+  byteswap_accessor<ElementType, ByteStride>,
+  unaligned_accessor<ElementType, ByteStride>
+>;
+
+template <class ElementType, size_t ByteStride = sizeof(ElementType)>
+using little_endian_accessor = conditional_t<
+  detail::__host_is_little_endian,
+  unaligned_accessor<ElementType, ByteStride>,
+  byteswap_accessor<ElementType, ByteStride>
+>;
+
+//==============================================================================
+// Bulk conversion between byte-swapped and native mdspans
+
+namespace detail {
+
+// Reverse each `Size`-byte scalar of src into dst; src and dst must not
+// overlap partially (src == dst is fine).
+template <size_t Size>
+void __byteswap_elements(const unsigned char* src, unsigned char* dst, size_t n) noexcept {
+  size_t i = 0;
+#if defined(__SSSE3__)
+  if(Size == 2 || Size == 4 || Size == 8) {
+    alignas(16) unsigned char shuffle[16];
+    for(size_t b = 0; b < 16; ++b) shuffle[b] = static_cast<unsigned char>((b / Size) * Size + (Size - 1 - b % Size));
+    const __m128i mask128 = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle));
+#  if defined(__AVX2__)
+    const __m256i mask256 = _mm256_broadcastsi128_si256(mask128);
+    for(; (i + 32 / Size) <= n; i += 32 / Size) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * Size));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * Size), _mm256_shuffle_epi8(v, mask256));
+    }
+#  endif
+    for(; (i + 16 / Size) <= n; i += 16 / Size) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * Size));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * Size), _mm_shuffle_epi8(v, mask128));
+    }
+  }
+#endif
+  for(; i < n; ++i) {
+    unsigned char bytes[Size];
+    std::memcpy(bytes, src + i * Size, Size);
+    __reverse_bytes<Size>(bytes);
+    std::memcpy(dst + i * Size, bytes, Size);
+  }
+}
+
+template <class MappingA, class MappingB>
+bool __same_contiguous_mapping(MappingA const&, MappingB const&) noexcept { return false; }
+
+template <class Mapping>
+bool __same_contiguous_mapping(Mapping const& a, Mapping const& b) noexcept {
+  return a == b && a.is_contiguous();
+}
+
+// Element-wise fallback: for non-contiguous or differently laid out operands.
+template <class Src, class Dst>
+void __byteswap_copy_elements(Src const& src, Dst const& dst) {
+  using value_t = remove_const_t<typename Dst::element_type>;
+  auto const src_acc = src.accessor();
+  auto const dst_acc = dst.accessor();
+  auto const src_map = src.mapping();
+  auto const dst_map = dst.mapping();
+  auto f = [&](auto... idxs) {
+    dst_acc.access(dst.data(), dst_map(idxs...)) = value_t(src_acc.access(src.data(), src_map(idxs...)));
+  };
+  experimental::for_each_index(dst_map, f);
+}
+
+} // end namespace detail
+
+namespace detail {
+
+// Reverse the scalars of n contiguous elements of type T.
+template <class T>
+void __byteswap_span(const unsigned char* src, unsigned char* dst, size_t n) noexcept {
+  using scalar_t = __byteswap_scalar_t<T>;
+  __byteswap_elements<sizeof(scalar_t)>(src, dst, n * (sizeof(T) / sizeof(scalar_t)));
+}
+
+template <class Src, class Dst>
+void __byteswap_copy_from_swapped(Src const& src, Dst const& dst, true_type /* native dst, packed src */) {
+  if(__same_contiguous_mapping(src.mapping(), dst.mapping())) {
+    __byteswap_span<typename Dst::element_type>(
+      src.data(), reinterpret_cast<unsigned char*>(dst.data()), dst.mapping().required_span_size());
+  }
+  else __byteswap_copy_elements(src, dst);
+}
+
+template <class Src, class Dst>
+void __byteswap_copy_from_swapped(Src const& src, Dst const& dst, false_type) {
+  __byteswap_copy_elements(src, dst);
+}
+
+template <class Src, class Dst>
+void __byteswap_copy_to_swapped(Src const& src, Dst const& dst, true_type /* native src, packed dst */) {
+  if(__same_contiguous_mapping(src.mapping(), dst.mapping())) {
+    __byteswap_span<typename Dst::element_type>(
+      reinterpret_cast<const unsigned char*>(src.data()), dst.data(), dst.mapping().required_span_size());
+  }
+  else __byteswap_copy_elements(src, dst);
+}
+
+template <class Src, class Dst>
+void __byteswap_copy_to_swapped(Src const& src, Dst const& dst, false_type) {
+  __byteswap_copy_elements(src, dst);
+}
+
+// Both operands are byte-swapped, so the bytes are copied as they are.
+template <class Src, class Dst>
+void __byteswap_copy_between_swapped(Src const& src, Dst const& dst, true_type /* both packed */) {
+  if(__same_contiguous_mapping(src.mapping(), dst.mapping())) {
+    std::memcpy(dst.data(), src.data(), dst.mapping().required_span_size() * sizeof(typename Dst::element_type));
+  }
+  else __byteswap_copy_elements(src, dst);
+}
+
+template <class Src, class Dst>
+void __byteswap_copy_between_swapped(Src const& src, Dst const& dst, false_type) {
+  __byteswap_copy_elements(src, dst);
+}
+
+} // end namespace detail
+
+// Convert byte-swapped data into a native mdspan.  Contiguous operands with
+// the same mapping and no padding between elements take a vectorized
+// (SSSE3/AVX2 where available) path.
+template <class SrcElementType, size_t SrcByteStride, class SrcExtents, class SrcLayout,
+          class DstElementType, class DstExtents, class DstLayout, class DstAccessor>
+void byteswap_copy(
+  mdspan<SrcElementType, SrcExtents, SrcLayout, byteswap_accessor<SrcElementType, SrcByteStride>> const& src,
+  mdspan<DstElementType, DstExtents, DstLayout, DstAccessor> const& dst)
+{
+  static_assert(_MDSPAN_TRAIT(is_same, remove_const_t<SrcElementType>, DstElementType),
+    "byteswap_copy requires matching element types.");
+  static_assert(SrcExtents::rank() == DstExtents::rank() && detail::__static_extents_match<SrcExtents, DstExtents>(),
+    "byteswap_copy requires matching extents.");
+  _MDSPAN_CHECK_EXTENTS("byteswap_copy", src.extents(), dst.extents());
+  detail::__byteswap_copy_from_swapped(src, dst, integral_constant<bool,
+    _MDSPAN_TRAIT(is_same, DstAccessor, default_accessor<DstElementType>) && SrcByteStride == sizeof(DstElementType)>{});
+}
+
+// Convert native data into a byte-swapped mdspan.
+template <class SrcElementType, class SrcExtents, class SrcLayout, class SrcAccessor,
+          class DstElementType, class DstExtents, size_t DstByteStride, class DstLayout>
+void byteswap_copy(
+  mdspan<SrcElementType, SrcExtents, SrcLayout, SrcAccessor> const& src,
+  mdspan<DstElementType, DstExtents, DstLayout, byteswap_accessor<DstElementType, DstByteStride>> const& dst)
+{
+  static_assert(_MDSPAN_TRAIT(is_same, remove_const_t<SrcElementType>, DstElementType),
+    "byteswap_copy requires matching element types.");
+  static_assert(SrcExtents::rank() == DstExtents::rank() && detail::__static_extents_match<SrcExtents, DstExtents>(),
+    "byteswap_copy requires matching extents.");
+  _MDSPAN_CHECK_EXTENTS("byteswap_copy", src.extents(), dst.extents());
+  detail::__byteswap_copy_to_swapped(src, dst, integral_constant<bool,
+    _MDSPAN_TRAIT(is_same, remove_const_t<SrcAccessor>, default_accessor<SrcElementType>) && DstByteStride == sizeof(DstElementType)>{});
+}
+
+// Copy between two byte-swapped mdspans, e.g. to repack a record field.
+template <class SrcElementType, size_t SrcByteStride, class SrcExtents, class SrcLayout,
+          class DstElementType, class DstExtents, size_t DstByteStride, class DstLayout>
+void byteswap_copy(
+  mdspan<SrcElementType, SrcExtents, SrcLayout, byteswap_accessor<SrcElementType, SrcByteStride>> const& src,
+  mdspan<DstElementType, DstExtents, DstLayout, byteswap_accessor<DstElementType, DstByteStride>> const& dst)
+{
+  static_assert(_MDSPAN_TRAIT(is_same, remove_const_t<SrcElementType>, DstElementType),
+    "byteswap_copy requires matching element types.");
+  static_assert(SrcExtents::rank() == DstExtents::rank() && detail::__static_extents_match<SrcExtents, DstExtents>(),
+    "byteswap_copy requires matching extents.");
+  _MDSPAN_CHECK_EXTENTS("byteswap_copy", src.extents(), dst.extents());
+  detail::__byteswap_copy_between_swapped(src, dst, integral_constant<bool,
+    SrcByteStride == sizeof(DstElementType) && DstByteStride == sizeof(DstElementType)>{});
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,384 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+
+#include <atomic>
+#include <climits> // CHAR_BIT
+#include <cstddef> // size_t
+#include <cstdint>
+#include <cstring> // memcpy
+#include <stdexcept> // invalid_argument
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// compressed_storage: lossless, immutable block compression for arithmetic
+// element types.  Elements are split into fixed-size blocks; each block stores
+// its first element verbatim and the rest as residuals against the previous
+// element, bit-packed at the smallest width that fits the whole block.
+//
+//   block_encoding::delta         zigzag(x[i] - x[i-1]) on an order-preserving
+//                                 integer image of x (good for smooth data)
+//   block_encoding::xor_previous  bits(x[i]) ^ bits(x[i-1]) (good for floats
+//                                 whose sign/exponent rarely change)
+//
+// compressed_accessor decodes a whole block into a small per-thread cache on
+// first access, so neighboring reads are served without decoding again.  The
+// accessor only sees offsets, so it works with any mapping; for tiled layouts
+// choose a block size that divides the tile size so tiles don't share blocks.
+
+enum class block_encoding { delta, xor_previous };
+
+namespace detail {
+
+template <size_t Size> struct __compressed_uint;
+template <> struct __compressed_uint<1> { using type = uint8_t; };
+template <> struct __compressed_uint<2> { using type = uint16_t; };
+template <> struct __compressed_uint<4> { using type = uint32_t; };
+template <> struct __compressed_uint<8> { using type = uint64_t; };
+
+// Map T to an unsigned integer such that the mapping is a bijection and, for
+// floating point, monotone in the value (so small value changes give small
+// deltas).
+template <class T>
+struct __compressed_traits {
+  using uint_t = typename __compressed_uint<sizeof(T)>::type;
+  static constexpr uint_t __sign_bit = uint_t(uint_t(1) << (sizeof(T) * CHAR_BIT - 1));
+
+  static uint_t __to_uint(T v, block_encoding enc) noexcept {
+    uint_t u;
+    std::memcpy(&u, &v, sizeof(T));
+    if(_MDSPAN_TRAIT(is_floating_point, T) && enc == block_encoding::delta) {
+      u = (u & __sign_bit) ? uint_t(~u) : uint_t(u | __sign_bit);
+    }
+    return u;
+  }
+
+  static T __from_uint(uint_t u, block_encoding enc) noexcept {
+    if(_MDSPAN_TRAIT(is_floating_point, T) && enc == block_encoding::delta) {
+      u = (u & __sign_bit) ? uint_t(u & ~__sign_bit) : uint_t(~u);
+    }
+    T v;
+    std::memcpy(&v, &u, sizeof(T));
+    return v;
+  }
+
+  static uint_t __residual(uint_t prev, uint_t cur, block_encoding enc) noexcept {
+    if(enc == block_encoding::xor_previous) return uint_t(prev ^ cur);
+    // zigzag of the (wrapping) signed difference
+    const uint_t diff = uint_t(cur - prev);
+    return (diff & __sign_bit) ? uint_t(~uint_t(diff << 1)) : uint_t(diff << 1);
+  }
+
+  static uint_t __apply_residual(uint_t prev, uint_t r, block_encoding enc) noexcept {
+    if(enc == block_encoding::xor_previous) return uint_t(prev ^ r);
+    const uint_t diff = (r & 1) ? uint_t(~uint_t(r >> 1)) : uint_t(r >> 1);
+    return uint_t(prev + diff);
+  }
+};
+
+inline unsigned __bit_width(uint64_t v) noexcept {
+  unsigned w = 0;
+  while(v) { ++w; v >>= 1; }
+  return w;
+}
+
+// Branch-free; the payload of every block is padded by one word so reading
+// words[word + 1] is always in bounds.
+inline uint64_t __read_bits(const uint64_t* words, size_t pos, uint64_t mask) noexcept {
+  const size_t word = pos / 64;
+  const unsigned shift = unsigned(pos % 64);
+  const uint64_t v = (words[word] >> shift) | ((words[word + 1] << 1) << (63 - shift));
+  return v & mask;
+}
+
+inline void __write_bits(uint64_t* words, size_t pos, unsigned width, uint64_t v) noexcept {
+  const size_t word = pos / 64;
+  const unsigned shift = unsigned(pos % 64);
+  words[word] |= v << shift;
+  if(shift + width > 64) words[word + 1] |= v >> (64 - shift);
+}
+
+inline uint64_t __next_compressed_storage_id() noexcept {
+  static atomic<uint64_t> next{1};
+  return next.fetch_add(1, memory_order_relaxed);
+}
+
+} // end namespace detail
+
+template <class T>
+class compressed_storage {
+public:
+  static_assert(_MDSPAN_TRAIT(is_arithmetic, T),
+    "std::experimental::compressed_storage requires an arithmetic element type.");
+  static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+    "std::experimental::compressed_storage requires an element type of 1, 2, 4 or 8 bytes (not long double).");
+
+  using value_type = T;
+
+  // Block sizes are powers of two no larger than this, so a decoded block
+  // fits the fixed-size per-thread cache.
+  static constexpr size_t max_block_size = 256;
+
+  compressed_storage() = default;
+
+  compressed_storage(const T* data, size_t count, size_t block_size = 64,
+                     block_encoding encoding = block_encoding::delta)
+    : __size(count), __block_size(block_size), __encoding(encoding),
+      __id(detail::__next_compressed_storage_id())
+  {
+    if(block_size == 0 || block_size > max_block_size || (block_size & (block_size - 1)) != 0) {
+      throw std::invalid_argument("compressed_storage: block size must be a power of two in [1, 256]");
+    }
+    while((size_t(1) << __block_shift) < block_size) ++__block_shift;
+    using traits = detail::__compressed_traits<T>;
+    using uint_t = typename traits::uint_t;
+    const size_t blocks = (count + block_size - 1) / block_size;
+    __blocks.resize(blocks);
+    std::vector<uint_t> residuals(block_size);
+    for(size_t b = 0; b < blocks; ++b) {
+      const size_t first = b * block_size;
+      const size_t n = (count - first) < block_size ? (count - first) : block_size;
+      uint_t prev = traits::__to_uint(data[first], encoding);
+      uint64_t all = 0;
+      for(size_t i = 1; i < n; ++i) {
+        const uint_t cur = traits::__to_uint(data[first + i], encoding);
+        residuals[i] = traits::__residual(prev, cur, encoding);
+        all |= residuals[i];
+        prev = cur;
+      }
+      __block_header& h = __blocks[b];
+      h.first = traits::__to_uint(data[first], encoding);
+      h.width = static_cast<uint8_t>(detail::__bit_width(all));
+      h.word_offset = __words.size();
+      const size_t bits = size_t(h.width) * (n - 1);
+      __words.resize(__words.size() + (bits + 63) / 64 + 1, 0);
+      for(size_t i = 1; i < n; ++i) {
+        detail::__write_bits(__words.data() + h.word_offset, (i - 1) * h.width, h.width, residuals[i]);
+      }
+    }
+    __words.shrink_to_fit();
+  }
+
+  size_t size() const noexcept { return __size; }
+  size_t block_size() const noexcept { return __block_size; }
+  unsigned block_shift() const noexcept { return __block_shift; }
+  size_t block_count() const noexcept { return __blocks.size(); }
+  block_encoding encoding() const noexcept { return __encoding; }
+  uint64_t id() const noexcept { return __id; }
+
+  size_t compressed_bytes() const noexcept {
+    return __words.size() * sizeof(uint64_t) + __blocks.size() * sizeof(__block_header);
+  }
+  double compression_ratio() const noexcept {
+    return compressed_bytes() ? double(__size * sizeof(T)) / double(compressed_bytes()) : 1.0;
+  }
+
+  // Decode block `b` into out[0, block_size) (fewer for the last block).
+  void decode_block(size_t b, T* out) const noexcept {
+    using traits = detail::__compressed_traits<T>;
+    using uint_t = typename traits::uint_t;
+    __block_header const& h = __blocks[b];
+    const size_t first = b * __block_size;
+    const size_t n = (__size - first) < __block_size ? (__size - first) : __block_size;
+    const uint64_t* words = __words.data() + h.word_offset;
+    uint_t prev = uint_t(h.first);
+    out[0] = traits::__from_uint(prev, __encoding);
+    if(h.width == 0) {
+      for(size_t i = 1; i < n; ++i) out[i] = out[0];
+      return;
+    }
+    // Unpack first (independent loads), then run the dependent prefix pass
+    // with the encoding hoisted out of the loop.
+    const uint64_t mask = h.width == 64 ? ~uint64_t(0) : ((uint64_t(1) << h.width) - 1);
+    uint_t r[max_block_size];
+    for(size_t i = 1; i < n; ++i) {
+      r[i] = uint_t(detail::__read_bits(words, (i - 1) * h.width, mask));
+    }
+    if(__encoding == block_encoding::xor_previous) {
+      for(size_t i = 1; i < n; ++i) {
+        prev = traits::__apply_residual(prev, r[i], block_encoding::xor_previous);
+        out[i] = traits::__from_uint(prev, block_encoding::xor_previous);
+      }
+    }
+    else {
+      for(size_t i = 1; i < n; ++i) {
+        prev = traits::__apply_residual(prev, r[i], block_encoding::delta);
+        out[i] = traits::__from_uint(prev, block_encoding::delta);
+      }
+    }
+  }
+
+  // Decode element i on its own (no cache); mostly useful for testing.
+  T load(size_t i) const {
+    T block[max_block_size];
+    decode_block(i >> __block_shift, block);
+    return block[i & (__block_size - 1)];
+  }
+
+private:
+  struct __block_header {
+    uint64_t first;
+    size_t word_offset;
+    uint8_t width;
+  };
+
+  size_t __size = 0;
+  size_t __block_size = 64;
+  unsigned __block_shift = 0;
+  block_encoding __encoding = block_encoding::delta;
+  uint64_t __id = 0;
+  std::vector<__block_header> __blocks;
+  std::vector<uint64_t> __words;
+};
+
+template <class T>
+struct compressed_pointer {
+  const compressed_storage<T>* storage = nullptr;
+  size_t offset = 0;
+
+  compressed_pointer() noexcept = default;
+  compressed_pointer(const compressed_storage<T>* s, size_t off = 0) noexcept // NOLINT(google-explicit-constructor)
+    : storage(s), offset(off)
+  { }
+};
+
+namespace detail {
+
+// A tiny direct-mapped cache of decoded blocks, one per thread and element
+// type.  Entries are tagged with the storage id, which is never reused (and
+// never 0), so a destroyed storage can't produce stale hits.  The cache is
+// trivially constructible so the thread_local needs no init guard.
+template <class T>
+struct __decoded_block_cache {
+  static constexpr size_t __entries = 8;
+  struct __entry {
+    uint64_t storage_id;
+    size_t block;
+    T values[compressed_storage<T>::max_block_size];
+  };
+  __entry entries[__entries];
+
+  static __decoded_block_cache& __instance() noexcept {
+    static thread_local __decoded_block_cache cache;
+    return cache;
+  }
+
+  const T* __lookup(compressed_storage<T> const& s, size_t block) noexcept {
+    __entry& e = entries[block % __entries];
+    if(e.storage_id != s.id() || e.block != block) __fill(e, s, block);
+    return e.values;
+  }
+
+#if defined(__GNUC__)
+  __attribute__((noinline))
+#endif
+  static void __fill(__entry& e, compressed_storage<T> const& s, size_t block) noexcept {
+    s.decode_block(block, e.values);
+    e.storage_id = s.id();
+    e.block = block;
+  }
+};
+
+} // end namespace detail
+
+template <class T>
+struct compressed_accessor {
+  using offset_policy = compressed_accessor;
+  using element_type = const T;
+  using reference = T;
+  using pointer = compressed_pointer<T>;
+
+  compressed_accessor() noexcept = default;
+
+  pointer offset(pointer p, size_t i) const noexcept {
+    return pointer(p.storage, p.offset + i);
+  }
+
+  reference access(pointer p, size_t i) const noexcept {
+    const size_t idx = p.offset + i;
+    compressed_storage<T> const& s = *p.storage;
+    return detail::__decoded_block_cache<T>::__instance()
+      .__lookup(s, idx >> s.block_shift())[idx & (s.block_size() - 1)];
+  }
+};
+
+template <class T, class Extents, class LayoutPolicy = layout_right>
+using compressed_mdspan = mdspan<const T, Extents, LayoutPolicy, compressed_accessor<T>>;
+
+// Compress the elements of a contiguous mdspan (in its mapping's codomain
+// order) and return storage suitable for a compressed_mdspan with the same
+// mapping.
+template <class T, class Extents, class Layout, class Accessor>
+compressed_storage<remove_const_t<T>>
+compress(mdspan<T, Extents, Layout, Accessor> const& m, size_t block_size = 64,
+         block_encoding encoding = block_encoding::delta)
+{
+  static_assert(_MDSPAN_TRAIT(is_same, Accessor, default_accessor<T>),
+    "std::experimental::compress requires an mdspan with default_accessor.");
+  if(!m.is_contiguous()) throw std::invalid_argument("compress: mdspan must be contiguous");
+  return compressed_storage<remove_const_t<T>>(m.data(), m.mapping().required_span_size(), block_size, encoding);
+}
+
+template <class T, class Mapping>
+mdspan<const T, typename Mapping::extents_type, typename Mapping::layout_type, compressed_accessor<T>>
+make_compressed_mdspan(compressed_storage<T> const& storage, Mapping const& map) {
+  if(map.required_span_size() > storage.size()) {
+    throw std::invalid_argument("make_compressed_mdspan: storage is smaller than the mapping");
+  }
+  return mdspan<const T, typename Mapping::extents_type, typename Mapping::layout_type, compressed_accessor<T>>(
+    compressed_pointer<T>(&storage), map
+  );
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,423 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+
+#include <algorithm> // fill
+#include <atomic>
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t, uint64_t
+#include <memory> // addressof, unique_ptr
+#include <mutex>
+#include <stdexcept> // invalid_argument
+#include <thread>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// counting_accessor: instrumentation wrapper that records reads, writes and
+// the touched address range of every element access through a view.
+//
+// Counts are accumulated in per-thread slots (one cache line each, so that
+// counting threads do not false-share) owned by an access_counters object and
+// merged when summary() or trace() is called.  Those two calls must not race
+// with threads that are still accessing through a counting view.
+
+struct access_trace_entry {
+  uintptr_t address;
+  uint32_t bytes;
+  bool is_write;
+};
+
+struct access_summary {
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+  uint64_t bytes_read = 0;
+  uint64_t bytes_written = 0;
+  // Half-open range [min_address, max_address) of all recorded accesses.
+  uintptr_t min_address = ~uintptr_t(0);
+  uintptr_t max_address = 0;
+
+  uint64_t accesses() const noexcept { return reads + writes; }
+  uint64_t bytes_accessed() const noexcept { return bytes_read + bytes_written; }
+  size_t address_range_bytes() const noexcept {
+    return max_address > min_address ? size_t(max_address - min_address) : 0;
+  }
+};
+
+//==============================================================================
+// cache_simulator: set-associative cache with LRU replacement, for replaying
+// access traces and comparing layouts before running on real hardware.
+
+class cache_simulator {
+public:
+
+  explicit cache_simulator(size_t capacity_bytes = 32 * 1024, size_t line_bytes = 64, size_t associativity = 8)
+    : __line_bytes(line_bytes), __ways(associativity)
+  {
+    if(line_bytes == 0 || (line_bytes & (line_bytes - 1)) != 0)
+      throw std::invalid_argument("cache_simulator: line size must be a power of two");
+    if(associativity == 0 || capacity_bytes % (line_bytes * associativity) != 0)
+      throw std::invalid_argument("cache_simulator: capacity must be a multiple of line size times associativity");
+    __sets = capacity_bytes / (line_bytes * associativity);
+    if(__sets == 0)
+      throw std::invalid_argument("cache_simulator: capacity too small for one set");
+    __tags.assign(__sets * __ways, __invalid_tag());
+    __last_use.assign(__sets * __ways, 0);
+  }
+
+  // Touch every line overlapping [address, address + bytes).
+  void access(uintptr_t address, size_t bytes = 1) {
+    const uintptr_t first = address / __line_bytes;
+    const uintptr_t last = (address + (bytes ? bytes : 1) - 1) / __line_bytes;
+    for(uintptr_t line = first; line <= last; ++line) {
+      __access_line(line);
+    }
+  }
+
+  void replay(std::vector<access_trace_entry> const& trace) {
+    for(auto const& e : trace) access(e.address, e.bytes);
+  }
+
+  void reset() {
+    std::fill(__tags.begin(), __tags.end(), __invalid_tag());
+    std::fill(__last_use.begin(), __last_use.end(), uint64_t(0));
+    __clock = 0;
+    __hits = 0;
+    __misses = 0;
+  }
+
+  uint64_t hits() const noexcept { return __hits; }
+  uint64_t misses() const noexcept { return __misses; }
+  double miss_rate() const noexcept {
+    return __hits + __misses ? double(__misses) / double(__hits + __misses) : 0.0;
+  }
+  size_t sets() const noexcept { return __sets; }
+  size_t associativity() const noexcept { return __ways; }
+  size_t line_bytes() const noexcept { return __line_bytes; }
+
+private:
+
+  static constexpr uintptr_t __invalid_tag() noexcept { return ~uintptr_t(0); }
+
+  void __access_line(uintptr_t line) {
+    const size_t set = size_t(line % __sets);
+    uintptr_t* tags = __tags.data() + set * __ways;
+    uint64_t* last_use = __last_use.data() + set * __ways;
+    ++__clock;
+    size_t victim = 0;
+    for(size_t w = 0; w < __ways; ++w) {
+      if(tags[w] == line) {
+        last_use[w] = __clock;
+        ++__hits;
+        return;
+      }
+      if(last_use[w] < last_use[victim]) victim = w;
+    }
+    ++__misses;
+    tags[victim] = line;
+    last_use[victim] = __clock;
+  }
+
+  size_t __line_bytes;
+  size_t __ways;
+  size_t __sets = 0;
+  std::vector<uintptr_t> __tags;
+  std::vector<uint64_t> __last_use;
+  uint64_t __clock = 0;
+  uint64_t __hits = 0;
+  uint64_t __misses = 0;
+};
+
+namespace detail {
+
+struct __access_counter_slot {
+  access_summary summary;
+  std::vector<access_trace_entry> trace;
+  size_t trace_next = 0;
+  bool trace_wrapped = false;
+  thread::id owner;
+  // Slots are allocated separately; the padding keeps two threads' counters
+  // off the same cache line.
+  char __padding[64];
+
+  void __record(uintptr_t address, uint32_t bytes, bool is_write) noexcept {
+    if(is_write) { ++summary.writes; summary.bytes_written += bytes; }
+    else { ++summary.reads; summary.bytes_read += bytes; }
+    if(address != 0) {
+      if(address < summary.min_address) summary.min_address = address;
+      if(address + bytes > summary.max_address) summary.max_address = address + bytes;
+    }
+    if(!trace.empty()) {
+      trace[trace_next] = access_trace_entry{address, bytes, is_write};
+      if(++trace_next == trace.size()) { trace_next = 0; trace_wrapped = true; }
+    }
+  }
+
+  void __clear() noexcept {
+    summary = access_summary{};
+    trace_next = 0;
+    trace_wrapped = false;
+  }
+};
+
+} // end namespace detail
+
+class access_counters {
+public:
+
+  // If trace_capacity is nonzero every thread also keeps a ring buffer of its
+  // last trace_capacity accesses.
+  explicit access_counters(size_t trace_capacity = 0)
+    : __trace_capacity(trace_capacity), __id(__next_id())
+  { }
+
+  access_counters(access_counters const&) = delete;
+  access_counters& operator=(access_counters const&) = delete;
+
+  size_t trace_capacity() const noexcept { return __trace_capacity; }
+
+  // Additionally feed every recorded access straight into `sim` (pass nullptr
+  // to detach).  The simulator is not synchronized, so only attach one while
+  // a single thread accesses through the counting views.
+  void simulate(cache_simulator* sim) noexcept { __simulator = sim; }
+
+  access_summary summary() const {
+    lock_guard<mutex> lock(__mutex);
+    access_summary result;
+    for(auto const& s : __slots) {
+      result.reads += s->summary.reads;
+      result.writes += s->summary.writes;
+      result.bytes_read += s->summary.bytes_read;
+      result.bytes_written += s->summary.bytes_written;
+      if(s->summary.min_address < result.min_address) result.min_address = s->summary.min_address;
+      if(s->summary.max_address > result.max_address) result.max_address = s->summary.max_address;
+    }
+    return result;
+  }
+
+  // The traced accesses of each thread in chronological order, one thread
+  // after the other.
+  std::vector<access_trace_entry> trace() const {
+    lock_guard<mutex> lock(__mutex);
+    std::vector<access_trace_entry> result;
+    for(auto const& s : __slots) {
+      if(s->trace_wrapped) {
+        result.insert(result.end(), s->trace.begin() + s->trace_next, s->trace.end());
+      }
+      result.insert(result.end(), s->trace.begin(), s->trace.begin() + s->trace_next);
+    }
+    return result;
+  }
+
+  void reset() {
+    lock_guard<mutex> lock(__mutex);
+    for(auto& s : __slots) s->__clear();
+  }
+
+  // Called on every counted access; the common case is a hit in a small
+  // thread_local cache and takes no lock.
+  detail::__access_counter_slot& __local_slot() {
+    struct __cache_entry { uint64_t id; detail::__access_counter_slot* slot; };
+    static thread_local __cache_entry cache[4] = { };
+    __cache_entry& entry = cache[__id % 4];
+    if(entry.id != __id) {
+      entry.slot = &__find_or_create_slot();
+      entry.id = __id;
+    }
+    return *entry.slot;
+  }
+
+  void __record(uintptr_t address, uint32_t bytes, bool is_write) {
+    __local_slot().__record(address, bytes, is_write);
+    if(__simulator != nullptr && address != 0) __simulator->access(address, bytes);
+  }
+
+private:
+
+  static uint64_t __next_id() noexcept {
+    static atomic<uint64_t> next{1};
+    return next.fetch_add(1, memory_order_relaxed);
+  }
+
+  detail::__access_counter_slot& __find_or_create_slot() {
+    lock_guard<mutex> lock(__mutex);
+    auto const self = this_thread::get_id();
+    for(auto& s : __slots) {
+      if(s->owner == self) return *s;
+    }
+    __slots.emplace_back(new detail::__access_counter_slot());
+    __slots.back()->owner = self;
+    __slots.back()->trace.resize(__trace_capacity);
+    return *__slots.back();
+  }
+
+  size_t __trace_capacity;
+  uint64_t __id;
+  cache_simulator* __simulator = nullptr;
+  mutable mutex __mutex;
+  std::vector<unique_ptr<detail::__access_counter_slot>> __slots;
+};
+
+namespace detail {
+
+template <class Reference>
+inline uintptr_t __address_of_reference(Reference&& r, true_type) noexcept {
+  return reinterpret_cast<uintptr_t>(std::addressof(r));
+}
+
+// Proxy references have no address; only counts are recorded for them.
+template <class Reference>
+inline uintptr_t __address_of_reference(Reference&&, false_type) noexcept {
+  return 0;
+}
+
+} // end namespace detail
+
+template <class InnerAccessor>
+class counted_reference {
+public:
+  using inner_reference = typename InnerAccessor::reference;
+  using value_type = remove_cv_t<typename InnerAccessor::element_type>;
+
+  counted_reference(inner_reference r, access_counters* c) noexcept
+    : __ref(r), __counters(c)
+  { }
+
+  counted_reference(counted_reference const&) = default;
+
+  operator value_type() const { // NOLINT(google-explicit-constructor)
+    __record(false);
+    return __ref;
+  }
+
+  counted_reference const& operator=(value_type const& v) const {
+    __record(true);
+    __ref = v;
+    return *this;
+  }
+
+  counted_reference const& operator=(counted_reference const& other) const {
+    return *this = value_type(other);
+  }
+
+  counted_reference const& operator+=(value_type const& v) const { return *this = value_type(*this) + v; }
+  counted_reference const& operator-=(value_type const& v) const { return *this = value_type(*this) - v; }
+  counted_reference const& operator*=(value_type const& v) const { return *this = value_type(*this) * v; }
+  counted_reference const& operator/=(value_type const& v) const { return *this = value_type(*this) / v; }
+
+private:
+
+  void __record(bool is_write) const {
+    if(__counters == nullptr) return;
+    __counters->__record(
+      detail::__address_of_reference(__ref, integral_constant<bool, _MDSPAN_TRAIT(is_lvalue_reference, inner_reference)>{}),
+      uint32_t(sizeof(value_type)), is_write
+    );
+  }
+
+  inner_reference __ref;
+  access_counters* __counters;
+};
+
+template <class InnerAccessor>
+class counting_accessor {
+public:
+  using offset_policy = counting_accessor<typename InnerAccessor::offset_policy>;
+  using element_type = typename InnerAccessor::element_type;
+  using reference = counted_reference<InnerAccessor>;
+  using pointer = typename InnerAccessor::pointer;
+  using inner_accessor_type = InnerAccessor;
+
+  // A default-constructed counting_accessor has no counters and forwards
+  // accesses without recording them.
+  counting_accessor() = default;
+
+  explicit counting_accessor(access_counters& c, InnerAccessor const& inner = InnerAccessor())
+    : __inner(inner), __counters(&c)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherInnerAccessor,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_constructible, InnerAccessor, OtherInnerAccessor const&)
+    )
+  )
+  counting_accessor(counting_accessor<OtherInnerAccessor> const& other) // NOLINT(google-explicit-constructor)
+    : __inner(other.inner_accessor()), __counters(other.counters())
+  { }
+
+  typename offset_policy::pointer offset(pointer p, size_t i) const {
+    return __inner.offset(p, i);
+  }
+
+  reference access(pointer p, size_t i) const {
+    return reference(__inner.access(p, i), __counters);
+  }
+
+  InnerAccessor inner_accessor() const { return __inner; }
+  access_counters* counters() const noexcept { return __counters; }
+
+private:
+  InnerAccessor __inner = InnerAccessor();
+  access_counters* __counters = nullptr;
+};
+
+// Wrap an existing mdspan so every access through the result is counted.
+template <class ElementType, class Extents, class Layout, class Accessor>
+mdspan<ElementType, Extents, Layout, counting_accessor<Accessor>>
+make_counting_mdspan(mdspan<ElementType, Extents, Layout, Accessor> const& m, access_counters& c) {
+  return mdspan<ElementType, Extents, Layout, counting_accessor<Accessor>>(
+    m.data(), m.mapping(), counting_accessor<Accessor>(c, m.accessor())
+  );
+}
+
+} // end namespace experimental
+} // end namespace std
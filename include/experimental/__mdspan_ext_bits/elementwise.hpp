@@ -0,0 +1,403 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/bounds_check.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "parallel_algorithms.hpp"
+
+#include <cstddef> // size_t
+#include <type_traits>
+#include <utility> // declval, index_sequence
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// Lazy elementwise expressions over mdspans, evaluated in one fused loop:
+//
+//   assign(o, elementwise(o) + s);                       // o += s
+//   assign(execution::par, o, a + elementwise(b) * c - 2.0 * elementwise(o));
+//   assign(y, elementwise_map(f, x) + elementwise_cast<double>(n));
+//
+// elementwise(m) starts an expression from an mdspan.  The arithmetic
+// operators + - * / (and unary -) combine an expression with another
+// expression, an mdspan or a scalar (one operand must be an expression, so
+// plain mdspans keep their meaning), and only build a small tree of views;
+// nothing is read until assign(dst, e), which walks dst with the layout-aware
+// for_each_index engine of the parallel algorithms (stride-1 dimension
+// innermost, line-aligned slabs under par / par_unseq) and computes every
+// element of dst from the same element of each operand.  A chain of updates
+// thus touches each array once instead of once per step.
+//
+// The extents of an expression combine those of its operands: a dimension is
+// static if it is static in any of them (operands must have equal extents,
+// checked under MDSPAN_CHECK_BOUNDS, and scalars broadcast).  dst may itself
+// appear in the expression, since element i of dst is read only to compute
+// element i; it must not overlap other operands in any other way.
+
+namespace detail {
+
+template <class T>
+struct __is_elementwise : false_type { };
+
+//------------------------------------------------------------------------------
+// Extents of a combination of two operands.  Rank 0 is a broadcast scalar.
+
+template <class E1, class E2, class = make_index_sequence<E1::rank()>>
+struct __elementwise_merged_extents;
+
+template <class E1, class E2, size_t... Is>
+struct __elementwise_merged_extents<E1, E2, index_sequence<Is...>> {
+  using type = experimental::extents<(E1::static_extent(Is) != dynamic_extent ? E1::static_extent(Is) : E2::static_extent(Is))...>;
+
+  // Each extent from the operand that makes it static, if any.
+  MDSPAN_INLINE_FUNCTION
+  static constexpr type __apply(E1 const& e1, E2 const& e2) {
+    return type((E1::static_extent(Is) != dynamic_extent ? e1.extent(Is) : e2.extent(Is))...);
+  }
+};
+
+template <class E1, class E2, bool = E1::rank() == 0, bool = E2::rank() == 0>
+struct __elementwise_extents : __elementwise_merged_extents<E1, E2> {
+  static_assert(E1::rank() == E2::rank() && __static_extents_match<E1, E2>(),
+    "std::experimental::elementwise operands must have the same rank and matching static extents.");
+};
+
+template <class E1, class E2, bool Scalar2>
+struct __elementwise_extents<E1, E2, true, Scalar2> {
+  using type = E2;
+  MDSPAN_INLINE_FUNCTION
+  static constexpr type __apply(E1 const&, E2 const& e2) { return e2; }
+};
+
+template <class E1, class E2>
+struct __elementwise_extents<E1, E2, false, true> {
+  using type = E1;
+  MDSPAN_INLINE_FUNCTION
+  static constexpr type __apply(E1 const& e1, E2 const&) { return e1; }
+};
+
+#if MDSPAN_CHECK_BOUNDS
+template <class E1, class E2>
+void __elementwise_check_extents(const char* what, E1 const& e1, E2 const& e2, false_type /* scalar */) noexcept {
+  _MDSPAN_CHECK_EXTENTS(what, e1, e2);
+}
+
+template <class E1, class E2>
+void __elementwise_check_extents(const char*, E1 const&, E2 const&, true_type /* scalar */) noexcept { }
+#endif
+
+//------------------------------------------------------------------------------
+// Expression nodes.  Each has extents_type, value_type, extents() and
+// operator()(i0, ..., iN-1) returning the element at that index.
+
+template <class MDSpan>
+class __elementwise_leaf {
+public:
+  using extents_type = typename MDSpan::extents_type;
+  using value_type = typename MDSpan::value_type;
+
+  MDSPAN_INLINE_FUNCTION
+  explicit __elementwise_leaf(MDSpan const& m) : __m(m), __acc(m.accessor()) { }
+
+  MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __m.extents(); }
+
+  template <class... Indices>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  typename MDSpan::accessor_type::reference operator()(Indices... idxs) const {
+    return __acc.access(__m.data(), __m.mapping()(idxs...));
+  }
+
+private:
+  MDSpan __m;
+  typename MDSpan::accessor_type __acc;
+};
+
+template <class T>
+class __elementwise_scalar {
+public:
+  using extents_type = experimental::extents<>;
+  using value_type = T;
+
+  MDSPAN_INLINE_FUNCTION
+  explicit __elementwise_scalar(T const& value) : __value(value) { }
+
+  MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return extents_type(); }
+
+  template <class... Indices>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  T const& operator()(Indices...) const noexcept { return __value; }
+
+private:
+  T __value;
+};
+
+template <class F, class E>
+class __elementwise_unary {
+public:
+  using extents_type = typename E::extents_type;
+  using value_type = decay_t<decltype(declval<F const&>()(declval<typename E::value_type>()))>;
+
+  MDSPAN_INLINE_FUNCTION
+  __elementwise_unary(F const& f, E const& e) : __f(f), __e(e) { }
+
+  MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __e.extents(); }
+
+  template <class... Indices>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  value_type operator()(Indices... idxs) const { return __f(__e(idxs...)); }
+
+private:
+  F __f;
+  E __e;
+};
+
+template <class F, class L, class R>
+class __elementwise_binary {
+  using __extents = __elementwise_extents<typename L::extents_type, typename R::extents_type>;
+
+public:
+  using extents_type = typename __extents::type;
+  using value_type = decay_t<decltype(declval<F const&>()(declval<typename L::value_type>(), declval<typename R::value_type>()))>;
+
+  MDSPAN_INLINE_FUNCTION
+  __elementwise_binary(F const& f, L const& l, R const& r) : __f(f), __l(l), __r(r) {
+#if MDSPAN_CHECK_BOUNDS
+    __elementwise_check_extents("elementwise", __l.extents(), __r.extents(),
+      integral_constant<bool, L::extents_type::rank() == 0 || R::extents_type::rank() == 0>());
+#endif
+  }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr extents_type extents() const noexcept { return __extents::__apply(__l.extents(), __r.extents()); }
+
+  template <class... Indices>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  value_type operator()(Indices... idxs) const { return __f(__l(idxs...), __r(idxs...)); }
+
+private:
+  F __f;
+  L __l;
+  R __r;
+};
+
+template <class MDSpan> struct __is_elementwise<__elementwise_leaf<MDSpan>> : true_type { };
+template <class T> struct __is_elementwise<__elementwise_scalar<T>> : true_type { };
+template <class F, class E> struct __is_elementwise<__elementwise_unary<F, E>> : true_type { };
+template <class F, class L, class R> struct __is_elementwise<__elementwise_binary<F, L, R>> : true_type { };
+
+//------------------------------------------------------------------------------
+// Operands: an expression as is, an mdspan as a leaf, anything else as a
+// scalar.
+
+template <class E>
+MDSPAN_INLINE_FUNCTION
+E const& __as_elementwise(E const& e, integral_constant<int, 0> /* expression */) { return e; }
+
+template <class MDSpan>
+MDSPAN_INLINE_FUNCTION
+__elementwise_leaf<MDSpan> __as_elementwise(MDSpan const& m, integral_constant<int, 1> /* mdspan */) {
+  return __elementwise_leaf<MDSpan>(m);
+}
+
+template <class T>
+MDSPAN_INLINE_FUNCTION
+__elementwise_scalar<T> __as_elementwise(T const& t, integral_constant<int, 2> /* scalar */) {
+  return __elementwise_scalar<T>(t);
+}
+
+template <class X>
+using __elementwise_kind = integral_constant<int,
+  __is_elementwise<X>::value ? 0 : __is_mdspan<X>::value ? 1 : 2>;
+
+template <class X>
+using __elementwise_t = decay_t<decltype(__as_elementwise(declval<X const&>(), __elementwise_kind<X>()))>;
+
+template <class X>
+MDSPAN_INLINE_FUNCTION
+__elementwise_t<X> __to_elementwise(X const& x) { return __as_elementwise(x, __elementwise_kind<X>()); }
+
+struct __elementwise_plus {
+  template <class A, class B>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  auto operator()(A const& a, B const& b) const -> decltype(a + b) { return a + b; }
+};
+
+struct __elementwise_minus {
+  template <class A, class B>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  auto operator()(A const& a, B const& b) const -> decltype(a - b) { return a - b; }
+};
+
+struct __elementwise_multiplies {
+  template <class A, class B>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  auto operator()(A const& a, B const& b) const -> decltype(a * b) { return a * b; }
+};
+
+struct __elementwise_divides {
+  template <class A, class B>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  auto operator()(A const& a, B const& b) const -> decltype(a / b) { return a / b; }
+};
+
+struct __elementwise_negate {
+  template <class A>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  auto operator()(A const& a) const -> decltype(-a) { return -a; }
+};
+
+template <class U>
+struct __elementwise_cast {
+  template <class A>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  U operator()(A const& a) const { return static_cast<U>(a); }
+};
+
+// Operators on expressions; found by argument-dependent lookup from the node
+// types above, and only when at least one operand is an expression.
+template <class L, class R>
+struct __elementwise_operands : integral_constant<bool, __is_elementwise<L>::value || __is_elementwise<R>::value> { };
+
+#define _MDSPAN_ELEMENTWISE_OPERATOR(OP, F) \
+  MDSPAN_TEMPLATE_REQUIRES( \
+    class L, class R, \
+    /* requires */ (__elementwise_operands<L, R>::value) \
+  ) \
+  MDSPAN_INLINE_FUNCTION \
+  __elementwise_binary<F, __elementwise_t<L>, __elementwise_t<R>> operator OP(L const& l, R const& r) { \
+    return __elementwise_binary<F, __elementwise_t<L>, __elementwise_t<R>>(F(), __to_elementwise(l), __to_elementwise(r)); \
+  }
+
+_MDSPAN_ELEMENTWISE_OPERATOR(+, __elementwise_plus)
+_MDSPAN_ELEMENTWISE_OPERATOR(-, __elementwise_minus)
+_MDSPAN_ELEMENTWISE_OPERATOR(*, __elementwise_multiplies)
+_MDSPAN_ELEMENTWISE_OPERATOR(/, __elementwise_divides)
+
+#undef _MDSPAN_ELEMENTWISE_OPERATOR
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class E,
+  /* requires */ (__is_elementwise<E>::value)
+)
+MDSPAN_INLINE_FUNCTION
+__elementwise_unary<__elementwise_negate, E> operator-(E const& e) {
+  return __elementwise_unary<__elementwise_negate, E>(__elementwise_negate(), e);
+}
+
+template <class Policy, class MDSpan, class E>
+void __assign(Policy const& policy, MDSpan const& dst, E const& e) {
+  static_assert(E::extents_type::rank() == 0 ||
+    (E::extents_type::rank() == MDSpan::extents_type::rank() &&
+     __static_extents_match<typename MDSpan::extents_type, typename E::extents_type>()),
+    "std::experimental::assign requires an expression with the extents of the destination.");
+#if MDSPAN_CHECK_BOUNDS
+  __elementwise_check_extents("assign", dst.extents(), e.extents(),
+    integral_constant<bool, E::extents_type::rank() == 0>());
+#endif
+  const auto acc = dst.accessor();
+  auto body = [&](auto... idxs) { __element(dst, acc, idxs...) = e(idxs...); };
+  __for_each_index_policy(policy, dst.mapping(), sizeof(typename MDSpan::element_type), body);
+}
+
+} // end namespace detail
+
+// m as an elementwise expression (see above).
+MDSPAN_TEMPLATE_REQUIRES(
+  class MDSpan,
+  /* requires */ (detail::__is_mdspan<MDSpan>::value)
+)
+MDSPAN_INLINE_FUNCTION
+detail::__elementwise_leaf<MDSpan> elementwise(MDSpan const& m) {
+  return detail::__elementwise_leaf<MDSpan>(m);
+}
+
+// f(e[i]) for every element of an expression or mdspan e.
+template <class F, class E>
+MDSPAN_INLINE_FUNCTION
+detail::__elementwise_unary<F, detail::__elementwise_t<E>> elementwise_map(F const& f, E const& e) {
+  return detail::__elementwise_unary<F, detail::__elementwise_t<E>>(f, detail::__to_elementwise(e));
+}
+
+// f(e1[i], e2[i]) for every element of two expressions, mdspans or scalars.
+template <class F, class E1, class E2>
+MDSPAN_INLINE_FUNCTION
+detail::__elementwise_binary<F, detail::__elementwise_t<E1>, detail::__elementwise_t<E2>>
+elementwise_map(F const& f, E1 const& e1, E2 const& e2) {
+  return detail::__elementwise_binary<F, detail::__elementwise_t<E1>, detail::__elementwise_t<E2>>(
+    f, detail::__to_elementwise(e1), detail::__to_elementwise(e2));
+}
+
+// static_cast<U>(e[i]) for every element of an expression or mdspan e.
+template <class U, class E>
+MDSPAN_INLINE_FUNCTION
+detail::__elementwise_unary<detail::__elementwise_cast<U>, detail::__elementwise_t<E>> elementwise_cast(E const& e) {
+  return elementwise_map(detail::__elementwise_cast<U>(), e);
+}
+
+// dst[i] = e[i] for every index of dst, in one pass.  e is an expression, an
+// mdspan or a scalar.
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan, class E,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value)
+)
+void assign(ExecutionPolicy const& policy, MDSpan const& dst, E const& e) {
+  detail::__assign(policy, dst, detail::__to_elementwise(e));
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class MDSpan, class E,
+  /* requires */ (detail::__is_mdspan<MDSpan>::value)
+)
+void assign(MDSpan const& dst, E const& e) {
+  detail::__assign(execution::seq, dst, detail::__to_elementwise(e));
+}
+
+} // end namespace experimental
+} // end namespace std
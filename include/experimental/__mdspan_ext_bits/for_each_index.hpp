@@ -0,0 +1,431 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/layout_stride.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+
+#include <array>
+#include <cstddef> // size_t
+#include <type_traits>
+#include <utility> // index_sequence
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// for_each_index: visit every multi-index of an index space, calling
+// f(i0, i1, ..., iN-1) with size_t indices.
+//
+//   for_each_index(exts, f)     row-major order (last index innermost)
+//   for_each_index(mapping, f)  innermost loop on the stride-1 dimension:
+//   for_each_index(m, f)        the last for layout_right, the first for
+//                               layout_left, and the smallest stride for any
+//                               other strided mapping (chosen at run time)
+//
+// The loop nest is generated at compile time, one level per rank, with no
+// submdspan in between; static extents of at most
+// __for_each_index_unroll_limit are unrolled outright so the body sees
+// constant indices.
+
+namespace detail {
+
+_MDSPAN_INLINE_VARIABLE constexpr size_t __for_each_index_unroll_limit = 8;
+
+template <class T, size_t N>
+struct __index_array {
+  T __values[N == 0 ? 1 : N];
+  MDSPAN_FORCE_INLINE_FUNCTION constexpr T const& operator[](size_t i) const noexcept { return __values[i]; }
+  MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14 T& operator[](size_t i) noexcept { return __values[i]; }
+};
+
+template <size_t I, size_t... Ns>
+struct __pack_element;
+template <size_t N0, size_t... Ns>
+struct __pack_element<0, N0, Ns...> : integral_constant<size_t, N0> { };
+template <size_t I, size_t N0, size_t... Ns>
+struct __pack_element<I, N0, Ns...> : __pack_element<I - 1, Ns...> { };
+
+template <size_t... Is>
+using __reverse_index_sequence_helper = index_sequence<(sizeof...(Is) - 1 - Is)...>;
+
+template <class Seq>
+struct __reverse_index_sequence;
+template <size_t... Is>
+struct __reverse_index_sequence<index_sequence<Is...>> {
+  using type = __reverse_index_sequence_helper<Is...>;
+};
+
+// Loop order per layout, outermost dimension first.  void means "decide at
+// run time from the strides".
+template <class Layout, size_t Rank>
+struct __layout_loop_order { using type = void; };
+template <size_t Rank>
+struct __layout_loop_order<layout_right, Rank> { using type = make_index_sequence<Rank>; };
+template <size_t Rank>
+struct __layout_loop_order<layout_left, Rank> { using type = typename __reverse_index_sequence<make_index_sequence<Rank>>::type; };
+
+template <class Order, size_t Level, size_t Rank = Order::size()>
+struct __index_nest;
+
+// Leaf: all indices set, call the body.
+template <size_t... Order, size_t Rank>
+struct __index_nest<index_sequence<Order...>, Rank, Rank> {
+  template <class Extents, class F, size_t... Is>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __call(F& f, __index_array<size_t, Rank> const& idx, index_sequence<Is...>) {
+    f(idx[Is]...);
+  }
+
+  template <class Extents, class F>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __apply(Extents const&, F& f, __index_array<size_t, Rank>& idx) {
+    __call<Extents>(f, idx, make_index_sequence<Rank>());
+  }
+};
+
+template <size_t... Order, size_t Level, size_t Rank>
+struct __index_nest<index_sequence<Order...>, Level, Rank> {
+  static constexpr size_t __dim = __pack_element<Level, Order...>::value;
+  using __next = __index_nest<index_sequence<Order...>, Level + 1, Rank>;
+
+  template <class Extents, class F, size_t... Is>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __unrolled(Extents const& exts, F& f, __index_array<size_t, Rank>& idx, index_sequence<Is...>) {
+    // braced list: evaluated left to right, unlike a C++14 comma "fold"
+    int __ignored[] = {0, ((idx[__dim] = Is), __next::__apply(exts, f, idx), 0)...};
+    (void)__ignored;
+  }
+
+  template <class Extents, class F>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __loop(Extents const& exts, F& f, __index_array<size_t, Rank>& idx, true_type /* unroll */) {
+    __unrolled(exts, f, idx, make_index_sequence<Extents::static_extent(__dim)>());
+  }
+
+  template <class Extents, class F>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __loop(Extents const& exts, F& f, __index_array<size_t, Rank>& idx, false_type /* unroll */) {
+    const size_t n = exts.extent(__dim);
+    for(size_t i = 0; i < n; ++i) {
+      idx[__dim] = i;
+      __next::__apply(exts, f, idx);
+    }
+  }
+
+  template <class Extents, class F>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __apply(Extents const& exts, F& f, __index_array<size_t, Rank>& idx) {
+    __loop(exts, f, idx, integral_constant<bool,
+      Extents::static_extent(__dim) != dynamic_extent &&
+      Extents::static_extent(__dim) <= __for_each_index_unroll_limit
+    >());
+  }
+};
+
+template <class Order, class Extents, class F>
+MDSPAN_INLINE_FUNCTION
+void __for_each_index_ordered(Extents const& exts, F& f) {
+  __index_array<size_t, Extents::rank()> idx{};
+  __index_nest<Order, 0>::__apply(exts, f, idx);
+}
+
+// Run-time order for other strided mappings: an odometer over the dimensions
+// sorted by decreasing stride, with a tight innermost loop.
+template <class Mapping, class F, size_t... Is>
+void __for_each_index_strided(Mapping const& map, F& f, index_sequence<Is...>) {
+  constexpr size_t rank = sizeof...(Is);
+  auto const exts = map.extents();
+  __index_array<size_t, rank> perm{{Is...}};
+  for(size_t a = 1; a < rank; ++a) {
+    for(size_t b = a; b > 0 && map.stride(perm[b - 1]) < map.stride(perm[b]); --b) {
+      const size_t t = perm[b]; perm[b] = perm[b - 1]; perm[b - 1] = t;
+    }
+  }
+  for(size_t r = 0; r < rank; ++r) if(exts.extent(r) == 0) return;
+  __index_array<size_t, rank> idx{};
+  const size_t inner = perm[rank - 1];
+  const size_t n = exts.extent(inner);
+  while(true) {
+    for(size_t i = 0; i < n; ++i) {
+      idx[inner] = i;
+      f(idx[Is]...);
+    }
+    size_t level = rank - 1;
+    while(level-- > 0) {
+      const size_t d = perm[level];
+      if(++idx[d] < exts.extent(d)) break;
+      idx[d] = 0;
+    }
+    if(level == size_t(-1)) return;
+  }
+}
+
+template <class Mapping, class F>
+void __for_each_index_runtime_order(Mapping const& map, F& f, true_type /* rank > 1 */) {
+  if(map.is_strided()) {
+    __for_each_index_strided(map, f, make_index_sequence<Mapping::extents_type::rank()>());
+  }
+  else {
+    __for_each_index_ordered<make_index_sequence<Mapping::extents_type::rank()>>(map.extents(), f);
+  }
+}
+
+template <class Mapping, class F>
+void __for_each_index_runtime_order(Mapping const& map, F& f, false_type /* rank > 1 */) {
+  __for_each_index_ordered<make_index_sequence<Mapping::extents_type::rank()>>(map.extents(), f);
+}
+
+template <class Mapping, class F>
+void __for_each_index_mapping(Mapping const& map, F& f, void*) {
+  __for_each_index_runtime_order(map, f, integral_constant<bool, (Mapping::extents_type::rank() > 1)>());
+}
+
+template <class Mapping, class F, class Order>
+MDSPAN_INLINE_FUNCTION
+void __for_each_index_mapping(Mapping const& map, F& f, Order*) {
+  __for_each_index_ordered<Order>(map.extents(), f);
+}
+
+template <class T>
+struct __is_mdspan : false_type { };
+template <class T, class E, class L, class A>
+struct __is_mdspan<mdspan<T, E, L, A>> : true_type { };
+
+// Cache-oblivious traversal: bisect the longest side of the box [lo, hi) at a
+// multiple of Base until no side exceeds Base, then hand the box to g.  Cuts
+// are Base-aligned, so every box is a full Base^rank cube except at the upper
+// edges of the index space.
+_MDSPAN_INLINE_VARIABLE constexpr size_t __cache_oblivious_base = 16;
+
+template <size_t, size_t V>
+struct __repeat_value : integral_constant<size_t, V> { };
+
+template <size_t Base, class Seq>
+struct __cube_extents;
+template <size_t Base, size_t... Is>
+struct __cube_extents<Base, index_sequence<Is...>> {
+  using type = extents<__repeat_value<Is, Base>::value...>;
+};
+
+template <size_t Base, size_t Rank, class G, size_t... Is>
+void __call_box(G& g, __index_array<size_t, Rank> const& lo, __index_array<size_t, Rank> const& hi,
+                bool full, index_sequence<Is...>) {
+  const array<size_t, Rank> origin{{lo[Is]...}};
+  if(full) {
+    g(origin, typename __cube_extents<Base, index_sequence<Is...>>::type());
+  }
+  else {
+    g(origin, dextents<Rank>((hi[Is] - lo[Is])...));
+  }
+}
+
+template <size_t Base, size_t Rank, class G>
+void __bisect(__index_array<size_t, Rank>& lo, __index_array<size_t, Rank>& hi, G& g) {
+  size_t d = 0;
+  size_t len = 0;
+  bool full = true;
+  for(size_t r = 0; r < Rank; ++r) {
+    const size_t n = hi[r] - lo[r];
+    if(n > len) { len = n; d = r; }
+    full = full && n == Base;
+  }
+  if(len <= Base) {
+    __call_box<Base>(g, lo, hi, full, make_index_sequence<Rank>());
+    return;
+  }
+  const size_t mid = lo[d] + (len + Base - 1) / Base / 2 * Base;
+  const size_t saved_hi = hi[d];
+  hi[d] = mid;
+  __bisect<Base>(lo, hi, g);
+  hi[d] = saved_hi;
+  const size_t saved_lo = lo[d];
+  lo[d] = mid;
+  __bisect<Base>(lo, hi, g);
+  lo[d] = saved_lo;
+}
+
+template <size_t Base, class Extents, class G, size_t... Is>
+void __for_each_box_cache_oblivious(Extents const& exts, G& g, index_sequence<Is...>) {
+  static_assert(Base > 0, "the base-case box needs a positive side");
+  __index_array<size_t, Extents::rank()> lo{};
+  __index_array<size_t, Extents::rank()> hi{{size_t(exts.extent(Is))...}};
+  for(size_t r = 0; r < Extents::rank(); ++r) if(hi[r] == 0) return;
+  __bisect<Base>(lo, hi, g);
+}
+
+// Base-case body of for_each_index_cache_oblivious: the box in Order, with
+// the box origin added back to the indices.
+template <class Order, class F, size_t Rank>
+struct __offset_index_body {
+  F& __f;
+  array<size_t, Rank> const& __origin;
+
+  template <size_t... Is, class... Idx>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  void __call(index_sequence<Is...>, Idx... idxs) const {
+    __f((__origin[Is] + idxs)...);
+  }
+
+  template <class... Idx>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  void operator()(Idx... idxs) const {
+    __call(make_index_sequence<Rank>(), idxs...);
+  }
+};
+
+template <class Order, class F>
+struct __box_index_visitor {
+  F& __f;
+
+  template <size_t Rank, class Box>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  void operator()(array<size_t, Rank> const& origin, Box const& box) const {
+    __offset_index_body<Order, F, Rank> body{__f, origin};
+    __for_each_index_ordered<Order>(box, body);
+  }
+};
+
+// Inside a base box any order is cache friendly; follow the layout when it
+// is known at compile time, row-major otherwise.
+template <class Order, size_t Rank>
+struct __box_loop_order { using type = Order; };
+template <size_t Rank>
+struct __box_loop_order<void, Rank> { using type = make_index_sequence<Rank>; };
+
+} // end namespace detail
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class Extents, class F,
+  /* requires */ (detail::__is_extents_v<Extents>)
+)
+MDSPAN_INLINE_FUNCTION
+void for_each_index(Extents const& exts, F&& f) {
+  detail::__for_each_index_ordered<make_index_sequence<Extents::rank()>>(exts, f);
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class Mapping, class F,
+  /* requires */ (
+    !detail::__is_extents_v<Mapping> &&
+    !detail::__is_mdspan<Mapping>::value &&
+    detail::__is_extents_v<typename Mapping::extents_type>
+  )
+)
+MDSPAN_INLINE_FUNCTION
+void for_each_index(Mapping const& map, F&& f) {
+  using order = typename detail::__layout_loop_order<
+    typename Mapping::layout_type, Mapping::extents_type::rank()>::type;
+  detail::__for_each_index_mapping(map, f, static_cast<order*>(nullptr));
+}
+
+template <class T, class Extents, class Layout, class Accessor, class F>
+MDSPAN_INLINE_FUNCTION
+void for_each_index(mdspan<T, Extents, Layout, Accessor> const& m, F&& f) {
+  for_each_index(m.mapping(), static_cast<F&&>(f));
+}
+
+//==============================================================================
+// for_each_index_cache_oblivious: visit every multi-index once, in an order
+// that is cache friendly for every layout at the same time, for kernels that
+// read and write arrays with different index orders (a layout_left array
+// from a layout_right one, a transpose, ...).  The index space is bisected
+// along its longest dimension down to boxes of at most Base indices per side,
+// and each box is visited in the layout's order (row-major for extents).  No
+// cache size is involved: the recursion reaches every cache level's working
+// set on the way down.
+//
+// for_each_box_cache_oblivious<Base>(exts, g) hands out the boxes instead:
+// g(origin, box) with origin an array<size_t, rank> and box the box's
+// extents, extents<Base, ..., Base> for every full box (constant trip counts
+// the compiler can unroll and vectorize) and dextents<rank> for the partial
+// boxes along the upper edges.  g must accept both.
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t Base = detail::__cache_oblivious_base, class Extents, class G,
+  /* requires */ (detail::__is_extents_v<Extents>)
+)
+void for_each_box_cache_oblivious(Extents const& exts, G&& g) {
+  detail::__for_each_box_cache_oblivious<Base>(exts, g, make_index_sequence<Extents::rank()>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t Base = detail::__cache_oblivious_base, class Extents, class F,
+  /* requires */ (detail::__is_extents_v<Extents>)
+)
+void for_each_index_cache_oblivious(Extents const& exts, F&& f) {
+  detail::__box_index_visitor<make_index_sequence<Extents::rank()>, F> visit{f};
+  detail::__for_each_box_cache_oblivious<Base>(exts, visit, make_index_sequence<Extents::rank()>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t Base = detail::__cache_oblivious_base, class Mapping, class F,
+  /* requires */ (
+    !detail::__is_extents_v<Mapping> &&
+    !detail::__is_mdspan<Mapping>::value &&
+    detail::__is_extents_v<typename Mapping::extents_type>
+  )
+)
+void for_each_index_cache_oblivious(Mapping const& map, F&& f) {
+  constexpr size_t rank = Mapping::extents_type::rank();
+  using order = typename detail::__box_loop_order<
+    typename detail::__layout_loop_order<typename Mapping::layout_type, rank>::type, rank>::type;
+  detail::__box_index_visitor<order, F> visit{f};
+  detail::__for_each_box_cache_oblivious<Base>(map.extents(), visit, make_index_sequence<rank>());
+}
+
+template <size_t Base = detail::__cache_oblivious_base, class T, class Extents, class Layout, class Accessor, class F>
+void for_each_index_cache_oblivious(mdspan<T, Extents, Layout, Accessor> const& m, F&& f) {
+  for_each_index_cache_oblivious<Base>(m.mapping(), static_cast<F&&>(f));
+}
+
+} // end namespace experimental
+} // end namespace std
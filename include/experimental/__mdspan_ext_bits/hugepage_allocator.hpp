@@ -0,0 +1,233 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p1684_bits/mdarray.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <cstdint> // uintptr_t
+#include <cstdio> // sscanf
+#include <fstream>
+#include <limits>
+#include <new> // bad_alloc, bad_array_new_length
+#include <string>
+#include <utility> // forward
+#include <vector>
+
+#include <sys/mman.h>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// hugepage_allocator: 2 MiB aligned anonymous mappings, so large mdspans are
+// covered by huge TLB entries.
+//
+//   hugepage_mode::none         4 KiB pages (MADV_NOHUGEPAGE); the baseline
+//   hugepage_mode::transparent  madvise(MADV_HUGEPAGE), served by THP
+//   hugepage_mode::explicit_    MAP_HUGETLB from the hugetlbfs pool, falling
+//                               back to transparent when the pool is empty
+//
+// Whether the kernel actually backed the region with huge pages is a
+// different matter; hugepage_usage() reports it.  Like numa_allocator,
+// elements are default-initialized so allocation itself touches nothing.
+
+enum class hugepage_mode { none, transparent, explicit_ };
+
+_MDSPAN_INLINE_VARIABLE constexpr size_t huge_page_size = size_t(2) << 20;
+
+struct hugepage_report {
+  size_t total_bytes = 0;
+  size_t huge_bytes = 0;
+
+  double fraction() const noexcept {
+    return total_bytes ? double(huge_bytes) / double(total_bytes) : 0.0;
+  }
+};
+
+namespace detail {
+
+inline size_t __round_to_huge_page(size_t bytes) noexcept {
+  return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+}
+
+// Map `bytes` (a multiple of 2 MiB) at a 2 MiB boundary; nullptr on failure.
+inline void* __map_huge_aligned(size_t bytes, hugepage_mode mode) noexcept {
+#if defined(MAP_HUGETLB)
+  if(mode == hugepage_mode::explicit_) {
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(p != MAP_FAILED) return p;
+  }
+#endif
+  // Over-allocate and trim so the region starts on a huge page boundary.
+  const size_t padded = bytes + huge_page_size;
+  void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(raw == MAP_FAILED) return nullptr;
+  const uintptr_t base = reinterpret_cast<uintptr_t>(raw);
+  const uintptr_t aligned = (base + huge_page_size - 1) & ~uintptr_t(huge_page_size - 1);
+  if(aligned > base) ::munmap(raw, size_t(aligned - base));
+  const size_t tail = size_t(base + padded - (aligned + bytes));
+  if(tail > 0) ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+  void* p = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE) && defined(MADV_NOHUGEPAGE)
+  ::madvise(p, bytes, mode == hugepage_mode::none ? MADV_NOHUGEPAGE : MADV_HUGEPAGE);
+#endif
+  return p;
+}
+
+} // end namespace detail
+
+template <class T>
+class hugepage_allocator {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using propagate_on_container_copy_assignment = true_type;
+  using propagate_on_container_move_assignment = true_type;
+  using propagate_on_container_swap = true_type;
+
+  template <class U>
+  struct rebind { using other = hugepage_allocator<U>; };
+
+  hugepage_allocator() noexcept = default;
+  explicit hugepage_allocator(hugepage_mode mode) noexcept : __mode(mode) { }
+
+  template <class U>
+  hugepage_allocator(const hugepage_allocator<U>& other) noexcept // NOLINT(google-explicit-constructor)
+    : __mode(other.mode())
+  { }
+
+  hugepage_mode mode() const noexcept { return __mode; }
+
+  T* allocate(size_t n) {
+    if(n > (std::numeric_limits<size_t>::max() - huge_page_size) / sizeof(T)) throw std::bad_array_new_length();
+    if(n == 0) return nullptr;
+    void* p = detail::__map_huge_aligned(detail::__round_to_huge_page(n * sizeof(T)), __mode);
+    if(p == nullptr) throw std::bad_alloc();
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    if(p != nullptr) ::munmap(p, detail::__round_to_huge_page(n * sizeof(T)));
+  }
+
+  template <class U>
+  void construct(U* p) noexcept(_MDSPAN_TRAIT(is_nothrow_default_constructible, U)) {
+    ::new (static_cast<void*>(p)) U;
+  }
+
+  template <class U, class... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+private:
+  hugepage_mode __mode = hugepage_mode::transparent;
+};
+
+template <class T, class U>
+bool operator==(const hugepage_allocator<T>& a, const hugepage_allocator<U>& b) noexcept { return a.mode() == b.mode(); }
+template <class T, class U>
+bool operator!=(const hugepage_allocator<T>& a, const hugepage_allocator<U>& b) noexcept { return a.mode() != b.mode(); }
+
+template <class T, class Extents, class LayoutPolicy = layout_right>
+using hugepage_mdarray = mdarray<T, Extents, LayoutPolicy, vector<T, hugepage_allocator<T>>>;
+
+//==============================================================================
+// How much of [p, p + bytes) is backed by huge pages right now.  Reads the
+// AnonHugePages (THP) and *_Hugetlb (hugetlbfs) lines of the mappings in
+// /proc/self/smaps that overlap the region; the mapping totals are clipped to
+// the region, which is exact when the region is a whole mapping (as with
+// hugepage_allocator).  Reports zero huge bytes where smaps is unavailable.
+
+inline hugepage_report hugepage_usage(const void* p, size_t bytes) {
+  hugepage_report report;
+  report.total_bytes = bytes;
+#if defined(__linux__)
+  const uintptr_t lo = reinterpret_cast<uintptr_t>(p);
+  const uintptr_t hi = lo + bytes;
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  size_t overlap = 0;
+  while(std::getline(smaps, line)) {
+    unsigned long long start = 0, end = 0, kb = 0;
+    char dash = 0;
+    if(std::sscanf(line.c_str(), "%llx%c%llx", &start, &dash, &end) == 3 && dash == '-') {
+      const uintptr_t s = uintptr_t(start) > lo ? uintptr_t(start) : lo;
+      const uintptr_t e = uintptr_t(end) < hi ? uintptr_t(end) : hi;
+      overlap = e > s ? size_t(e - s) : 0;
+      continue;
+    }
+    if(overlap == 0) continue;
+    if(std::sscanf(line.c_str(), "AnonHugePages: %llu kB", &kb) == 1 ||
+       std::sscanf(line.c_str(), "Private_Hugetlb: %llu kB", &kb) == 1 ||
+       std::sscanf(line.c_str(), "Shared_Hugetlb: %llu kB", &kb) == 1) {
+      const size_t huge = size_t(kb) * 1024;
+      report.huge_bytes += huge < overlap ? huge : overlap;
+    }
+  }
+  if(report.huge_bytes > bytes) report.huge_bytes = bytes;
+#else
+  (void)p;
+#endif
+  return report;
+}
+
+template <class T, class Extents, class Layout>
+hugepage_report hugepage_usage(mdspan<T, Extents, Layout> const& m) {
+  return hugepage_usage(m.data(), m.mapping().required_span_size() * sizeof(T));
+}
+
+} // end namespace experimental
+} // end namespace std
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,295 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "for_each_index.hpp"
+
+#include <cstddef> // size_t
+#include <cstring> // memcpy
+#include <type_traits>
+
+#if defined(__SSE__)
+#  include <immintrin.h>
+#endif
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// copy(src, dst): dst[i] = src[i] for mdspans of equal extents, whatever
+// their layouts.  The copy is dispatched on what the two mappings look like:
+//
+//   - same contiguous index-to-offset map (layout_right to layout_right, two
+//     layout_strides with equal packed strides, ...): one memcpy
+//   - rank 2 with the stride-1 dimension swapped (layout_left to layout_right
+//     and back, or the strided equivalent): a cache-blocked transpose built
+//     from 4x4 in-register transposes where SSE is available
+//   - rank 2 with the same stride-1 dimension but different padding: one
+//     memcpy per row (or column)
+//   - anything else: an element loop, in the destination's layout order when
+//     both sides are contiguous along the same dimension, otherwise in the
+//     cache-oblivious order of for_each_index_cache_oblivious
+//
+// The first two need a trivially copyable element type, plain pointer
+// accessors on both sides and no overlap between source and destination.
+// Mismatched static extents are a compile error; dynamic ones are checked
+// under MDSPAN_CHECK_BOUNDS.
+
+namespace detail {
+
+// Transpose blocks: a source and a destination block (2 x 64 x 64 doubles,
+// 64 KiB) stay in L2, and every destination column segment spans whole cache
+// lines.
+_MDSPAN_INLINE_VARIABLE constexpr size_t __transpose_block = 64;
+
+// dst[i + j * dst_ld] = src[i * src_ld + j] for a 4 x 4 tile.
+template <class T, class Enable = void>
+struct __transpose_4x4 {
+  static void __apply(T const* src, size_t src_ld, T* dst, size_t dst_ld) noexcept {
+    for(size_t j = 0; j < 4; ++j) {
+      for(size_t i = 0; i < 4; ++i) {
+        dst[i + j * dst_ld] = src[i * src_ld + j];
+      }
+    }
+  }
+};
+
+#if defined(__SSE__)
+// 4-byte elements: four row loads, _MM_TRANSPOSE4_PS, four row stores.  The
+// bits are moved, never interpreted as floats, so any 4-byte type works.
+template <class T>
+struct __transpose_4x4<T, enable_if_t<sizeof(T) == 4>> {
+  static void __apply(T const* src, size_t src_ld, T* dst, size_t dst_ld) noexcept {
+    __m128 r0 = _mm_loadu_ps(reinterpret_cast<float const*>(src));
+    __m128 r1 = _mm_loadu_ps(reinterpret_cast<float const*>(src + src_ld));
+    __m128 r2 = _mm_loadu_ps(reinterpret_cast<float const*>(src + 2 * src_ld));
+    __m128 r3 = _mm_loadu_ps(reinterpret_cast<float const*>(src + 3 * src_ld));
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(reinterpret_cast<float*>(dst), r0);
+    _mm_storeu_ps(reinterpret_cast<float*>(dst + dst_ld), r1);
+    _mm_storeu_ps(reinterpret_cast<float*>(dst + 2 * dst_ld), r2);
+    _mm_storeu_ps(reinterpret_cast<float*>(dst + 3 * dst_ld), r3);
+  }
+};
+#endif
+
+#if defined(__SSE2__)
+// 8-byte elements: four 2 x 2 transposes with unpacklo / unpackhi.
+template <class T>
+struct __transpose_4x4<T, enable_if_t<sizeof(T) == 8>> {
+  static void __apply(T const* src, size_t src_ld, T* dst, size_t dst_ld) noexcept {
+    for(size_t bi = 0; bi < 4; bi += 2) {
+      for(size_t bj = 0; bj < 4; bj += 2) {
+        const double* s = reinterpret_cast<double const*>(src + bi * src_ld + bj);
+        double* d = reinterpret_cast<double*>(dst + bi + bj * dst_ld);
+        const __m128d a = _mm_loadu_pd(s);
+        const __m128d b = _mm_loadu_pd(s + src_ld);
+        _mm_storeu_pd(d, _mm_unpacklo_pd(a, b));
+        _mm_storeu_pd(d + dst_ld, _mm_unpackhi_pd(a, b));
+      }
+    }
+  }
+};
+#endif
+
+// dst[i + j * dst_ld] = src[i * src_ld + j] for i < rows, j < cols: blocks of
+// __transpose_block, 4 x 4 tiles inside them, scalar edges.
+template <class T>
+void __transpose_copy(T const* src, size_t src_ld, T* dst, size_t dst_ld, size_t rows, size_t cols) noexcept {
+  constexpr size_t B = __transpose_block;
+  for(size_t i0 = 0; i0 < rows; i0 += B) {
+    const size_t i1 = i0 + B < rows ? i0 + B : rows;
+    for(size_t j0 = 0; j0 < cols; j0 += B) {
+      const size_t j1 = j0 + B < cols ? j0 + B : cols;
+      size_t i = i0;
+      for(; i + 4 <= i1; i += 4) {
+        size_t j = j0;
+        for(; j + 4 <= j1; j += 4) {
+          __transpose_4x4<T>::__apply(src + i * src_ld + j, src_ld, dst + i + j * dst_ld, dst_ld);
+        }
+        for(; j < j1; ++j) {
+          for(size_t ii = i; ii < i + 4; ++ii) dst[ii + j * dst_ld] = src[ii * src_ld + j];
+        }
+      }
+      for(; i < i1; ++i) {
+        for(size_t j = j0; j < j1; ++j) dst[i + j * dst_ld] = src[i * src_ld + j];
+      }
+    }
+  }
+}
+
+template <class Src, class Dst>
+struct __copy_is_raw : integral_constant<bool,
+  _MDSPAN_TRAIT(is_same, remove_const_t<typename Src::element_type>, typename Dst::element_type) &&
+  _MDSPAN_TRAIT(is_trivially_copyable, typename Dst::element_type) &&
+  _MDSPAN_TRAIT(is_same, typename Src::accessor_type, default_accessor<typename Src::element_type>) &&
+  _MDSPAN_TRAIT(is_same, typename Dst::accessor_type, default_accessor<typename Dst::element_type>)
+> { };
+
+template <class Mapping>
+bool __is_packed(Mapping const& map) noexcept {
+  size_t size = 1;
+  for(size_t r = 0; r < Mapping::extents_type::rank(); ++r) size *= map.extents().extent(r);
+  return map.is_contiguous() && map.is_unique() && size_t(map.required_span_size()) == size;
+}
+
+// Both mappings send every index to the same offset, and cover their span.
+template <class SrcMapping, class DstMapping>
+bool __same_packed_map(SrcMapping const& src, DstMapping const& dst) noexcept {
+  if(!__is_packed(src) || !__is_packed(dst)) return false;
+  if(!src.is_strided() || !dst.is_strided()) return false;
+  for(size_t r = 0; r < SrcMapping::extents_type::rank(); ++r) {
+    if(src.extents().extent(r) > 1 && src.stride(r) != dst.stride(r)) return false;
+  }
+  return true;
+}
+
+// The dimension with the smallest stride among those of extent > 1.
+template <class Mapping>
+size_t __innermost_dim(Mapping const& map) {
+  size_t dim = 0;
+  for(size_t r = 0; r < Mapping::extents_type::rank(); ++r) {
+    if(map.extents().extent(r) > 1 &&
+       (map.extents().extent(dim) <= 1 || map.stride(r) < map.stride(dim))) dim = r;
+  }
+  return dim;
+}
+
+// Element loop: in the destination's layout order when both sides run along
+// the same dimension in memory, cache-oblivious when they do not.
+template <class Src, class Dst>
+void __copy_elementwise(Src const& src, Dst const& dst) {
+  const auto src_acc = src.accessor();
+  const auto dst_acc = dst.accessor();
+  auto body = [&](auto... idxs) {
+    dst_acc.access(dst.data(), dst.mapping()(idxs...)) = src_acc.access(src.data(), src.mapping()(idxs...));
+  };
+  auto const& sm = src.mapping();
+  auto const& dm = dst.mapping();
+  if(sm.is_strided() && dm.is_strided() && __innermost_dim(sm) != __innermost_dim(dm)) {
+    for_each_index_cache_oblivious(dm, body);
+  }
+  else {
+    for_each_index(dm, body);
+  }
+}
+
+// Rank 2 with the stride-1 dimension swapped between source and destination
+// becomes a transpose; with the same stride-1 dimension but other leading
+// dimensions (padded rows) a memcpy per row or column.
+template <class Src, class Dst>
+bool __copy_strided_2d(Src const& src, Dst const& dst, integral_constant<size_t, 2>) {
+  auto const& sm = src.mapping();
+  auto const& dm = dst.mapping();
+  if(!sm.is_strided() || !dm.is_strided()) return false;
+  const size_t n0 = src.extent(0), n1 = src.extent(1);
+  constexpr size_t bytes = sizeof(typename Dst::element_type);
+  if(sm.stride(1) == 1 && dm.stride(1) == 1) {
+    for(size_t i = 0; i < n0; ++i) {
+      std::memcpy(dst.data() + i * size_t(dm.stride(0)), src.data() + i * size_t(sm.stride(0)), n1 * bytes);
+    }
+    return true;
+  }
+  if(sm.stride(0) == 1 && dm.stride(0) == 1) {
+    for(size_t j = 0; j < n1; ++j) {
+      std::memcpy(dst.data() + j * size_t(dm.stride(1)), src.data() + j * size_t(sm.stride(1)), n0 * bytes);
+    }
+    return true;
+  }
+  if(n0 < 4 || n1 < 4) return false;
+  // src contiguous along 1 and dst along 0: rows of src become columns of dst
+  if(sm.stride(1) == 1 && dm.stride(0) == 1) {
+    __transpose_copy(src.data(), size_t(sm.stride(0)), dst.data(), size_t(dm.stride(1)), n0, n1);
+    return true;
+  }
+  if(sm.stride(0) == 1 && dm.stride(1) == 1) {
+    __transpose_copy(src.data(), size_t(sm.stride(1)), dst.data(), size_t(dm.stride(0)), n1, n0);
+    return true;
+  }
+  return false;
+}
+
+template <class Src, class Dst, size_t Rank>
+bool __copy_strided_2d(Src const&, Dst const&, integral_constant<size_t, Rank>) {
+  return false;
+}
+
+template <class Src, class Dst>
+void __copy_dispatch(Src const& src, Dst const& dst, true_type /* raw */) {
+  if(__same_packed_map(src.mapping(), dst.mapping())) {
+    const size_t n = src.size();
+    if(n != 0) std::memcpy(dst.data(), src.data(), n * sizeof(typename Dst::element_type));
+    return;
+  }
+  if(__copy_strided_2d(src, dst, integral_constant<size_t, Src::extents_type::rank()>())) return;
+  __copy_elementwise(src, dst);
+}
+
+template <class Src, class Dst>
+void __copy_dispatch(Src const& src, Dst const& dst, false_type /* raw */) {
+  __copy_elementwise(src, dst);
+}
+
+} // end namespace detail
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class SrcMDSpan, class DstMDSpan,
+  /* requires */ (
+    detail::__is_mdspan<SrcMDSpan>::value && detail::__is_mdspan<DstMDSpan>::value &&
+    SrcMDSpan::extents_type::rank() == DstMDSpan::extents_type::rank()
+  )
+)
+void copy(SrcMDSpan src, DstMDSpan dst) {
+  static_assert(detail::__static_extents_match<typename SrcMDSpan::extents_type, typename DstMDSpan::extents_type>(),
+    "std::experimental::copy requires matching extents.");
+  _MDSPAN_CHECK_EXTENTS("copy", src.extents(), dst.extents());
+  detail::__copy_dispatch(src, dst, detail::__copy_is_raw<SrcMDSpan, DstMDSpan>());
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,296 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/layout_stride.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cerrno>
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <stdexcept> // runtime_error, invalid_argument
+#include <string>
+#include <system_error>
+#include <utility> // swap
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// mmap_mdspan: an owning, move-only memory mapping of a file, viewed as an
+// mdspan.  The file contents are the elements in mapping order, starting at
+// options.offset bytes into the file; nothing is copied on construction.
+
+enum class mmap_mode {
+  read_only,      // PROT_READ, shared; requires a const element type
+  read_write,     // PROT_READ | PROT_WRITE, shared; writes reach the file
+  copy_on_write,  // PROT_READ | PROT_WRITE, private; writes stay in memory
+  create          // like read_write, but creates the file or grows it first
+};
+
+enum class mmap_advice {
+  from_layout,  // sequential for contiguous layouts, random otherwise
+  none,
+  normal,
+  sequential,
+  random,
+  will_need
+};
+
+struct mmap_options {
+  // Byte offset of the first element in the file.  Need not be page aligned.
+  size_t offset = 0;
+  // Pre-fault the whole mapping (MAP_POPULATE where available).
+  bool populate = false;
+  mmap_advice advice = mmap_advice::from_layout;
+  // Place the mapping at a 2 MiB aligned address and request transparent
+  // huge pages; the request is ignored where the file system can't honor it.
+  bool huge_page_aligned = false;
+};
+
+namespace detail {
+
+[[noreturn]] inline void __throw_mmap_error(const char* what, std::string const& path) {
+  throw std::system_error(errno, std::generic_category(), std::string("mmap_mdspan: ") + what + " '" + path + "'");
+}
+
+struct __mmap_region {
+  void* base = nullptr;  // page (or huge page) aligned start of the mapping
+  size_t length = 0;     // length of the mapping in bytes
+  void* data = nullptr;  // first element, base + offset % page size
+};
+
+inline size_t __mmap_page_size() noexcept {
+  return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+inline __mmap_region __map_file(
+  std::string const& path, size_t bytes, mmap_mode mode, mmap_options const& options, int advice
+)
+{
+  __mmap_region result;
+  const bool writable = mode != mmap_mode::read_only;
+  const int open_flags =
+    mode == mmap_mode::create ? (O_RDWR | O_CREAT) :
+    mode == mmap_mode::read_write ? O_RDWR : O_RDONLY;
+  const int fd = ::open(path.c_str(), open_flags | O_CLOEXEC, 0644);
+  if(fd < 0) __throw_mmap_error("cannot open", path);
+
+  struct __fd_closer { int fd; ~__fd_closer() { ::close(fd); } } closer{fd};
+
+  // create only ever grows the file; data past the mapping is left alone.
+  const size_t required = options.offset + bytes;
+  struct stat st;
+  if(::fstat(fd, &st) != 0) __throw_mmap_error("cannot stat", path);
+  if(static_cast<size_t>(st.st_size) < required) {
+    if(mode != mmap_mode::create) {
+      throw std::runtime_error("mmap_mdspan: file '" + path + "' is smaller than the requested mapping");
+    }
+    if(::ftruncate(fd, static_cast<off_t>(required)) != 0) __throw_mmap_error("cannot resize", path);
+  }
+  if(bytes == 0) return result;
+
+  const size_t page = __mmap_page_size();
+  const size_t file_offset = options.offset - options.offset % page;
+  const size_t delta = options.offset - file_offset;
+  result.length = delta + bytes;
+
+  const int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  int flags = mode == mmap_mode::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+#ifdef MAP_POPULATE
+  if(options.populate) flags |= MAP_POPULATE;
+#endif
+
+  void* hint = nullptr;
+  if(options.huge_page_aligned) {
+    // Reserve enough address space to find a 2 MiB boundary, then map the
+    // file over the aligned part and give the slack back.
+    constexpr size_t huge = size_t(2) << 20;
+    const size_t reserve_length = result.length + huge;
+    void* reserved = ::mmap(nullptr, reserve_length, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(reserved == MAP_FAILED) __throw_mmap_error("cannot reserve address space for", path);
+    const uintptr_t start = reinterpret_cast<uintptr_t>(reserved);
+    const uintptr_t aligned = (start + huge - 1) & ~uintptr_t(huge - 1);
+    if(aligned > start) ::munmap(reserved, aligned - start);
+    const uintptr_t end = start + reserve_length;
+    const uintptr_t aligned_end = aligned + ((result.length + page - 1) / page) * page;
+    if(end > aligned_end) ::munmap(reinterpret_cast<void*>(aligned_end), end - aligned_end);
+    hint = reinterpret_cast<void*>(aligned);
+    flags |= MAP_FIXED;
+  }
+
+  void* base = ::mmap(hint, result.length, prot, flags, fd, static_cast<off_t>(file_offset));
+  if(base == MAP_FAILED) {
+    if(hint != nullptr) ::munmap(hint, result.length);
+    __throw_mmap_error("cannot map", path);
+  }
+  result.base = base;
+  result.data = static_cast<char*>(base) + delta;
+
+  // Advice is only a hint, so failures are deliberately ignored.
+#ifdef MADV_HUGEPAGE
+  if(options.huge_page_aligned) (void)::madvise(base, result.length, MADV_HUGEPAGE);
+#endif
+  if(advice != -1) (void)::madvise(base, result.length, advice);
+#ifndef MAP_POPULATE
+  if(options.populate) (void)::madvise(base, result.length, MADV_WILLNEED);
+#endif
+  return result;
+}
+
+inline int __mmap_advice_flag(mmap_advice advice, bool sequential) noexcept {
+  switch(advice) {
+    case mmap_advice::from_layout: return sequential ? MADV_SEQUENTIAL : MADV_RANDOM;
+    case mmap_advice::normal: return MADV_NORMAL;
+    case mmap_advice::sequential: return MADV_SEQUENTIAL;
+    case mmap_advice::random: return MADV_RANDOM;
+    case mmap_advice::will_need: return MADV_WILLNEED;
+    case mmap_advice::none: break;
+  }
+  return -1;
+}
+
+} // end namespace detail
+
+template <class ElementType, class Extents, class LayoutPolicy = layout_right>
+class mmap_mdspan {
+public:
+  using mdspan_type = mdspan<ElementType, Extents, LayoutPolicy>;
+  using element_type = ElementType;
+  using extents_type = Extents;
+  using layout_type = LayoutPolicy;
+  using mapping_type = typename mdspan_type::mapping_type;
+
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, remove_cv_t<ElementType>),
+    "std::experimental::mmap_mdspan requires a trivially copyable element type.");
+
+  // read_only for const element types, read_write otherwise.
+  static constexpr mmap_mode default_mode() noexcept {
+    return _MDSPAN_TRAIT(is_const, ElementType) ? mmap_mode::read_only : mmap_mode::read_write;
+  }
+
+  mmap_mdspan() noexcept = default;
+
+  mmap_mdspan(std::string const& path, mapping_type const& map,
+              mmap_mode mode = default_mode(), mmap_options const& options = mmap_options())
+  {
+    if(mode == mmap_mode::read_only && !_MDSPAN_TRAIT(is_const, ElementType)) {
+      throw std::invalid_argument("mmap_mdspan: a read_only mapping requires a const element type");
+    }
+    if(options.offset % alignof(ElementType) != 0) {
+      throw std::invalid_argument("mmap_mdspan: offset is not aligned for the element type");
+    }
+    const int advice = detail::__mmap_advice_flag(options.advice, map.is_contiguous());
+    __region = detail::__map_file(path, map.required_span_size() * sizeof(ElementType), mode, options, advice);
+    __view = mdspan_type(static_cast<ElementType*>(__region.data), map);
+  }
+
+  mmap_mdspan(mmap_mdspan const&) = delete;
+  mmap_mdspan& operator=(mmap_mdspan const&) = delete;
+
+  mmap_mdspan(mmap_mdspan&& other) noexcept { swap(other); }
+  mmap_mdspan& operator=(mmap_mdspan&& other) noexcept {
+    mmap_mdspan(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~mmap_mdspan() {
+    if(__region.base != nullptr) ::munmap(__region.base, __region.length);
+  }
+
+  void swap(mmap_mdspan& other) noexcept {
+    using std::swap;
+    swap(__region, other.__region);
+    swap(__view, other.__view);
+  }
+
+  mdspan_type view() const noexcept { return __view; }
+  operator mdspan_type() const noexcept { return __view; } // NOLINT(google-explicit-constructor)
+
+  ElementType* data() const noexcept { return __view.data(); }
+  mapping_type mapping() const noexcept { return __view.mapping(); }
+  extents_type extents() const noexcept { return __view.extents(); }
+  size_t size_bytes() const noexcept { return __view.mapping().required_span_size() * sizeof(ElementType); }
+  bool is_mapped() const noexcept { return __region.base != nullptr; }
+
+  // Flush modified pages of a shared mapping back to the file.
+  void sync(bool async = false) const {
+    if(__region.base == nullptr) return;
+    if(::msync(__region.base, __region.length, async ? MS_ASYNC : MS_SYNC) != 0) {
+      throw std::system_error(errno, std::generic_category(), "mmap_mdspan: msync failed");
+    }
+  }
+
+private:
+  detail::__mmap_region __region;
+  mdspan_type __view;
+};
+
+// Map `path` as an mdspan<ElementType, Extents, LayoutPolicy> with the given
+// dynamic extents.
+template <class ElementType, class Extents, class LayoutPolicy = layout_right, class... SizeTypes>
+mmap_mdspan<ElementType, Extents, LayoutPolicy>
+make_mmap_mdspan(std::string const& path, mmap_mode mode, SizeTypes... dynamic_extents) {
+  using mapping_t = typename LayoutPolicy::template mapping<Extents>;
+  return mmap_mdspan<ElementType, Extents, LayoutPolicy>(
+    path, mapping_t(Extents(dynamic_extents...)), mode
+  );
+}
+
+} // end namespace experimental
+} // end namespace std
+
+#endif // defined(__unix__) || defined(__APPLE__)
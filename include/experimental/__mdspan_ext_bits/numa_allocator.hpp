@@ -0,0 +1,351 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/layout_stride.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p1684_bits/mdarray.hpp"
+#include "for_each_index.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <array>
+#include <cerrno>
+#include <cstddef> // size_t, ptrdiff_t
+#include <cstdint> // uint64_t, uintptr_t
+#include <limits>
+#include <new> // bad_alloc, bad_array_new_length
+#include <system_error>
+#include <utility> // forward
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// NUMA placement for mdspan storage.
+//
+// numa_allocator maps fresh anonymous memory and default-initializes
+// elements, so nothing is touched when a container is created.  Pages then
+// land according to the policy:
+//
+//   first_touch  on the node of the thread that first writes them; pair it
+//                with first_touch() / first_touch_rows() using the same
+//                partition as the compute kernel
+//   interleave   round-robin over the nodes in node_mask (mbind)
+//   bind         on `node` only (mbind)
+//
+// numa_page_distribution() reports where the pages of a region ended up, and
+// how many have not been touched yet.  Without kernel NUMA support
+// interleave/bind are no-ops and every resident page counts as node 0.
+
+enum class numa_placement { first_touch, interleave, bind };
+
+struct numa_policy {
+  numa_placement placement = numa_placement::first_touch;
+  unsigned node = 0;                        // for bind
+  uint64_t node_mask = ~uint64_t(0);        // for interleave
+};
+
+struct numa_page_report {
+  std::vector<size_t> pages_per_node;
+  size_t untouched_pages = 0;
+  size_t total_pages = 0;
+
+  size_t touched_pages() const noexcept { return total_pages - untouched_pages; }
+};
+
+namespace detail {
+
+inline size_t __numa_page_size() noexcept {
+  static const size_t page = size_t(sysconf(_SC_PAGESIZE));
+  return page;
+}
+
+inline void __numa_apply_policy(void* p, size_t bytes, numa_policy const& policy) {
+#if defined(__linux__) && defined(SYS_mbind)
+  if(policy.placement == numa_placement::first_touch || bytes == 0) return;
+  constexpr int mpol_bind = 2, mpol_interleave = 3;
+  unsigned long mask[1];
+  int mode;
+  if(policy.placement == numa_placement::bind) {
+    if(policy.node >= 64) throw std::system_error(EINVAL, std::generic_category(), "numa_allocator: node out of range");
+    mask[0] = 1ul << policy.node;
+    mode = mpol_bind;
+  }
+  else {
+    mask[0] = static_cast<unsigned long>(policy.node_mask);
+    mode = mpol_interleave;
+  }
+  // The kernel reads maxnode - 1 bits of the mask, so 65 covers nodes 0-63.
+  if(syscall(SYS_mbind, p, bytes, mode, mask, 65ul, 0u) != 0 && errno != ENOSYS) {
+    throw std::system_error(errno, std::generic_category(), "numa_allocator: mbind failed");
+  }
+#else
+  (void)p; (void)bytes; (void)policy;
+#endif
+}
+
+} // end namespace detail
+
+template <class T>
+class numa_allocator {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using propagate_on_container_copy_assignment = true_type;
+  using propagate_on_container_move_assignment = true_type;
+  using propagate_on_container_swap = true_type;
+
+  template <class U>
+  struct rebind { using other = numa_allocator<U>; };
+
+  numa_allocator() noexcept = default;
+  explicit numa_allocator(numa_policy policy) noexcept : __policy(policy) { }
+
+  template <class U>
+  numa_allocator(const numa_allocator<U>& other) noexcept // NOLINT(google-explicit-constructor)
+    : __policy(other.policy())
+  { }
+
+  numa_policy const& policy() const noexcept { return __policy; }
+
+  T* allocate(size_t n) {
+    if(n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+    if(n == 0) return nullptr;
+    const size_t bytes = __mapped_bytes(n);
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p == MAP_FAILED) throw std::bad_alloc();
+    try {
+      detail::__numa_apply_policy(p, bytes, __policy);
+    }
+    catch(...) {
+      ::munmap(p, bytes);
+      throw;
+    }
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    if(p != nullptr) ::munmap(p, __mapped_bytes(n));
+  }
+
+  // Default-initialize, so trivial elements are not written (and their pages
+  // not touched) until the first real store.
+  template <class U>
+  void construct(U* p) noexcept(_MDSPAN_TRAIT(is_nothrow_default_constructible, U)) {
+    ::new (static_cast<void*>(p)) U;
+  }
+
+  template <class U, class... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+private:
+  static size_t __mapped_bytes(size_t n) noexcept {
+    const size_t page = detail::__numa_page_size();
+    return (n * sizeof(T) + page - 1) / page * page;
+  }
+
+  numa_policy __policy;
+};
+
+template <class T, class U>
+bool operator==(const numa_allocator<T>& a, const numa_allocator<U>& b) noexcept {
+  return a.policy().placement == b.policy().placement && a.policy().node == b.policy().node &&
+         a.policy().node_mask == b.policy().node_mask;
+}
+template <class T, class U>
+bool operator!=(const numa_allocator<T>& a, const numa_allocator<U>& b) noexcept { return !(a == b); }
+
+template <class T, class Extents, class LayoutPolicy = layout_right>
+using numa_mdarray = mdarray<T, Extents, LayoutPolicy, vector<T, numa_allocator<T>>>;
+
+//==============================================================================
+// First touch.  Pages are split along the slowest-varying dimension of the
+// mapping, first_touch_dim(m): the first for layout_right, the last for
+// layout_left, the one with the largest stride otherwise.
+// first_touch_rows(m, begin, end) value-initializes every element whose index
+// along that dimension is in [begin, end); call it from each worker with that
+// worker's share of m.extent(first_touch_dim(m)).  first_touch(m) does the
+// whole span with the static schedule of `#pragma omp parallel for` (serially
+// without OpenMP), which matches kernels parallelized the same way.
+
+template <class T, class Extents, class Layout, class Accessor>
+size_t first_touch_dim(mdspan<T, Extents, Layout, Accessor> const& m) {
+  static_assert(Extents::rank() > 0, "std::experimental::first_touch_dim requires rank > 0.");
+  constexpr size_t rank = Extents::rank();
+  if(_MDSPAN_TRAIT(is_same, Layout, layout_right)) return 0;
+  if(_MDSPAN_TRAIT(is_same, Layout, layout_left)) return rank - 1;
+  if(!m.mapping().is_strided()) return 0;
+  size_t dim = 0;
+  for(size_t r = 1; r < rank; ++r) {
+    if(m.extent(r) > 1 && (m.extent(dim) <= 1 || m.stride(r) > m.stride(dim))) dim = r;
+  }
+  return dim;
+}
+
+namespace detail {
+
+// Visit the slab in memory order: a mapping of the slab's extents with the
+// same loop order as m's drives for_each_index.
+template <class MDSpan, class SlabExtents, class F>
+void __first_touch_visit(MDSpan const&, SlabExtents const& exts, F& f, true_type /* layout_left or layout_right */) {
+  for_each_index(typename MDSpan::layout_type::template mapping<SlabExtents>(exts), f);
+}
+
+template <class MDSpan, class SlabExtents, class F>
+void __first_touch_visit(MDSpan const& m, SlabExtents const& exts, F& f, false_type) {
+  if(!m.mapping().is_strided()) {
+    for_each_index(exts, f);
+    return;
+  }
+  array<size_t, SlabExtents::rank()> strides;
+  for(size_t r = 0; r < SlabExtents::rank(); ++r) strides[r] = m.stride(r);
+  for_each_index(layout_stride::mapping<SlabExtents>(exts, strides), f);
+}
+
+template <class MDSpan>
+void __first_touch_slab(MDSpan const& m, size_t dim, size_t begin, size_t end) {
+  constexpr size_t rank = MDSpan::extents_type::rank();
+  array<size_t, rank> slab;
+  for(size_t r = 0; r < rank; ++r) slab[r] = r == dim ? end - begin : m.extent(r);
+  auto body = [&](auto... idxs) {
+    array<size_t, rank> idx{{size_t(idxs)...}};
+    idx[dim] += begin;
+    m[idx] = typename MDSpan::value_type();
+  };
+  using layout_t = typename MDSpan::layout_type;
+  __first_touch_visit(m, dextents<rank>(slab), body, integral_constant<bool,
+    _MDSPAN_TRAIT(is_same, layout_t, layout_right) || _MDSPAN_TRAIT(is_same, layout_t, layout_left)>());
+}
+
+} // end namespace detail
+
+template <class T, class Extents, class Layout, class Accessor>
+void first_touch_rows(mdspan<T, Extents, Layout, Accessor> m, size_t begin, size_t end) {
+  static_assert(Extents::rank() > 0, "std::experimental::first_touch_rows requires rank > 0.");
+  if(begin < end) detail::__first_touch_slab(m, first_touch_dim(m), begin, end);
+}
+
+template <class T, class Extents, class Layout, class Accessor>
+void first_touch(mdspan<T, Extents, Layout, Accessor> m) {
+  static_assert(Extents::rank() > 0, "std::experimental::first_touch requires rank > 0.");
+  const size_t dim = first_touch_dim(m);
+  const ptrdiff_t rows = ptrdiff_t(m.extent(dim));
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static)
+#endif
+  for(ptrdiff_t i = 0; i < rows; ++i) {
+    detail::__first_touch_slab(m, dim, size_t(i), size_t(i) + 1);
+  }
+}
+
+//==============================================================================
+// Where did the pages go?
+
+inline numa_page_report numa_page_distribution(const void* p, size_t bytes) {
+  numa_page_report report;
+  const size_t page = detail::__numa_page_size();
+  const uintptr_t first = reinterpret_cast<uintptr_t>(p) / page * page;
+  const uintptr_t last = (reinterpret_cast<uintptr_t>(p) + bytes + page - 1) / page * page;
+  report.total_pages = size_t(last - first) / page;
+  if(report.total_pages == 0) return report;
+
+#if defined(__linux__) && defined(SYS_move_pages)
+  // With a null node list move_pages only queries: status is the node of
+  // each page, or -ENOENT for pages that were never touched.
+  std::vector<void*> pages(report.total_pages);
+  std::vector<int> status(report.total_pages, 0);
+  for(size_t i = 0; i < pages.size(); ++i) pages[i] = reinterpret_cast<void*>(first + i * page);
+  if(syscall(SYS_move_pages, 0, (unsigned long)pages.size(), pages.data(), nullptr, status.data(), 0) == 0) {
+    for(int s : status) {
+      if(s < 0) { ++report.untouched_pages; continue; }
+      if(size_t(s) >= report.pages_per_node.size()) report.pages_per_node.resize(size_t(s) + 1, 0);
+      ++report.pages_per_node[size_t(s)];
+    }
+    return report;
+  }
+#endif
+
+  // No NUMA support: residency only, all on node 0.
+#if defined(__APPLE__)
+  std::vector<char> resident(report.total_pages);
+#else
+  std::vector<unsigned char> resident(report.total_pages);
+#endif
+  if(::mincore(reinterpret_cast<void*>(first), size_t(last - first), resident.data()) != 0) {
+    throw std::system_error(errno, std::generic_category(), "numa_page_distribution: mincore failed");
+  }
+  report.pages_per_node.assign(1, 0);
+  for(auto r : resident) {
+    if(r & 1) ++report.pages_per_node[0];
+    else ++report.untouched_pages;
+  }
+  return report;
+}
+
+template <class T, class Extents, class Layout>
+numa_page_report numa_page_distribution(mdspan<T, Extents, Layout> const& m) {
+  return numa_page_distribution(m.data(), m.mapping().required_span_size() * sizeof(T));
+}
+
+} // end namespace experimental
+} // end namespace std
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,509 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstring> // memset
+#include <memory> // unique_ptr
+#include <mutex>
+#include <stdexcept> // runtime_error, logic_error, out_of_range
+#include <string>
+#include <system_error>
+#include <utility> // move
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// page_cache: a file of T split into fixed-size pages, of which at most
+// `max_resident_pages` are held in memory.  Pages are replaced in LRU order
+// (at the granularity of misses), pinned pages are never evicted, and dirty
+// pages are written back to the file on eviction, flush() and destruction.
+// All member functions are thread-safe; loads and stores that hit a resident
+// page take no lock.
+
+enum class page_cache_mode { read_only, read_write, create };
+
+struct page_cache_stats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  uint64_t writebacks = 0;
+};
+
+template <class T>
+class page_cache {
+private:
+  struct __page {
+    size_t index = 0;
+    unique_ptr<T[]> data;
+    atomic<bool> dirty{false};
+    atomic<size_t> pins{0};
+    // Miss count at the most recent use; the smallest unpinned one is evicted.
+    atomic<uint64_t> last_use{0};
+  };
+
+public:
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, T),
+    "std::experimental::page_cache requires a trivially copyable element type.");
+
+  using value_type = T;
+
+  // RAII handle that keeps one page resident.  Its data() may be used without
+  // further locking for as long as the handle lives.
+  class page_handle {
+  public:
+    page_handle() noexcept = default;
+    page_handle(page_handle&& other) noexcept : __cache(other.__cache), __page_ptr(other.__page_ptr) {
+      other.__cache = nullptr;
+      other.__page_ptr = nullptr;
+    }
+    page_handle& operator=(page_handle&& other) noexcept {
+      if(this != &other) {
+        __release();
+        __cache = other.__cache;
+        __page_ptr = other.__page_ptr;
+        other.__cache = nullptr;
+        other.__page_ptr = nullptr;
+      }
+      return *this;
+    }
+    ~page_handle() { __release(); }
+
+    T* data() const noexcept { return __page_ptr ? __page_ptr->data.get() : nullptr; }
+    size_t page_index() const noexcept { return __page_ptr ? __page_ptr->index : 0; }
+    size_t size() const noexcept { return __cache ? __cache->elements_per_page() : 0; }
+    explicit operator bool() const noexcept { return __page_ptr != nullptr; }
+
+  private:
+    friend class page_cache;
+    page_handle(page_cache* c, __page* p) noexcept : __cache(c), __page_ptr(p) { }
+    void __release() noexcept {
+      if(__cache != nullptr) __cache->__unpin(__page_ptr);
+      __cache = nullptr;
+      __page_ptr = nullptr;
+    }
+    page_cache* __cache = nullptr;
+    __page* __page_ptr = nullptr;
+  };
+
+  // For page_cache_mode::create the file is created, or grown, to hold at
+  // least `element_count` elements; an existing larger file is left as is.
+  // Otherwise the element count is taken from the file size.
+  page_cache(std::string const& path, size_t elements_per_page, size_t max_resident_pages,
+             page_cache_mode mode = page_cache_mode::read_only, size_t element_count = 0)
+    : __elements_per_page(elements_per_page), __capacity(max_resident_pages),
+      __writable(mode != page_cache_mode::read_only)
+  {
+    if(elements_per_page == 0 || max_resident_pages == 0) {
+      throw std::invalid_argument("page_cache: page size and capacity must be nonzero");
+    }
+    const int flags = mode == page_cache_mode::create ? (O_RDWR | O_CREAT) :
+                      mode == page_cache_mode::read_write ? O_RDWR : O_RDONLY;
+    __fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if(__fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "page_cache: cannot open '" + path + "'");
+    }
+    struct stat st;
+    if(::fstat(__fd, &st) != 0) {
+      const int err = errno;
+      ::close(__fd);
+      throw std::system_error(err, std::generic_category(), "page_cache: cannot stat '" + path + "'");
+    }
+    __element_count = static_cast<size_t>(st.st_size) / sizeof(T);
+    if(mode == page_cache_mode::create && __element_count < element_count) {
+      if(::ftruncate(__fd, static_cast<off_t>(element_count * sizeof(T))) != 0) {
+        const int err = errno;
+        ::close(__fd);
+        throw std::system_error(err, std::generic_category(), "page_cache: cannot resize '" + path + "'");
+      }
+      __element_count = element_count;
+    }
+    __directory.reset(new atomic<__page*>[__page_count()]);
+    for(size_t i = 0; i < __page_count(); ++i) __directory[i].store(nullptr, memory_order_relaxed);
+  }
+
+  page_cache(page_cache const&) = delete;
+  page_cache& operator=(page_cache const&) = delete;
+
+  ~page_cache() {
+    try { flush(); } catch(...) { }
+    ::close(__fd);
+  }
+
+  size_t elements_per_page() const noexcept { return __elements_per_page; }
+  size_t capacity() const noexcept { return __capacity; }
+  size_t size() const noexcept { return __element_count; }
+  bool writable() const noexcept { return __writable; }
+
+  size_t resident_pages() const {
+    lock_guard<mutex> lock(__mutex);
+    return __resident.size();
+  }
+
+  page_cache_stats stats() const noexcept {
+    page_cache_stats s;
+    s.hits = __hits.load(memory_order_relaxed);
+    s.misses = __misses.load(memory_order_relaxed);
+    s.evictions = __evictions.load(memory_order_relaxed);
+    s.writebacks = __writebacks.load(memory_order_relaxed);
+    return s;
+  }
+
+  T load(size_t i) {
+    __page* p = __acquire(i / __elements_per_page);
+    const T value = p->data[i % __elements_per_page];
+    __unpin(p);
+    return value;
+  }
+
+  void store(size_t i, T const& value) {
+    if(!__writable) throw std::logic_error("page_cache: store to a read-only cache");
+    __page* p = __acquire(i / __elements_per_page);
+    p->data[i % __elements_per_page] = value;
+    if(!p->dirty.load(memory_order_relaxed)) p->dirty.store(true, memory_order_release);
+    __unpin(p);
+  }
+
+  // Keep page `page_index` resident until the handle is destroyed.  With
+  // `for_write` the page is marked dirty up front, so writes through
+  // handle.data() are written back.
+  page_handle pin(size_t page_index, bool for_write = false) {
+    if(for_write && !__writable) throw std::logic_error("page_cache: writable pin of a read-only cache");
+    __page* p = __acquire(page_index);
+    if(for_write) p->dirty.store(true, memory_order_relaxed);
+    return page_handle(this, p);
+  }
+
+  // Write every dirty page back to the file.
+  void flush() {
+    lock_guard<mutex> lock(__mutex);
+    for(auto& p : __resident) {
+      if(p->dirty.load(memory_order_acquire)) __write_back(*p);
+    }
+  }
+
+private:
+
+  size_t __page_count() const noexcept {
+    return (__element_count + __elements_per_page - 1) / __elements_per_page;
+  }
+
+  // Return page `page_index` resident and pinned.  A hit takes no lock: the
+  // page is pinned first and the directory entry re-checked, while eviction
+  // clears the entry first and re-checks the pin count, so (with sequentially
+  // consistent ordering on both sides) one of the two always backs off.
+  __page* __acquire(size_t page_index) {
+    if(page_index >= __page_count()) throw std::out_of_range("page_cache: page index out of range");
+    atomic<__page*>& slot = __directory[page_index];
+    __page* p = slot.load(memory_order_acquire);
+    if(p != nullptr) {
+      p->pins.fetch_add(1, memory_order_seq_cst);
+      if(slot.load(memory_order_seq_cst) == p) {
+        __touch(*p);
+        __hits.fetch_add(1, memory_order_relaxed);
+        return p;
+      }
+      __unpin(p);
+    }
+
+    lock_guard<mutex> lock(__mutex);
+    p = slot.load(memory_order_relaxed);
+    if(p != nullptr) {
+      // Loaded by another thread meanwhile; evictions hold the lock.
+      p->pins.fetch_add(1, memory_order_relaxed);
+      __touch(*p);
+      __hits.fetch_add(1, memory_order_relaxed);
+      return p;
+    }
+    __misses.fetch_add(1, memory_order_relaxed);
+    __clock.fetch_add(1, memory_order_relaxed);
+    unique_ptr<__page> fresh;
+    if(__resident.size() >= __capacity) p = __evict();
+    else {
+      fresh.reset(new __page());
+      fresh->data.reset(new T[__elements_per_page]);
+      p = fresh.get();
+    }
+    p->index = page_index;
+    p->dirty.store(false, memory_order_relaxed);
+    __read(*p);
+    if(fresh) __resident.push_back(std::move(fresh));
+    // fetch_add, not store: a stale hit may still hold a transient pin.
+    p->pins.fetch_add(1, memory_order_relaxed);
+    __touch(*p);
+    slot.store(p, memory_order_release);
+    return p;
+  }
+
+  void __touch(__page& p) noexcept {
+    // Only write the stamp when it changes, so hits on a hot page stay reads.
+    const uint64_t now = __clock.load(memory_order_relaxed);
+    if(p.last_use.load(memory_order_relaxed) != now) p.last_use.store(now, memory_order_relaxed);
+  }
+
+  // Detach the least recently used unpinned page, writing it back if needed,
+  // and return it for reuse.  Called with the lock held.
+  __page* __evict() {
+    for(size_t attempt = 0; attempt < __resident.size(); ++attempt) {
+      __page* victim = nullptr;
+      for(auto& p : __resident) {
+        if(p->pins.load(memory_order_relaxed) != 0) continue;
+        if(__directory[p->index].load(memory_order_relaxed) != p.get()) continue; // tried already
+        if(victim == nullptr || p->last_use.load(memory_order_relaxed) < victim->last_use.load(memory_order_relaxed))
+          victim = p.get();
+      }
+      if(victim == nullptr) break;
+      atomic<__page*>& slot = __directory[victim->index];
+      slot.store(nullptr, memory_order_seq_cst);
+      if(victim->pins.load(memory_order_seq_cst) != 0) {
+        // Pinned by a concurrent hit after all; try the next candidate.
+        slot.store(victim, memory_order_release);
+        continue;
+      }
+      if(victim->dirty.load(memory_order_relaxed)) {
+        try { __write_back(*victim); }
+        catch(...) { slot.store(victim, memory_order_release); throw; }
+      }
+      __evictions.fetch_add(1, memory_order_relaxed);
+      return victim;
+    }
+    throw std::runtime_error("page_cache: every resident page is pinned");
+  }
+
+  size_t __page_elements_in_file(size_t page_index) const noexcept {
+    const size_t first = page_index * __elements_per_page;
+    if(first >= __element_count) return 0;
+    const size_t remaining = __element_count - first;
+    return remaining < __elements_per_page ? remaining : __elements_per_page;
+  }
+
+  void __read(__page& p) {
+    const size_t count = __page_elements_in_file(p.index);
+    char* dst = reinterpret_cast<char*>(p.data.get());
+    const size_t bytes = count * sizeof(T);
+    size_t done = 0;
+    while(done < bytes) {
+      const ssize_t n = ::pread(__fd, dst + done, bytes - done,
+                                static_cast<off_t>(p.index * __elements_per_page * sizeof(T) + done));
+      if(n < 0) {
+        if(errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(), "page_cache: read failed");
+      }
+      if(n == 0) break;
+      done += static_cast<size_t>(n);
+    }
+    // Anything past the end of the file reads as zero bytes.
+    std::memset(dst + done, 0, __elements_per_page * sizeof(T) - done);
+  }
+
+  // The page is marked clean before it is written, so a store that lands
+  // while the write is in progress marks it dirty again for the next flush
+  // or eviction instead of being lost.
+  void __write_back(__page& p) {
+    p.dirty.exchange(false, memory_order_acq_rel);
+    const size_t count = __page_elements_in_file(p.index);
+    const char* src = reinterpret_cast<const char*>(p.data.get());
+    const size_t bytes = count * sizeof(T);
+    size_t done = 0;
+    while(done < bytes) {
+      const ssize_t n = ::pwrite(__fd, src + done, bytes - done,
+                                 static_cast<off_t>(p.index * __elements_per_page * sizeof(T) + done));
+      if(n < 0) {
+        if(errno == EINTR) continue;
+        const int error = errno;
+        p.dirty.store(true, memory_order_relaxed);
+        throw std::system_error(error, std::generic_category(), "page_cache: write failed");
+      }
+      done += static_cast<size_t>(n);
+    }
+    __writebacks.fetch_add(1, memory_order_relaxed);
+  }
+
+  // Release publishes stores to the page to whoever evicts or flushes it.
+  void __unpin(__page* p) noexcept {
+    p->pins.fetch_sub(1, memory_order_release);
+  }
+
+  size_t __elements_per_page;
+  size_t __capacity;
+  bool __writable;
+  int __fd = -1;
+  size_t __element_count = 0;
+  mutable mutex __mutex;
+  // Resident page of each page index, or null; read without the lock.
+  unique_ptr<atomic<__page*>[]> __directory;
+  std::vector<unique_ptr<__page>> __resident;
+  atomic<uint64_t> __clock{0};
+  atomic<uint64_t> __hits{0};
+  atomic<uint64_t> __misses{0};
+  atomic<uint64_t> __evictions{0};
+  atomic<uint64_t> __writebacks{0};
+};
+
+//==============================================================================
+// paged_accessor: element access through a page_cache.  The "pointer" is a
+// (cache, element offset) pair, so submdspan and layout offsets work as usual;
+// references are proxies that load and store through the cache.
+
+template <class ElementType>
+struct paged_pointer {
+  page_cache<remove_const_t<ElementType>>* cache = nullptr;
+  size_t offset = 0;
+
+  paged_pointer() noexcept = default;
+  paged_pointer(page_cache<remove_const_t<ElementType>>* c, size_t off = 0) noexcept // NOLINT(google-explicit-constructor)
+    : cache(c), offset(off)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      !_MDSPAN_TRAIT(is_same, OtherElementType, ElementType) &&
+      _MDSPAN_TRAIT(is_same, remove_const_t<OtherElementType>, remove_const_t<ElementType>) &&
+      _MDSPAN_TRAIT(is_const, ElementType)
+    )
+  )
+  paged_pointer(paged_pointer<OtherElementType> const& other) noexcept // NOLINT(google-explicit-constructor)
+    : cache(other.cache), offset(other.offset)
+  { }
+};
+
+template <class T>
+class paged_reference {
+public:
+  paged_reference(page_cache<T>* c, size_t i) noexcept : __cache(c), __index(i) { }
+  paged_reference(paged_reference const&) = default;
+
+  operator T() const { return __cache->load(__index); } // NOLINT(google-explicit-constructor)
+
+  paged_reference const& operator=(T const& v) const {
+    __cache->store(__index, v);
+    return *this;
+  }
+  paged_reference const& operator=(paged_reference const& other) const { return *this = T(other); }
+  paged_reference const& operator+=(T const& v) const { return *this = T(*this) + v; }
+  paged_reference const& operator-=(T const& v) const { return *this = T(*this) - v; }
+  paged_reference const& operator*=(T const& v) const { return *this = T(*this) * v; }
+  paged_reference const& operator/=(T const& v) const { return *this = T(*this) / v; }
+
+private:
+  page_cache<T>* __cache;
+  size_t __index;
+};
+
+template <class ElementType>
+struct paged_accessor {
+  using offset_policy = paged_accessor;
+  using element_type = ElementType;
+  using pointer = paged_pointer<ElementType>;
+  using reference = conditional_t<
+    _MDSPAN_TRAIT(is_const, ElementType),
+    remove_const_t<ElementType>,
+    paged_reference<ElementType>
+  >;
+
+  paged_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherElementType(*)[], ElementType(*)[])
+    )
+  )
+  paged_accessor(paged_accessor<OtherElementType>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  pointer offset(pointer p, size_t i) const noexcept {
+    return pointer(p.cache, p.offset + i);
+  }
+
+  reference access(pointer p, size_t i) const {
+    return __access(p.cache, p.offset + i, integral_constant<bool, _MDSPAN_TRAIT(is_const, ElementType)>{});
+  }
+
+private:
+  static reference __access(page_cache<remove_const_t<ElementType>>* c, size_t i, true_type) {
+    return c->load(i);
+  }
+  static reference __access(page_cache<remove_const_t<ElementType>>* c, size_t i, false_type) {
+    return reference(c, i);
+  }
+};
+
+template <class ElementType, class Extents, class LayoutPolicy = layout_right>
+using paged_mdspan = mdspan<ElementType, Extents, LayoutPolicy, paged_accessor<ElementType>>;
+
+// View the elements of `cache` through an mdspan with the given dynamic extents.
+template <class ElementType, class Extents, class LayoutPolicy = layout_right, class... SizeTypes>
+paged_mdspan<ElementType, Extents, LayoutPolicy>
+make_paged_mdspan(page_cache<remove_const_t<ElementType>>& cache, SizeTypes... dynamic_extents) {
+  using mapping_t = typename LayoutPolicy::template mapping<Extents>;
+  const mapping_t map{Extents(dynamic_extents...)};
+  if(map.required_span_size() > cache.size()) {
+    throw std::runtime_error("make_paged_mdspan: the cache's file is smaller than the mapping");
+  }
+  return paged_mdspan<ElementType, Extents, LayoutPolicy>(
+    paged_pointer<ElementType>(&cache), map
+  );
+}
+
+} // end namespace experimental
+} // end namespace std
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,434 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/layout_stride.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "for_each_index.hpp"
+#include "layout_copy.hpp"
+#include "parallel_backend.hpp"
+
+#include <array>
+#include <cstddef> // size_t
+#include <type_traits>
+#include <utility> // index_sequence
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// Execution policies for the mdspan algorithms below.  seq runs on the calling
+// thread; par and par_unseq split the index space across the parallel backend
+// (see parallel_backend.hpp), optionally capped at a number of threads:
+//
+//   fill(execution::par.with_threads(8), m, 0.0);
+//
+// par_unseq additionally promises that element operations may be interleaved
+// on one thread, which leaves the compiler free to vectorize the innermost
+// loop; it is otherwise scheduled like par.
+
+namespace execution {
+
+struct sequenced_policy { };
+
+struct parallel_policy {
+  size_t num_threads = 0; // 0: whatever the backend provides
+  constexpr parallel_policy with_threads(size_t n) const noexcept { return parallel_policy{n}; }
+};
+
+struct parallel_unsequenced_policy {
+  size_t num_threads = 0; // 0: whatever the backend provides
+  constexpr parallel_unsequenced_policy with_threads(size_t n) const noexcept { return parallel_unsequenced_policy{n}; }
+};
+
+_MDSPAN_INLINE_VARIABLE constexpr sequenced_policy seq{};
+_MDSPAN_INLINE_VARIABLE constexpr parallel_policy par{};
+_MDSPAN_INLINE_VARIABLE constexpr parallel_unsequenced_policy par_unseq{};
+
+template <class T> struct is_execution_policy : false_type { };
+template <> struct is_execution_policy<sequenced_policy> : true_type { };
+template <> struct is_execution_policy<parallel_policy> : true_type { };
+template <> struct is_execution_policy<parallel_unsequenced_policy> : true_type { };
+
+} // end namespace execution
+
+namespace detail {
+
+//==============================================================================
+// Work is split into slabs: contiguous ranges of the slowest-varying
+// dimension of the layout (the first for layout_right, the last for
+// layout_left, the one with the largest stride otherwise), one or a few per
+// thread.  Slab boundaries fall on whole cache lines of the written data
+// whenever the stride allows it, so two threads never store into the same
+// line.
+
+_MDSPAN_INLINE_VARIABLE constexpr size_t __parallel_cache_line = 64;
+
+constexpr size_t __gcd(size_t a, size_t b) noexcept { return b == 0 ? a : __gcd(b, a % b); }
+
+struct __slab_plan {
+  size_t dim;
+  size_t length; // indices of dim per task
+  size_t count;  // tasks
+};
+
+template <class Order>
+struct __order_front : integral_constant<size_t, 0> { };
+template <size_t D0, size_t... Ds>
+struct __order_front<index_sequence<D0, Ds...>> : integral_constant<size_t, D0> { };
+
+template <class Mapping>
+size_t __slab_dim(Mapping const& map, void*) {
+  // No static order: the dimension with the largest stride, skipping
+  // dimensions of extent 1 that would leave nothing to split.
+  constexpr size_t rank = Mapping::extents_type::rank();
+  if(!map.is_strided()) return 0;
+  size_t dim = 0;
+  bool found = false;
+  for(size_t r = 0; r < rank; ++r) {
+    if(map.extents().extent(r) > 1 && (!found || map.stride(r) > map.stride(dim))) {
+      dim = r;
+      found = true;
+    }
+  }
+  return dim;
+}
+
+template <class Mapping, class Order>
+size_t __slab_dim(Mapping const&, Order*) {
+  return __order_front<Order>::value;
+}
+
+template <class Mapping>
+__slab_plan __plan_slabs(Mapping const& map, size_t threads, size_t element_bytes) {
+  using order = typename __layout_loop_order<
+    typename Mapping::layout_type, Mapping::extents_type::rank()>::type;
+  __slab_plan plan;
+  plan.dim = __slab_dim(map, static_cast<order*>(nullptr));
+  const size_t n = map.extents().extent(plan.dim);
+  const size_t slab_bytes = map.is_strided() ? map.stride(plan.dim) * element_bytes : 0;
+  const size_t quantum = element_bytes == 0 ? 1 :
+    __parallel_cache_line / __gcd(__parallel_cache_line, slab_bytes);
+  const size_t tasks = __parallel_concurrency(threads);
+  size_t length = (n + tasks - 1) / tasks;
+  length = (length + quantum - 1) / quantum * quantum;
+  if(length == 0) length = 1;
+  plan.length = length;
+  plan.count = (n + length - 1) / length;
+  return plan;
+}
+
+// The extents of one slab: those of the mapping, with the slab dimension
+// made dynamic.
+template <class Extents, size_t Dim, class Seq = make_index_sequence<Extents::rank()>>
+struct __slab_extents;
+template <size_t... Es, size_t Dim, size_t... Is>
+struct __slab_extents<extents<Es...>, Dim, index_sequence<Is...>> {
+  using type = extents<(Is == Dim ? dynamic_extent : Es)...>;
+};
+
+template <class Box, class Extents>
+Box __slab_box(Extents const& exts, size_t dim, size_t length) {
+  array<size_t, Extents::rank()> e;
+  for(size_t r = 0; r < Extents::rank(); ++r) {
+    e[r] = r == dim ? length : exts.extent(r);
+  }
+  return Box(e);
+}
+
+// Shift slab-local indices back to the mapping's index space.
+template <class F, class Seq>
+struct __slab_body;
+template <class F, size_t... Is>
+struct __slab_body<F, index_sequence<Is...>> {
+  F& __f;
+  size_t __dim;
+  size_t __first;
+  template <class... Indices>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  void operator()(Indices... idxs) const {
+    __f((idxs + (Is == __dim ? __first : 0))...);
+  }
+};
+
+// Runs the index loop over slabs [first, last) of a mapping, in the same
+// order for_each_index(mapping, f) would use.
+template <class Mapping>
+struct __slab_runner {
+  using __extents_type = typename Mapping::extents_type;
+  using __seq = make_index_sequence<__extents_type::rank()>;
+  using __order = typename __layout_loop_order<typename Mapping::layout_type, __extents_type::rank()>::type;
+
+  Mapping const& __map;
+  size_t __dim;
+  size_t __first;
+  size_t __last;
+
+  template <class F>
+  void operator()(F& f) const {
+    __slab_body<F, __seq> body{f, __dim, __first};
+    __run(body, static_cast<__order*>(nullptr));
+  }
+
+private:
+
+  template <class Body, class Order>
+  void __run(Body& body, Order*) const {
+    using box_t = typename __slab_extents<__extents_type, __order_front<Order>::value>::type;
+    __for_each_index_ordered<Order>(
+      __slab_box<box_t>(__map.extents(), __dim, __last - __first), body);
+  }
+
+  template <class Body>
+  void __run(Body& body, void*) const {
+    using box_t = dextents<__extents_type::rank()>;
+    const auto box = __slab_box<box_t>(__map.extents(), __dim, __last - __first);
+    if(__map.is_strided()) {
+      array<size_t, __extents_type::rank()> strides;
+      for(size_t r = 0; r < __extents_type::rank(); ++r) strides[r] = __map.stride(r);
+      __for_each_index_strided(layout_stride::mapping<box_t>(box, strides), body, __seq());
+    }
+    else {
+      __for_each_index_ordered<__seq>(box, body);
+    }
+  }
+};
+
+// Call slab(task, run) for each task of the plan, where run(f) visits the
+// task's part of the index space with f(i0, ..., iN-1).  Per-task state (a
+// partial sum, say) lives in slab and is written out once at the end.
+template <class Mapping, class Slab>
+void __run_slabs(Mapping const& map, __slab_plan const& plan, size_t threads, Slab const& slab) {
+  const size_t n = map.extents().extent(plan.dim);
+  __parallel_for(plan.count, threads, [&](size_t task) {
+    const size_t first = task * plan.length;
+    const size_t last = first + plan.length < n ? first + plan.length : n;
+    slab(task, __slab_runner<Mapping>{map, plan.dim, first, last});
+  });
+}
+
+inline size_t __policy_threads(execution::parallel_policy const& p) noexcept { return p.num_threads; }
+inline size_t __policy_threads(execution::parallel_unsequenced_policy const& p) noexcept { return p.num_threads; }
+
+// for_each_index under a policy.  element_bytes is the size of the elements
+// written through the mapping (0 if none), used to keep slabs line-aligned.
+template <class Mapping, class F>
+void __for_each_index_policy(execution::sequenced_policy const&, Mapping const& map, size_t, F& f) {
+  for_each_index(map, f);
+}
+
+template <class Policy, class Mapping, class F>
+void __for_each_index_parallel(Policy const& policy, Mapping const& map, size_t element_bytes, F& f, true_type /* rank > 0 */) {
+  const size_t threads = __policy_threads(policy);
+  const __slab_plan plan = __plan_slabs(map, threads, element_bytes);
+  __run_slabs(map, plan, threads, [&](size_t, __slab_runner<Mapping> const& run) {
+    run(f);
+  });
+}
+
+template <class Policy, class Mapping, class F>
+void __for_each_index_parallel(Policy const&, Mapping const& map, size_t, F& f, false_type /* rank > 0 */) {
+  for_each_index(map, f);
+}
+
+template <class Policy, class Mapping, class F>
+void __for_each_index_policy(Policy const& policy, Mapping const& map, size_t element_bytes, F& f) {
+  __for_each_index_parallel(policy, map, element_bytes, f,
+    integral_constant<bool, (Mapping::extents_type::rank() > 0)>());
+}
+
+template <class T, class E, class L, class A, class... Indices>
+MDSPAN_INLINE_FUNCTION
+typename A::reference __element(mdspan<T, E, L, A> const& m, A const& acc, Indices... idxs) {
+  return acc.access(m.data(), m.mapping()(idxs...));
+}
+
+// copy: seq goes through the layout-pair dispatch of copy(src, dst).
+template <class InMDSpan, class OutMDSpan>
+void __copy_policy(execution::sequenced_policy const&, InMDSpan const& src, OutMDSpan const& dst) {
+  __copy_dispatch(src, dst, __copy_is_raw<InMDSpan, OutMDSpan>());
+}
+
+template <class Policy, class InMDSpan, class OutMDSpan>
+void __copy_policy(Policy const& policy, InMDSpan const& src, OutMDSpan const& dst) {
+  const auto src_acc = src.accessor();
+  const auto dst_acc = dst.accessor();
+  auto body = [&](auto... idxs) {
+    __element(dst, dst_acc, idxs...) = __element(src, src_acc, idxs...);
+  };
+  __for_each_index_policy(policy, dst.mapping(), sizeof(typename OutMDSpan::element_type), body);
+}
+
+} // end namespace detail
+
+//==============================================================================
+// Algorithms.  The index space is traversed in layout order (stride-1
+// dimension innermost) and, for par / par_unseq, split into line-aligned slabs
+// along the slowest-varying dimension of the written mdspan.  As with the
+// standard parallel algorithms, element functions must not throw.  Input and
+// output mdspans must have equal extents.  reduce and reduce_axis are in
+// reduce.hpp.
+
+// f(i0, ..., iN-1) for every index of the space.
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class Extents, class F,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_extents_v<Extents>)
+)
+void for_each_index(ExecutionPolicy const& policy, Extents const& exts, F f) {
+  detail::__for_each_index_policy(policy, layout_right::mapping<Extents>(exts), 0, f);
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class Mapping, class F,
+  /* requires */ (
+    execution::is_execution_policy<ExecutionPolicy>::value &&
+    !detail::__is_extents_v<Mapping> &&
+    !detail::__is_mdspan<Mapping>::value &&
+    detail::__is_extents_v<typename Mapping::extents_type>
+  )
+)
+void for_each_index(ExecutionPolicy const& policy, Mapping const& map, F f) {
+  detail::__for_each_index_policy(policy, map, 0, f);
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan, class F,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value)
+)
+void for_each_index(ExecutionPolicy const& policy, MDSpan const& m, F f) {
+  detail::__for_each_index_policy(policy, m.mapping(), sizeof(typename MDSpan::element_type), f);
+}
+
+// f(m[i]) for every element.
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan, class F,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value)
+)
+void for_each(ExecutionPolicy const& policy, MDSpan m, F f) {
+  const auto acc = m.accessor();
+  auto body = [&](auto... idxs) { f(detail::__element(m, acc, idxs...)); };
+  detail::__for_each_index_policy(policy, m.mapping(), sizeof(typename MDSpan::element_type), body);
+}
+
+// out[i] = f(in[i])
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class InMDSpan, class OutMDSpan, class F,
+  /* requires */ (
+    execution::is_execution_policy<ExecutionPolicy>::value &&
+    detail::__is_mdspan<InMDSpan>::value && detail::__is_mdspan<OutMDSpan>::value
+  )
+)
+void transform(ExecutionPolicy const& policy, InMDSpan in, OutMDSpan out, F f) {
+  static_assert(InMDSpan::extents_type::rank() == OutMDSpan::extents_type::rank() &&
+    detail::__static_extents_match<typename InMDSpan::extents_type, typename OutMDSpan::extents_type>(),
+    "std::experimental::transform requires matching extents.");
+  _MDSPAN_CHECK_EXTENTS("transform", in.extents(), out.extents());
+  const auto in_acc = in.accessor();
+  const auto out_acc = out.accessor();
+  auto body = [&](auto... idxs) {
+    detail::__element(out, out_acc, idxs...) = f(detail::__element(in, in_acc, idxs...));
+  };
+  detail::__for_each_index_policy(policy, out.mapping(), sizeof(typename OutMDSpan::element_type), body);
+}
+
+// out[i] = f(in1[i], in2[i])
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class InMDSpan1, class InMDSpan2, class OutMDSpan, class F,
+  /* requires */ (
+    execution::is_execution_policy<ExecutionPolicy>::value &&
+    detail::__is_mdspan<InMDSpan1>::value && detail::__is_mdspan<InMDSpan2>::value &&
+    detail::__is_mdspan<OutMDSpan>::value
+  )
+)
+void transform(ExecutionPolicy const& policy, InMDSpan1 in1, InMDSpan2 in2, OutMDSpan out, F f) {
+  static_assert(InMDSpan1::extents_type::rank() == OutMDSpan::extents_type::rank() &&
+    InMDSpan2::extents_type::rank() == OutMDSpan::extents_type::rank() &&
+    detail::__static_extents_match<typename InMDSpan1::extents_type, typename OutMDSpan::extents_type>() &&
+    detail::__static_extents_match<typename InMDSpan2::extents_type, typename OutMDSpan::extents_type>(),
+    "std::experimental::transform requires matching extents.");
+  _MDSPAN_CHECK_EXTENTS("transform", in1.extents(), out.extents());
+  _MDSPAN_CHECK_EXTENTS("transform", in2.extents(), out.extents());
+  const auto acc1 = in1.accessor();
+  const auto acc2 = in2.accessor();
+  const auto out_acc = out.accessor();
+  auto body = [&](auto... idxs) {
+    detail::__element(out, out_acc, idxs...) =
+      f(detail::__element(in1, acc1, idxs...), detail::__element(in2, acc2, idxs...));
+  };
+  detail::__for_each_index_policy(policy, out.mapping(), sizeof(typename OutMDSpan::element_type), body);
+}
+
+// m[i] = value
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan, class Value,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value)
+)
+void fill(ExecutionPolicy const& policy, MDSpan m, Value const& value) {
+  const auto acc = m.accessor();
+  auto body = [&](auto... idxs) { detail::__element(m, acc, idxs...) = value; };
+  detail::__for_each_index_policy(policy, m.mapping(), sizeof(typename MDSpan::element_type), body);
+}
+
+// dst[i] = src[i]
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class InMDSpan, class OutMDSpan,
+  /* requires */ (
+    execution::is_execution_policy<ExecutionPolicy>::value &&
+    detail::__is_mdspan<InMDSpan>::value && detail::__is_mdspan<OutMDSpan>::value
+  )
+)
+void copy(ExecutionPolicy const& policy, InMDSpan src, OutMDSpan dst) {
+  static_assert(InMDSpan::extents_type::rank() == OutMDSpan::extents_type::rank() &&
+    detail::__static_extents_match<typename InMDSpan::extents_type, typename OutMDSpan::extents_type>(),
+    "std::experimental::copy requires matching extents.");
+  _MDSPAN_CHECK_EXTENTS("copy", src.extents(), dst.extents());
+  detail::__copy_policy(policy, src, dst);
+}
+
+} // end namespace experimental
+} // end namespace std
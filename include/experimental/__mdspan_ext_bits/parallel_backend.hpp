@@ -0,0 +1,254 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // size_t
+#include <exception> // exception_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Run the parallel algorithms on OpenMP threads when the translation unit is
+// built with OpenMP, otherwise on the library's own thread pool.  Define to 0
+// to use the thread pool even under OpenMP.
+#ifndef MDSPAN_PARALLEL_USE_OPENMP
+#  if defined(_OPENMP)
+#    define MDSPAN_PARALLEL_USE_OPENMP 1
+#  else
+#    define MDSPAN_PARALLEL_USE_OPENMP 0
+#  endif
+#endif
+
+#if MDSPAN_PARALLEL_USE_OPENMP && defined(_OPENMP)
+#  include <omp.h>
+#endif
+
+namespace std {
+namespace experimental {
+namespace detail {
+
+//==============================================================================
+// A fixed set of worker threads that run the iterations of one indexed loop
+// at a time.  The calling thread takes part, and a loop started from inside a
+// running loop (a nested parallel algorithm) runs inline rather than waiting
+// on the pool it already occupies.  If a body throws, no further iterations
+// are started, run() waits for the iterations already running, and the first
+// exception is rethrown on the calling thread.
+
+class __thread_pool {
+public:
+
+  explicit __thread_pool(size_t threads) {
+    for(size_t t = 1; t < threads; ++t) {
+      __workers.emplace_back([this] { __work(); });
+    }
+  }
+
+  __thread_pool(__thread_pool const&) = delete;
+  __thread_pool& operator=(__thread_pool const&) = delete;
+
+  ~__thread_pool() {
+    {
+      lock_guard<mutex> lock(__mutex);
+      __stop = true;
+    }
+    __wake.notify_all();
+    for(auto& w : __workers) w.join();
+  }
+
+  // The pool shared by all parallel algorithms, one thread per hardware thread.
+  static __thread_pool& instance() {
+    static __thread_pool pool(thread::hardware_concurrency() == 0 ? 1 : thread::hardware_concurrency());
+    return pool;
+  }
+
+  size_t size() const noexcept { return __workers.size() + 1; }
+
+  // Call body(i) once for every i in [0, count), in no particular order.
+  template <class Body>
+  void run(size_t count, Body const& body) {
+    if(count == 0) return;
+    if(count == 1 || __workers.empty() || __in_loop()) {
+      for(size_t i = 0; i < count; ++i) body(i);
+      return;
+    }
+    lock_guard<mutex> one_loop_at_a_time(__run_mutex);
+    {
+      lock_guard<mutex> lock(__mutex);
+      __body = &body;
+      __invoke = &__invoke_body<Body>;
+      __count = count;
+      __next.store(0, memory_order_relaxed);
+      __active = __workers.size();
+      ++__generation;
+    }
+    __wake.notify_all();
+    __in_loop() = true;
+    __drain();
+    __in_loop() = false;
+    unique_lock<mutex> lock(__mutex);
+    __done.wait(lock, [this] { return __active == 0; });
+    // Only now is nobody running the body any more.
+    if(__error) {
+      exception_ptr error = std::move(__error);
+      __error = nullptr;
+      lock.unlock();
+      rethrow_exception(error);
+    }
+  }
+
+private:
+
+  template <class Body>
+  static void __invoke_body(void const* body, size_t i) {
+    (*static_cast<Body const*>(body))(i);
+  }
+
+  static bool& __in_loop() noexcept {
+    static thread_local bool flag = false;
+    return flag;
+  }
+
+  void __drain() noexcept {
+    try {
+      for(size_t i = __next.fetch_add(1, memory_order_relaxed); i < __count;
+          i = __next.fetch_add(1, memory_order_relaxed)) {
+        __invoke(__body, i);
+      }
+    }
+    catch(...) {
+      // Keep the first exception and hand out no more iterations.
+      __next.store(__count, memory_order_relaxed);
+      lock_guard<mutex> lock(__mutex);
+      if(!__error) __error = current_exception();
+    }
+  }
+
+  void __work() {
+    __in_loop() = true;
+    size_t seen = 0;
+    unique_lock<mutex> lock(__mutex);
+    while(true) {
+      __wake.wait(lock, [&] { return __stop || __generation != seen; });
+      if(__stop) return;
+      seen = __generation;
+      lock.unlock();
+      __drain();
+      lock.lock();
+      if(--__active == 0) __done.notify_one();
+    }
+  }
+
+  mutex __mutex;
+  mutex __run_mutex;
+  condition_variable __wake;
+  condition_variable __done;
+  void const* __body = nullptr;
+  void (*__invoke)(void const*, size_t) = nullptr;
+  size_t __count = 0;
+  atomic<size_t> __next{0};
+  size_t __active = 0;
+  size_t __generation = 0;
+  exception_ptr __error;
+  bool __stop = false;
+  vector<thread> __workers;
+};
+
+//==============================================================================
+// Backend entry points used by the parallel algorithms.
+
+// Number of threads a loop gets when the policy does not ask for a number.
+inline size_t __parallel_concurrency(size_t requested) {
+  if(requested != 0) return requested;
+#if MDSPAN_PARALLEL_USE_OPENMP && defined(_OPENMP)
+  return size_t(omp_get_max_threads());
+#else
+  return __thread_pool::instance().size();
+#endif
+}
+
+// Call body(i) once for every i in [0, count), spread over at most `threads`
+// threads (0: the backend default).
+template <class Body>
+void __parallel_for(size_t count, size_t threads, Body const& body) {
+  if(count <= 1) {
+    if(count == 1) body(size_t(0));
+    return;
+  }
+#if MDSPAN_PARALLEL_USE_OPENMP && defined(_OPENMP)
+  // Exceptions must not leave the parallel region; the first one is
+  // rethrown after it, as with the thread pool.
+  const int nthreads = int(__parallel_concurrency(threads));
+  const long n = long(count);
+  exception_ptr error;
+  atomic<bool> failed{false};
+  #pragma omp parallel for schedule(static) num_threads(nthreads)
+  for(long i = 0; i < n; ++i) {
+    if(failed.load(memory_order_relaxed)) continue;
+    try {
+      body(size_t(i));
+    }
+    catch(...) {
+      #pragma omp critical(__mdspan_parallel_for_error)
+      {
+        if(!error) error = current_exception();
+      }
+      failed.store(true, memory_order_relaxed);
+    }
+  }
+  if(error) rethrow_exception(error);
+#else
+  (void)threads;
+  __thread_pool::instance().run(count, body);
+#endif
+}
+
+} // end namespace detail
+} // end namespace experimental
+} // end namespace std
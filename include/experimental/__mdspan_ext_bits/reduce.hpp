@@ -0,0 +1,635 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/bounds_check.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "for_each_index.hpp"
+#include "parallel_algorithms.hpp"
+#include "parallel_backend.hpp"
+
+#include <array>
+#include <cstddef> // size_t
+#include <functional> // plus
+#include <type_traits>
+#include <utility> // index_sequence
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// reduce(m, init, op) and reduce_axis<R>(src, dst, init, op), with or without
+// an execution policy.  op must be associative and commutative.
+//
+// Elements are read a line at a time along the stride-1 dimension and dealt
+// round-robin to several independent accumulators (128 bytes of them: four
+// AVX or eight SSE registers of floats), so a floating-point sum is not held
+// to the latency of a single add chain and the line loop vectorizes.  The
+// accumulators are folded in a fixed pairwise tree at the end.
+//
+// Under par the index space is split into one slab per thread, so how the
+// elements are grouped -- and for floating point the last bits of the
+// result -- depends on the thread count.  Passing `deterministic` fixes the
+// grouping: the space is cut into blocks that depend only on the extents and
+// the layout, and the block results are combined in a fixed pairwise tree,
+// which makes the result bitwise identical for seq, par and any number of
+// threads:
+//
+//   float s = reduce(execution::par, m, 0.f, plus<>(), deterministic);
+//
+// reduce_axis<R> writes dst[j0, ..., jN-2] = init op src[..., i, ...] over
+// every i of dimension R, where dst has the extents of src without R.  Each
+// dst element is computed by one thread in a fixed order, so reduce_axis is
+// reproducible without asking.
+
+struct deterministic_t { explicit deterministic_t() = default; };
+_MDSPAN_INLINE_VARIABLE constexpr auto deterministic = deterministic_t{ };
+
+namespace detail {
+
+// Elements per block of a deterministic reduction.
+_MDSPAN_INLINE_VARIABLE constexpr size_t __reduce_block = size_t(1) << 14;
+
+template <class Value>
+struct __reduce_lanes : integral_constant<size_t,
+  (128 / sizeof(Value) < 4 ? 4 : (128 / sizeof(Value) > 32 ? 32 : 128 / sizeof(Value)))
+> { };
+
+template <size_t, class Value>
+MDSPAN_INLINE_FUNCTION
+Value const& __repeat(Value const& v) noexcept { return v; }
+
+// Independent partial results for one reduction.  Lanes are seeded with the
+// first elements, so op needs no identity.
+template <class Value, size_t Lanes = __reduce_lanes<Value>::value>
+class __lane_accumulator {
+public:
+
+  explicit __lane_accumulator(Value const& init)
+    : __lane_accumulator(init, make_index_sequence<Lanes>())
+  { }
+
+  bool empty() const noexcept { return __filled == 0; }
+
+  // n elements, stride apart
+  template <class T, class BinaryOp>
+  void add(T const* p, size_t n, size_t stride, BinaryOp const& op) {
+    if(stride == 1) __add_line(p, n, integral_constant<size_t, 1>(), op);
+    else __add_line(p, n, stride, op);
+  }
+
+  template <class Element, class BinaryOp>
+  void add_one(Element&& e, BinaryOp const& op) {
+    if(__filled < Lanes) {
+      __acc[__filled++] = static_cast<Value>(e);
+      return;
+    }
+    __acc[__next] = op(__acc[__next], static_cast<Element&&>(e));
+    if(++__next == Lanes) __next = 0;
+  }
+
+  // The lanes folded pairwise; requires !empty().
+  template <class BinaryOp>
+  Value combine(BinaryOp const& op) {
+    for(size_t width = 1; width < __filled; width *= 2) {
+      for(size_t l = 0; l + width < __filled; l += 2 * width) {
+        __acc[l] = op(__acc[l], __acc[l + width]);
+      }
+    }
+    return __acc[0];
+  }
+
+  template <class BinaryOp>
+  Value result(Value const& init, BinaryOp const& op) {
+    return empty() ? init : op(init, combine(op));
+  }
+
+private:
+
+  template <size_t... Is>
+  __lane_accumulator(Value const& init, index_sequence<Is...>)
+    : __acc{__repeat<Is>(init)...}
+  { }
+
+  template <class T, class Stride, class BinaryOp>
+  void __add_line(T const* p, size_t n, Stride stride, BinaryOp const& op) {
+    size_t i = 0;
+    for(; __filled < Lanes && i < n; ++i) __acc[__filled++] = static_cast<Value>(p[i * stride]);
+    for(; i + Lanes <= n; i += Lanes) {
+      for(size_t l = 0; l < Lanes; ++l) __acc[l] = op(__acc[l], p[(i + l) * stride]);
+    }
+    for(size_t l = 0; i < n; ++i, ++l) __acc[l] = op(__acc[l], p[i * stride]);
+  }
+
+  Value __acc[Lanes];
+  size_t __filled = 0;
+  size_t __next = 0;
+};
+
+template <class Mapping, size_t N, size_t... Is>
+MDSPAN_INLINE_FUNCTION
+size_t __offset(Mapping const& map, array<size_t, N> const& idx, index_sequence<Is...>) {
+  return size_t(map(idx[Is]...));
+}
+
+template <class Mapping, size_t N>
+MDSPAN_INLINE_FUNCTION
+size_t __offset(Mapping const& map, array<size_t, N> const& idx) {
+  return __offset(map, idx, make_index_sequence<N>());
+}
+
+// Dimensions of the box [lo, hi) from outermost to innermost: by decreasing
+// stride for strided mappings, with dimensions of length 1 outermost so the
+// innermost one has something to loop over; row-major otherwise.
+template <class Mapping, size_t Rank>
+array<size_t, Rank> __line_order(Mapping const& map, array<size_t, Rank> const& lo, array<size_t, Rank> const& hi) {
+  array<size_t, Rank> order;
+  for(size_t r = 0; r < Rank; ++r) order[r] = r;
+  if(!map.is_strided()) return order;
+  auto outer = [&](size_t a, size_t b) {
+    const bool a_flat = hi[a] - lo[a] <= 1, b_flat = hi[b] - lo[b] <= 1;
+    return a_flat != b_flat ? a_flat : map.stride(a) > map.stride(b);
+  };
+  for(size_t a = 1; a < Rank; ++a) {
+    for(size_t b = a; b > 0 && outer(order[b], order[b - 1]); --b) {
+      const size_t t = order[b]; order[b] = order[b - 1]; order[b - 1] = t;
+    }
+  }
+  return order;
+}
+
+// line(idx, d, n) for every line of the box [lo, hi) along the innermost
+// dimension d of __line_order, idx being the line's first index.  With
+// coalesce, outer dimensions that continue the line at the same stride are
+// folded into it (a packed box is then a single line of n > extent(d)).
+template <class Mapping, size_t Rank, class Line>
+void __for_each_line(Mapping const& map, array<size_t, Rank> const& lo, array<size_t, Rank> const& hi,
+                     Line&& line, bool coalesce = false) {
+  for(size_t r = 0; r < Rank; ++r) if(hi[r] <= lo[r]) return;
+  const array<size_t, Rank> order = __line_order(map, lo, hi);
+  const size_t d = order[Rank - 1];
+  size_t n = hi[d] - lo[d];
+  size_t levels = Rank - 1;
+  if(coalesce && map.is_strided()) {
+    for(; levels > 0; --levels) {
+      const size_t r = order[levels - 1];
+      if(hi[r] - lo[r] > 1 && size_t(map.stride(r)) != size_t(map.stride(d)) * n) break;
+      n *= hi[r] - lo[r];
+    }
+  }
+  array<size_t, Rank> idx = lo;
+  while(true) {
+    line(idx, d, n);
+    size_t level = levels;
+    while(level-- > 0) {
+      const size_t r = order[level];
+      if(++idx[r] < hi[r]) break;
+      idx[r] = lo[r];
+    }
+    if(level == size_t(-1)) return;
+  }
+}
+
+template <class MDSpan>
+struct __reduce_is_raw : integral_constant<bool,
+  _MDSPAN_TRAIT(is_same, typename MDSpan::accessor_type, default_accessor<typename MDSpan::element_type>)
+> { };
+
+// Add the elements of the box [lo, hi) of m to the lanes.
+template <class MDSpan, size_t Rank, class Lanes, class BinaryOp>
+void __reduce_box(MDSpan const& m, array<size_t, Rank> const& lo, array<size_t, Rank> const& hi,
+                  Lanes& lanes, BinaryOp const& op, false_type /* raw */) {
+  auto const& map = m.mapping();
+  const auto acc = m.accessor();
+  __for_each_line(map, lo, hi, [&](array<size_t, Rank> idx, size_t d, size_t n) {
+    for(size_t i = 0; i < n; ++i, ++idx[d]) lanes.add_one(acc.access(m.data(), __offset(map, idx)), op);
+  });
+}
+
+template <class MDSpan, size_t Rank, class Lanes, class BinaryOp>
+void __reduce_box(MDSpan const& m, array<size_t, Rank> const& lo, array<size_t, Rank> const& hi,
+                  Lanes& lanes, BinaryOp const& op, true_type /* raw */) {
+  auto const& map = m.mapping();
+  if(!map.is_strided()) {
+    __reduce_box(m, lo, hi, lanes, op, false_type());
+    return;
+  }
+  __for_each_line(map, lo, hi, [&](array<size_t, Rank> const& idx, size_t d, size_t n) {
+    lanes.add(m.data() + __offset(map, idx), n, size_t(map.stride(d)), op);
+  }, true);
+}
+
+// The part of the index space a task covers: all of it, except [first,
+// first + length) of dimension dim.
+template <class Extents>
+struct __reduce_task_boxes {
+  static constexpr size_t __rank = Extents::rank();
+  array<size_t, __rank> __hi;
+  __slab_plan __plan;
+
+  void box(size_t task, array<size_t, __rank>& lo, array<size_t, __rank>& hi) const {
+    for(size_t r = 0; r < __rank; ++r) lo[r] = 0;
+    hi = __hi;
+    lo[__plan.dim] = task * __plan.length;
+    if(lo[__plan.dim] + __plan.length < hi[__plan.dim]) hi[__plan.dim] = lo[__plan.dim] + __plan.length;
+  }
+};
+
+template <class Extents, size_t... Is>
+__reduce_task_boxes<Extents> __task_boxes(Extents const& exts, __slab_plan const& plan, index_sequence<Is...>) {
+  return __reduce_task_boxes<Extents>{{{size_t(exts.extent(Is))...}}, plan};
+}
+
+// Blocks of about __reduce_block elements along the slab dimension of the
+// layout; a function of the extents and layout only.
+template <class Mapping>
+__slab_plan __plan_deterministic(Mapping const& map) {
+  using order = typename __layout_loop_order<
+    typename Mapping::layout_type, Mapping::extents_type::rank()>::type;
+  __slab_plan plan;
+  plan.dim = __slab_dim(map, static_cast<order*>(nullptr));
+  size_t cross = 1;
+  for(size_t r = 0; r < Mapping::extents_type::rank(); ++r) {
+    if(r != plan.dim) cross *= map.extents().extent(r);
+  }
+  const size_t n = map.extents().extent(plan.dim);
+  plan.length = __reduce_block / cross == 0 ? 1 : __reduce_block / cross;
+  plan.count = (n + plan.length - 1) / plan.length;
+  return plan;
+}
+
+template <class Value, class BinaryOp>
+Value __tree_combine(Value const* v, size_t n, BinaryOp const& op) {
+  if(n == 1) return v[0];
+  const size_t half = n / 2;
+  return op(__tree_combine(v, half, op), __tree_combine(v + half, n - half, op));
+}
+
+// body(task) for every task: in order under seq, on the backend otherwise.
+template <class Body>
+void __run_tasks(execution::sequenced_policy const&, size_t count, Body const& body) {
+  for(size_t t = 0; t < count; ++t) body(t);
+}
+
+template <class Policy, class Body>
+void __run_tasks(Policy const& policy, size_t count, Body const& body) {
+  __parallel_for(count, __policy_threads(policy), body);
+}
+
+template <class MDSpan, class Value, class BinaryOp>
+Value __reduce_whole(MDSpan const& m, Value init, BinaryOp const& op) {
+  using extents_type = typename MDSpan::extents_type;
+  constexpr size_t rank = extents_type::rank();
+  const auto boxes = __task_boxes(m.extents(), __slab_plan{0, m.extent(0), 1}, make_index_sequence<rank>());
+  array<size_t, rank> lo, hi;
+  boxes.box(0, lo, hi);
+  __lane_accumulator<Value> lanes(init);
+  __reduce_box(m, lo, hi, lanes, op, __reduce_is_raw<MDSpan>());
+  return lanes.result(init, op);
+}
+
+// One partial per task of plan; every task is non-empty.
+template <class Policy, class MDSpan, class Value, class BinaryOp>
+vector<Value> __reduce_partials(Policy const& policy, MDSpan const& m, __slab_plan const& plan,
+                                Value const& init, BinaryOp const& op) {
+  constexpr size_t rank = MDSpan::extents_type::rank();
+  const auto boxes = __task_boxes(m.extents(), plan, make_index_sequence<rank>());
+  vector<Value> partials(plan.count, init);
+  __run_tasks(policy, plan.count, [&](size_t task) {
+    array<size_t, rank> lo, hi;
+    boxes.box(task, lo, hi);
+    __lane_accumulator<Value> lanes(init);
+    __reduce_box(m, lo, hi, lanes, op, __reduce_is_raw<MDSpan>());
+    partials[task] = lanes.combine(op);
+  });
+  return partials;
+}
+
+template <class MDSpan, class Value, class BinaryOp>
+Value __reduce_policy(execution::sequenced_policy const&, MDSpan const& m, Value init, BinaryOp const& op, true_type /* rank > 0 */) {
+  return __reduce_whole(m, init, op);
+}
+
+template <class Policy, class MDSpan, class Value, class BinaryOp>
+Value __reduce_policy(Policy const& policy, MDSpan const& m, Value init, BinaryOp const& op, true_type /* rank > 0 */) {
+  if(m.size() == 0) return init;
+  const size_t threads = __policy_threads(policy);
+  const __slab_plan plan = __plan_slabs(m.mapping(), threads, 0);
+  if(plan.count == 1) return __reduce_whole(m, init, op);
+  const vector<Value> partials = __reduce_partials(policy, m, plan, init, op);
+  Value result = init;
+  for(size_t t = 0; t < plan.count; ++t) result = op(result, partials[t]);
+  return result;
+}
+
+template <class Policy, class MDSpan, class Value, class BinaryOp>
+Value __reduce_deterministic(Policy const& policy, MDSpan const& m, Value init, BinaryOp const& op, true_type /* rank > 0 */) {
+  if(m.size() == 0) return init;
+  const __slab_plan plan = __plan_deterministic(m.mapping());
+  const vector<Value> partials = __reduce_partials(policy, m, plan, init, op);
+  return op(init, __tree_combine(partials.data(), plan.count, op));
+}
+
+template <class MDSpan, class Value, class BinaryOp>
+Value __reduce_scalar(MDSpan const& m, Value init, BinaryOp const& op) {
+  return op(init, m.accessor().access(m.data(), m.mapping()()));
+}
+
+template <class Policy, class MDSpan, class Value, class BinaryOp>
+Value __reduce_policy(Policy const&, MDSpan const& m, Value init, BinaryOp const& op, false_type /* rank > 0 */) {
+  return __reduce_scalar(m, init, op);
+}
+
+template <class Policy, class MDSpan, class Value, class BinaryOp>
+Value __reduce_deterministic(Policy const&, MDSpan const& m, Value init, BinaryOp const& op, false_type /* rank > 0 */) {
+  return __reduce_scalar(m, init, op);
+}
+
+//------------------------------------------------------------------------------
+// reduce_axis
+
+// The dst index of a src index: idx without dimension R.
+template <size_t R, class Mapping, size_t N, size_t... Is>
+MDSPAN_INLINE_FUNCTION
+size_t __offset_without(Mapping const& map, array<size_t, N> const& idx, index_sequence<Is...>) {
+  return size_t(map(idx[Is < R ? Is : Is + 1]...));
+}
+
+template <size_t R, class Mapping, size_t N>
+MDSPAN_INLINE_FUNCTION
+size_t __offset_without(Mapping const& map, array<size_t, N> const& idx) {
+  return __offset_without<R>(map, idx, make_index_sequence<N - 1>());
+}
+
+// dst's static extents agree with src's with dimension R removed.
+template <size_t R, class SrcExtents, class DstExtents>
+MDSPAN_INLINE_FUNCTION
+constexpr bool __reduce_axis_extents_match(size_t r = 0) noexcept {
+  return r >= DstExtents::rank() ||
+    (__static_extent_match(SrcExtents::static_extent(r < R ? r : r + 1), DstExtents::static_extent(r)) &&
+     __reduce_axis_extents_match<R, SrcExtents, DstExtents>(r + 1));
+}
+
+// Stride-1 loops get their own instantiation so they vectorize.
+template <class T, class U, class DstStride, class SrcStride, class BinaryOp>
+void __accumulate_strided(T* q, DstStride qs, U const* p, SrcStride ps, size_t n, BinaryOp const& op) {
+  for(size_t i = 0; i < n; ++i) q[i * qs] = op(q[i * qs], p[i * ps]);
+}
+
+template <class T, class U, class BinaryOp>
+void __accumulate_line(T* q, size_t qs, U const* p, size_t ps, size_t n, BinaryOp const& op) {
+  if(qs == 1 && ps == 1) __accumulate_strided(q, integral_constant<size_t, 1>(), p, integral_constant<size_t, 1>(), n, op);
+  else __accumulate_strided(q, qs, p, ps, n, op);
+}
+
+// The box [lo, hi) of src, which spans all of dimension R.
+template <size_t R, class Src, class Dst, size_t Rank, class Value, class BinaryOp>
+void __reduce_axis_box(Src const& src, Dst const& dst, array<size_t, Rank> const& lo, array<size_t, Rank> const& hi,
+                       Value const& init, BinaryOp const& op, false_type /* raw */) {
+  auto const& sm = src.mapping();
+  auto const& dm = dst.mapping();
+  const auto sa = src.accessor();
+  const auto da = dst.accessor();
+  array<size_t, Rank> first = hi;
+  first[R] = lo[R] + 1;
+  __for_each_line(sm, lo, first, [&](array<size_t, Rank> idx, size_t d, size_t n) {
+    for(size_t i = 0; i < n; ++i, ++idx[d]) da.access(dst.data(), __offset_without<R>(dm, idx)) = init;
+  });
+  __for_each_line(sm, lo, hi, [&](array<size_t, Rank> idx, size_t d, size_t n) {
+    for(size_t i = 0; i < n; ++i, ++idx[d]) {
+      auto&& out = da.access(dst.data(), __offset_without<R>(dm, idx));
+      out = op(out, sa.access(src.data(), __offset(sm, idx)));
+    }
+  });
+}
+
+template <size_t R, class Src, class Dst, size_t Rank, class Value, class BinaryOp>
+void __reduce_axis_box(Src const& src, Dst const& dst, array<size_t, Rank> const& lo, array<size_t, Rank> const& hi,
+                       Value const& init, BinaryOp const& op, true_type /* raw */) {
+  auto const& sm = src.mapping();
+  auto const& dm = dst.mapping();
+  if(!sm.is_strided() || !dm.is_strided()) {
+    __reduce_axis_box<R>(src, dst, lo, hi, init, op, false_type());
+    return;
+  }
+  using dst_value = typename Dst::element_type;
+  if(__line_order(sm, lo, hi)[Rank - 1] == R) {
+    // R is the stride-1 dimension: one lane reduction per dst element.
+    __for_each_line(sm, lo, hi, [&](array<size_t, Rank> const& idx, size_t d, size_t n) {
+      __lane_accumulator<Value> lanes(init);
+      lanes.add(src.data() + __offset(sm, idx), n, size_t(sm.stride(d)), op);
+      dst.data()[__offset_without<R>(dm, idx)] = static_cast<dst_value>(lanes.result(init, op));
+    });
+    return;
+  }
+  // Otherwise sweep src in layout order and accumulate each line into the
+  // matching dst line; the dst elements are the independent accumulators.
+  array<size_t, Rank> first = hi;
+  first[R] = lo[R] + 1;
+  __for_each_line(sm, lo, first, [&](array<size_t, Rank> const& idx, size_t d, size_t n) {
+    dst_value* q = dst.data() + __offset_without<R>(dm, idx);
+    const size_t qs = dm.stride(d < R ? d : d - 1);
+    for(size_t i = 0; i < n; ++i) q[i * qs] = static_cast<dst_value>(init);
+  });
+  __for_each_line(sm, lo, hi, [&](array<size_t, Rank> const& idx, size_t d, size_t n) {
+    __accumulate_line(dst.data() + __offset_without<R>(dm, idx), size_t(dm.stride(d < R ? d : d - 1)),
+                      src.data() + __offset(sm, idx), size_t(sm.stride(d)), n, op);
+  });
+}
+
+// Tasks split the outermost dimension other than R, so no two tasks write
+// the same dst element.
+template <size_t R, class Mapping>
+__slab_plan __plan_reduce_axis(Mapping const& map, size_t tasks) {
+  constexpr size_t rank = Mapping::extents_type::rank();
+  size_t dim = R;
+  for(size_t r = 0; r < rank; ++r) {
+    if(r == R || map.extents().extent(r) <= 1) continue;
+    if(dim == R || (map.is_strided() && map.stride(r) > map.stride(dim))) dim = r;
+  }
+  if(dim == R) tasks = 1;
+  const size_t n = map.extents().extent(dim);
+  const size_t length = (n + tasks - 1) / tasks;
+  return __slab_plan{dim, length, (n + length - 1) / length};
+}
+
+template <class Policy>
+size_t __policy_tasks(Policy const& policy) { return __parallel_concurrency(__policy_threads(policy)); }
+inline size_t __policy_tasks(execution::sequenced_policy const&) { return 1; }
+
+template <size_t R, class Policy, class Src, class Dst, class Value, class BinaryOp>
+void __reduce_axis(Policy const& policy, Src const& src, Dst const& dst, Value const& init, BinaryOp const& op) {
+  constexpr size_t rank = Src::extents_type::rank();
+  if(src.extent(R) == 0) {
+    const auto da = dst.accessor();
+    for_each_index(dst.mapping(), [&](auto... idxs) {
+      da.access(dst.data(), dst.mapping()(idxs...)) = init;
+    });
+    return;
+  }
+  const __slab_plan plan = __plan_reduce_axis<R>(src.mapping(), __policy_tasks(policy));
+  const auto boxes = __task_boxes(src.extents(), plan, make_index_sequence<rank>());
+  using raw = integral_constant<bool, __reduce_is_raw<Src>::value && __reduce_is_raw<Dst>::value>;
+  __run_tasks(policy, plan.count, [&](size_t task) {
+    array<size_t, rank> lo, hi;
+    boxes.box(task, lo, hi);
+    __reduce_axis_box<R>(src, dst, lo, hi, init, op, raw());
+  });
+}
+
+} // end namespace detail
+
+//==============================================================================
+// reduce: init op m[i0] op m[i1] op ..., grouped as described above.
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan, class Value, class BinaryOp,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value)
+)
+Value reduce(ExecutionPolicy const& policy, MDSpan m, Value init, BinaryOp op) {
+  return detail::__reduce_policy(policy, m, init, op,
+    integral_constant<bool, (MDSpan::extents_type::rank() > 0)>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan, class Value,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value)
+)
+Value reduce(ExecutionPolicy const& policy, MDSpan m, Value init) {
+  return reduce(policy, m, init, plus<>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value)
+)
+typename MDSpan::value_type reduce(ExecutionPolicy const& policy, MDSpan m) {
+  return reduce(policy, m, typename MDSpan::value_type(), plus<>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class MDSpan, class Value, class BinaryOp,
+  /* requires */ (detail::__is_mdspan<MDSpan>::value)
+)
+Value reduce(MDSpan m, Value init, BinaryOp op) {
+  return reduce(execution::seq, m, init, op);
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class MDSpan, class Value,
+  /* requires */ (detail::__is_mdspan<MDSpan>::value)
+)
+Value reduce(MDSpan m, Value init) {
+  return reduce(execution::seq, m, init, plus<>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class MDSpan,
+  /* requires */ (detail::__is_mdspan<MDSpan>::value)
+)
+typename MDSpan::value_type reduce(MDSpan m) {
+  return reduce(execution::seq, m, typename MDSpan::value_type(), plus<>());
+}
+
+// Fixed grouping: the same bits for every policy and thread count.
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan, class Value, class BinaryOp,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value)
+)
+Value reduce(ExecutionPolicy const& policy, MDSpan m, Value init, BinaryOp op, deterministic_t) {
+  return detail::__reduce_deterministic(policy, m, init, op,
+    integral_constant<bool, (MDSpan::extents_type::rank() > 0)>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class MDSpan, class Value, class BinaryOp,
+  /* requires */ (detail::__is_mdspan<MDSpan>::value)
+)
+Value reduce(MDSpan m, Value init, BinaryOp op, deterministic_t) {
+  return reduce(execution::seq, m, init, op, deterministic);
+}
+
+//==============================================================================
+// reduce_axis<R>: dst[j...] = init op (src[j... with i inserted at R] for
+// every i).  dst must have the extents of src with dimension R removed.
+
+template <size_t R, class ExecutionPolicy, class InMDSpan, class OutMDSpan, class Value, class BinaryOp>
+void reduce_axis(ExecutionPolicy const& policy, InMDSpan src, OutMDSpan dst, Value init, BinaryOp op) {
+  static_assert(execution::is_execution_policy<ExecutionPolicy>::value, "reduce_axis: not an execution policy");
+  static_assert(detail::__is_mdspan<InMDSpan>::value && detail::__is_mdspan<OutMDSpan>::value,
+    "reduce_axis: src and dst must be mdspans");
+  static_assert(R < InMDSpan::extents_type::rank(), "reduce_axis: R out of range");
+  static_assert(OutMDSpan::extents_type::rank() + 1 == InMDSpan::extents_type::rank(),
+    "reduce_axis: dst must have one dimension less than src");
+  static_assert(detail::__reduce_axis_extents_match<R, typename InMDSpan::extents_type, typename OutMDSpan::extents_type>(),
+    "reduce_axis: dst must have the extents of src without dimension R");
+#if MDSPAN_CHECK_BOUNDS
+  for(size_t r = 0; r < OutMDSpan::extents_type::rank(); ++r) {
+    _MDSPAN_CHECK_EXTENT("reduce_axis", src.extent(r < R ? r : r + 1), dst.extent(r));
+  }
+#endif
+  detail::__reduce_axis<R>(policy, src, dst, init, op);
+}
+
+template <size_t R, class ExecutionPolicy, class InMDSpan, class OutMDSpan>
+void reduce_axis(ExecutionPolicy const& policy, InMDSpan src, OutMDSpan dst) {
+  reduce_axis<R>(policy, src, dst, typename OutMDSpan::value_type(), plus<>());
+}
+
+template <size_t R, class InMDSpan, class OutMDSpan, class Value, class BinaryOp>
+void reduce_axis(InMDSpan src, OutMDSpan dst, Value init, BinaryOp op) {
+  reduce_axis<R>(execution::seq, src, dst, init, op);
+}
+
+template <size_t R, class InMDSpan, class OutMDSpan>
+void reduce_axis(InMDSpan src, OutMDSpan dst) {
+  reduce_axis<R>(execution::seq, src, dst, typename OutMDSpan::value_type(), plus<>());
+}
+
+} // end namespace experimental
+} // end namespace std
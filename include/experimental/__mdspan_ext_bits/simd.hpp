@@ -0,0 +1,376 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "for_each_index.hpp"
+
+#include <array>
+#include <cstddef> // size_t
+#include <cstring> // memcpy
+#include <type_traits>
+#include <utility> // index_sequence
+
+// Batches are std::experimental::simd (Parallelism TS v2) when the standard
+// library provides it, otherwise GCC/Clang vector extensions, otherwise a
+// plain array.  Define to 0 to skip std::experimental::simd.
+#ifndef MDSPAN_SIMD_USE_STD_SIMD
+#  if defined(__has_include)
+#    if __cplusplus >= 201703L && __has_include(<experimental/simd>)
+#      define MDSPAN_SIMD_USE_STD_SIMD 1
+#    endif
+#  endif
+#endif
+#ifndef MDSPAN_SIMD_USE_STD_SIMD
+#  define MDSPAN_SIMD_USE_STD_SIMD 0
+#endif
+
+#if MDSPAN_SIMD_USE_STD_SIMD
+#  include <experimental/simd>
+#endif
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// load_simd<N>(m, i0, ..., iR-1) reads the N elements m(i0, ..., iR-1 + l),
+// l < N, of one row into a simd_batch<T, N>; store_simd<N>(m, v, i...) writes
+// them back.  Rows run along the dimension the layout makes contiguous when
+// that is known statically (dimension 0 for layout_left), along the last one
+// otherwise; load_simd<N, Dim> / store_simd<N, Dim> pick dimension Dim.
+//
+// The access is chosen from the mapping: one vector load or store when the
+// row is contiguous (stride 1 along Dim), an element-by-element gather or
+// scatter for other strides, accessors or mappings.  Near the end of the
+// dimension only the lanes that fall inside it are touched: loads fill the
+// rest with T(), stores leave memory past the extent alone.
+//
+//   for(size_t k = 0; k < x.extent(1); k += 8) {
+//     auto v = load_simd<8>(x, i, k) * a + load_simd<8>(y, i, k);
+//     store_simd<8>(y, v, i, k);
+//   }
+//
+// Lanes of a batch are read and written with v[l] whichever type it is.
+
+namespace detail {
+
+template <class T, size_t N>
+struct __simd_array {
+  T __values[N];
+  MDSPAN_FORCE_INLINE_FUNCTION constexpr T const& operator[](size_t i) const noexcept { return __values[i]; }
+  MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14 T& operator[](size_t i) noexcept { return __values[i]; }
+};
+
+// Lane-wise arithmetic, so kernels written against the vector types also
+// compile for the array fallback.
+#define _MDSPAN_SIMD_ARRAY_OP(op) \
+  template <class T, size_t N> \
+  MDSPAN_INLINE_FUNCTION __simd_array<T, N>& operator op##=(__simd_array<T, N>& a, __simd_array<T, N> const& b) noexcept { \
+    for(size_t l = 0; l < N; ++l) a[l] op##= b[l]; \
+    return a; \
+  } \
+  template <class T, size_t N> \
+  MDSPAN_INLINE_FUNCTION __simd_array<T, N>& operator op##=(__simd_array<T, N>& a, T const& b) noexcept { \
+    for(size_t l = 0; l < N; ++l) a[l] op##= b; \
+    return a; \
+  } \
+  template <class T, size_t N> \
+  MDSPAN_INLINE_FUNCTION __simd_array<T, N> operator op(__simd_array<T, N> a, __simd_array<T, N> const& b) noexcept { return a op##= b; } \
+  template <class T, size_t N> \
+  MDSPAN_INLINE_FUNCTION __simd_array<T, N> operator op(__simd_array<T, N> a, T const& b) noexcept { return a op##= b; } \
+  template <class T, size_t N> \
+  MDSPAN_INLINE_FUNCTION __simd_array<T, N> operator op(T const& a, __simd_array<T, N> const& b) noexcept { \
+    __simd_array<T, N> r; \
+    for(size_t l = 0; l < N; ++l) r[l] = a op b[l]; \
+    return r; \
+  }
+_MDSPAN_SIMD_ARRAY_OP(+)
+_MDSPAN_SIMD_ARRAY_OP(-)
+_MDSPAN_SIMD_ARRAY_OP(*)
+_MDSPAN_SIMD_ARRAY_OP(/)
+#undef _MDSPAN_SIMD_ARRAY_OP
+
+constexpr bool __is_power_of_two(size_t n) noexcept { return n != 0 && (n & (n - 1)) == 0; }
+
+// Widest vector register the target was compiled for.  Wider vector extension
+// types would be passed in memory (and GCC warns about the ABI), so they fall
+// back to the plain array.
+#if defined(__AVX512F__)
+constexpr size_t __simd_native_bytes = 64;
+#elif defined(__AVX__)
+constexpr size_t __simd_native_bytes = 32;
+#else
+constexpr size_t __simd_native_bytes = 16;
+#endif
+
+template <class T>
+struct __simd_vectorizable : integral_constant<bool,
+  _MDSPAN_TRAIT(is_arithmetic, T) && !_MDSPAN_TRAIT(is_same, T, bool)
+> { };
+
+// 0: plain array, 1: vector extension, 2: std::experimental::simd
+template <class T, size_t N>
+struct __simd_kind : integral_constant<int,
+#if MDSPAN_SIMD_USE_STD_SIMD
+  __simd_vectorizable<T>::value && N <= simd_abi::max_fixed_size<T> ? 2 :
+#endif
+#if defined(__GNUC__)
+  __simd_vectorizable<T>::value && __is_power_of_two(N) && N * sizeof(T) <= __simd_native_bytes ? 1 :
+#endif
+  0
+> { };
+
+template <class T, size_t N, int Kind = __simd_kind<T, N>::value>
+struct __simd_batch {
+  using type = __simd_array<T, N>;
+  MDSPAN_FORCE_INLINE_FUNCTION static void __load(type& v, T const* p) noexcept { std::memcpy(v.__values, p, N * sizeof(T)); }
+  MDSPAN_FORCE_INLINE_FUNCTION static void __store(type const& v, T* p) noexcept { std::memcpy(p, v.__values, N * sizeof(T)); }
+};
+
+#if defined(__GNUC__)
+template <class T, size_t N>
+struct __simd_batch<T, N, 1> {
+  typedef T type __attribute__((vector_size(N * sizeof(T))));
+  MDSPAN_FORCE_INLINE_FUNCTION static void __load(type& v, T const* p) noexcept { std::memcpy(&v, p, sizeof(type)); }
+  MDSPAN_FORCE_INLINE_FUNCTION static void __store(type const& v, T* p) noexcept { std::memcpy(p, &v, sizeof(type)); }
+};
+#endif
+
+#if MDSPAN_SIMD_USE_STD_SIMD
+template <class T, size_t N>
+struct __simd_batch<T, N, 2> {
+  using type = fixed_size_simd<T, int(N)>;
+  MDSPAN_FORCE_INLINE_FUNCTION static void __load(type& v, T const* p) noexcept { v.copy_from(p, element_aligned); }
+  MDSPAN_FORCE_INLINE_FUNCTION static void __store(type const& v, T* p) noexcept { v.copy_to(p, element_aligned); }
+};
+#endif
+
+// Calls f(integral_constant<size_t, J>()) for J in [0, N) with the loop
+// unrolled in the source, so that arrays of batches indexed by J are known
+// element by element after inlining and the compiler keeps them in registers.
+template <size_t J, size_t N>
+struct __static_for {
+  template <class F>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __apply(F const& f) {
+    f(integral_constant<size_t, J>());
+    __static_for<J + 1, N>::__apply(f);
+  }
+};
+
+template <size_t N>
+struct __static_for<N, N> {
+  template <class F>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __apply(F const&) { }
+};
+
+template <class MDSpan>
+struct __simd_is_raw : integral_constant<bool,
+  _MDSPAN_TRAIT(is_same, typename MDSpan::accessor_type, default_accessor<typename MDSpan::element_type>)
+> { };
+
+template <size_t Dim, class MDSpan, size_t... Is>
+MDSPAN_INLINE_FUNCTION
+size_t __simd_offset(MDSpan const& m, array<size_t, sizeof...(Is)> const& idx, size_t l, index_sequence<Is...>) {
+  return size_t(m.mapping()((idx[Is] + (Is == Dim ? l : 0))...));
+}
+
+// Lanes of the row starting at idx that lie inside the extent.
+template <size_t N, size_t Dim, class MDSpan, size_t Rank>
+MDSPAN_INLINE_FUNCTION
+size_t __simd_lanes(MDSpan const& m, array<size_t, Rank> const& idx) noexcept {
+  const size_t n = m.extent(Dim);
+  return idx[Dim] >= n ? 0 : (n - idx[Dim] < N ? n - idx[Dim] : N);
+}
+
+// Gathers and scatters go through a plain buffer: writing the lanes of the
+// batch one by one keeps it out of registers on the contiguous path too.
+template <size_t N, size_t Dim, class MDSpan, size_t Rank>
+MDSPAN_INLINE_FUNCTION
+typename __simd_batch<remove_const_t<typename MDSpan::element_type>, N>::type
+__simd_load(MDSpan const& m, array<size_t, Rank> const& idx, false_type /* raw */) {
+  using batch = __simd_batch<remove_const_t<typename MDSpan::element_type>, N>;
+  const size_t lanes = __simd_lanes<N, Dim>(m, idx);
+  const auto acc = m.accessor();
+  remove_const_t<typename MDSpan::element_type> buffer[N] = { };
+  for(size_t l = 0; l < lanes; ++l) {
+    buffer[l] = acc.access(m.data(), __simd_offset<Dim>(m, idx, l, make_index_sequence<Rank>()));
+  }
+  typename batch::type v;
+  batch::__load(v, buffer);
+  return v;
+}
+
+template <size_t N, size_t Dim, class Batch, class MDSpan, size_t Rank>
+MDSPAN_INLINE_FUNCTION
+void __simd_store(Batch const& v, MDSpan const& m, array<size_t, Rank> const& idx, false_type /* raw */) {
+  const size_t lanes = __simd_lanes<N, Dim>(m, idx);
+  const auto acc = m.accessor();
+  typename MDSpan::element_type buffer[N];
+  __simd_batch<typename MDSpan::element_type, N>::__store(v, buffer);
+  for(size_t l = 0; l < lanes; ++l) {
+    acc.access(m.data(), __simd_offset<Dim>(m, idx, l, make_index_sequence<Rank>())) = buffer[l];
+  }
+}
+
+// Kept out of line: a gather inlined next to the vector load pushes the
+// batch (and the index array) through the stack on the contiguous path too.
+template <size_t N, class T>
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void __simd_gather(T* buffer, T const* p, size_t offset, size_t lanes, size_t stride) noexcept {
+  for(size_t l = 0; l < N; ++l) buffer[l] = l < lanes ? p[offset + l * stride] : T();
+}
+
+template <size_t N, size_t Dim, class MDSpan, size_t Rank>
+MDSPAN_INLINE_FUNCTION
+typename __simd_batch<remove_const_t<typename MDSpan::element_type>, N>::type
+__simd_load(MDSpan const& m, array<size_t, Rank> const& idx, true_type /* raw */) {
+  using value_type = remove_const_t<typename MDSpan::element_type>;
+  using batch = __simd_batch<value_type, N>;
+  auto const& map = m.mapping();
+  if(!map.is_strided()) return __simd_load<N, Dim>(m, idx, false_type());
+  const size_t n = m.extent(Dim);
+  const size_t stride = map.stride(Dim);
+  const size_t offset = __simd_offset<Dim>(m, idx, 0, make_index_sequence<Rank>());
+  // Only the source pointer depends on the branch, the batch is loaded once.
+  value_type buffer[N];
+  value_type const* p = buffer;
+  if(_MDSPAN_UNLIKELY(idx[Dim] + N > n || stride != 1)) {
+    __simd_gather<N>(buffer, static_cast<value_type const*>(m.data()), offset, idx[Dim] < n ? n - idx[Dim] : 0, stride);
+  } else {
+    p = m.data() + offset;
+  }
+  typename batch::type v;
+  batch::__load(v, p);
+  return v;
+}
+
+template <size_t N, size_t Dim, class Batch, class MDSpan, size_t Rank>
+MDSPAN_INLINE_FUNCTION
+void __simd_store(Batch const& v, MDSpan const& m, array<size_t, Rank> const& idx, true_type /* raw */) {
+  auto const& map = m.mapping();
+  if(_MDSPAN_UNLIKELY(!map.is_strided() || idx[Dim] + N > size_t(m.extent(Dim)) || size_t(map.stride(Dim)) != 1)) {
+    return __simd_store<N, Dim>(v, m, idx, false_type());
+  }
+  __simd_batch<typename MDSpan::element_type, N>::__store(v, m.data() + __simd_offset<Dim>(m, idx, 0, make_index_sequence<Rank>()));
+}
+
+// The dimension load_simd<N> and store_simd<N> run along.
+template <class MDSpan>
+struct __simd_default_dim : integral_constant<size_t,
+  _MDSPAN_TRAIT(is_same, typename MDSpan::layout_type, layout_left) ? 0 : MDSpan::extents_type::rank() - 1> { };
+
+} // end namespace detail
+
+// The batch type load_simd<N> returns for elements of type T.
+template <class T, size_t N>
+using simd_batch = typename detail::__simd_batch<remove_const_t<T>, N>::type;
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t N, size_t Dim, class MDSpan, class... Indices,
+  /* requires */ (
+    detail::__is_mdspan<MDSpan>::value &&
+    sizeof...(Indices) == MDSpan::extents_type::rank() &&
+    Dim < MDSpan::extents_type::rank() &&
+    _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, Indices, size_t) /* && ... */)
+  )
+)
+MDSPAN_INLINE_FUNCTION
+simd_batch<typename MDSpan::element_type, N> load_simd(MDSpan const& m, Indices... idxs) {
+  return detail::__simd_load<N, Dim>(m, array<size_t, sizeof...(Indices)>{{size_t(idxs)...}},
+    detail::__simd_is_raw<MDSpan>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t N, class MDSpan, class... Indices,
+  /* requires */ (
+    detail::__is_mdspan<MDSpan>::value &&
+    sizeof...(Indices) == MDSpan::extents_type::rank() &&
+    (MDSpan::extents_type::rank() > 0) &&
+    _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, Indices, size_t) /* && ... */)
+  )
+)
+MDSPAN_INLINE_FUNCTION
+simd_batch<typename MDSpan::element_type, N> load_simd(MDSpan const& m, Indices... idxs) {
+  return load_simd<N, detail::__simd_default_dim<MDSpan>::value>(m, idxs...);
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t N, size_t Dim, class MDSpan, class... Indices,
+  /* requires */ (
+    detail::__is_mdspan<MDSpan>::value &&
+    sizeof...(Indices) == MDSpan::extents_type::rank() &&
+    Dim < MDSpan::extents_type::rank() &&
+    _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, Indices, size_t) /* && ... */)
+  )
+)
+MDSPAN_INLINE_FUNCTION
+void store_simd(MDSpan const& m, simd_batch<typename MDSpan::element_type, N> const& v, Indices... idxs) {
+  detail::__simd_store<N, Dim>(v, m, array<size_t, sizeof...(Indices)>{{size_t(idxs)...}},
+    detail::__simd_is_raw<MDSpan>());
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t N, class MDSpan, class... Indices,
+  /* requires */ (
+    detail::__is_mdspan<MDSpan>::value &&
+    sizeof...(Indices) == MDSpan::extents_type::rank() &&
+    (MDSpan::extents_type::rank() > 0) &&
+    _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, Indices, size_t) /* && ... */)
+  )
+)
+MDSPAN_INLINE_FUNCTION
+void store_simd(MDSpan const& m, simd_batch<typename MDSpan::element_type, N> const& v, Indices... idxs) {
+  store_simd<N, detail::__simd_default_dim<MDSpan>::value>(m, v, idxs...);
+}
+
+} // end namespace experimental
+} // end namespace std
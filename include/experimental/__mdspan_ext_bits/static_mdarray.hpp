@@ -0,0 +1,195 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/layout_stride.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p1684_bits/mdarray.hpp"
+#include "batched.hpp"
+
+#include <array>
+#include <cstddef> // size_t
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// static_mdarray: an mdarray over fully static extents whose elements live
+// inline in a std::array.  It is trivially copyable and (where the mapping can
+// be given no address) exactly as large as its elements, so a contiguous
+// array of them is a flat array of numbers: batch_view() exposes it as one
+// mdspan with a leading batch extent, which the batched_* overloads below
+// hand to the kernels of batched.hpp.
+
+namespace detail {
+
+template <class Extents>
+struct __static_span_size;
+
+template <size_t... Es>
+struct __static_span_size<extents<Es...>>
+  : integral_constant<size_t, _MDSPAN_FOLD_TIMES_RIGHT((Es), /* * ... * */ size_t(1))>
+{
+  static_assert(_MDSPAN_FOLD_AND((Es != dynamic_extent) /* && ... */),
+    "std::experimental::static_mdarray requires fully static extents.");
+};
+
+} // end namespace detail
+
+template <class ElementType, class Extents, class LayoutPolicy = layout_right>
+using static_mdarray = mdarray<
+  ElementType, Extents, LayoutPolicy,
+  array<ElementType, detail::__static_span_size<Extents>::value>
+>;
+
+namespace detail {
+
+// True when an array of static_mdarray is a flat array of its elements.
+template <class T, class Extents, class Layout>
+struct __static_mdarray_is_flat
+  : integral_constant<bool,
+      sizeof(static_mdarray<T, Extents, Layout>) == sizeof(T) * __static_span_size<Extents>::value &&
+      _MDSPAN_TRAIT(is_standard_layout, static_mdarray<T, Extents, Layout>)
+    >
+{ };
+
+template <class T, class Extents, class Layout>
+T* __batch_data(static_mdarray<T, Extents, Layout>* first) noexcept {
+  static_assert(__static_span_size<Extents>::value == 0 || __static_mdarray_is_flat<T, Extents, Layout>::value,
+    "std::experimental::batch_view requires static_mdarray to have no padding.");
+  return reinterpret_cast<T*>(first);
+}
+
+template <class T, class Extents, class Layout>
+const T* __batch_data(const static_mdarray<T, Extents, Layout>* first) noexcept {
+  static_assert(__static_span_size<Extents>::value == 0 || __static_mdarray_is_flat<T, Extents, Layout>::value,
+    "std::experimental::batch_view requires static_mdarray to have no padding.");
+  return reinterpret_cast<const T*>(first);
+}
+
+template <class Mapping, size_t... Idxs>
+array<size_t, sizeof...(Idxs) + 1>
+__batch_strides(const Mapping& m, size_t batch_stride, index_sequence<Idxs...>) noexcept {
+  return array<size_t, sizeof...(Idxs) + 1>{{batch_stride, size_t(m.stride(Idxs))...}};
+}
+
+} // end namespace detail
+
+// View `count` consecutive static_mdarrays as one mdspan whose first index
+// selects the matrix.  Row-major elements give a layout_right batch; any
+// other strided layout gives a layout_stride batch.
+template <class T, size_t... Es>
+mdspan<T, extents<dynamic_extent, Es...>, layout_right>
+batch_view(static_mdarray<T, extents<Es...>, layout_right>* first, size_t count) noexcept {
+  return mdspan<T, extents<dynamic_extent, Es...>, layout_right>(detail::__batch_data(first), count);
+}
+
+template <class T, size_t... Es>
+mdspan<const T, extents<dynamic_extent, Es...>, layout_right>
+batch_view(const static_mdarray<T, extents<Es...>, layout_right>* first, size_t count) noexcept {
+  return mdspan<const T, extents<dynamic_extent, Es...>, layout_right>(detail::__batch_data(first), count);
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class T, size_t... Es, class Layout,
+  /* requires */ (!_MDSPAN_TRAIT(is_same, Layout, layout_right))
+)
+mdspan<T, extents<dynamic_extent, Es...>, layout_stride>
+batch_view(static_mdarray<T, extents<Es...>, Layout>* first, size_t count) noexcept {
+  using batch_extents = extents<dynamic_extent, Es...>;
+  return mdspan<T, batch_extents, layout_stride>(
+    detail::__batch_data(first),
+    layout_stride::mapping<batch_extents>(batch_extents(count),
+      detail::__batch_strides(first->mapping(), detail::__static_span_size<extents<Es...>>::value,
+                              make_index_sequence<sizeof...(Es)>()))
+  );
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class T, size_t... Es, class Layout,
+  /* requires */ (!_MDSPAN_TRAIT(is_same, Layout, layout_right))
+)
+mdspan<const T, extents<dynamic_extent, Es...>, layout_stride>
+batch_view(const static_mdarray<T, extents<Es...>, Layout>* first, size_t count) noexcept {
+  using batch_extents = extents<dynamic_extent, Es...>;
+  return mdspan<const T, batch_extents, layout_stride>(
+    detail::__batch_data(first),
+    layout_stride::mapping<batch_extents>(batch_extents(count),
+      detail::__batch_strides(first->mapping(), detail::__static_span_size<extents<Es...>>::value,
+                              make_index_sequence<sizeof...(Es)>()))
+  );
+}
+
+//==============================================================================
+// Batched kernels over arrays of static_mdarray: batch_view() of each array
+// passed to the mdspan kernels of batched.hpp.
+
+// c[m] = a[m] + b[m] for m in [0, count).  c may alias a or b.
+template <class T, class Extents, class Layout>
+void batched_add(const static_mdarray<T, Extents, Layout>* a,
+                 const static_mdarray<T, Extents, Layout>* b,
+                 static_mdarray<T, Extents, Layout>* c, size_t count)
+{
+  batched_add(batch_view(a, count), batch_view(b, count), batch_view(c, count));
+}
+
+// c[m] = a[m] * b[m] (matrix product) for m in [0, count).  c must not alias
+// a or b.
+template <class T, size_t M, size_t K, size_t N, class Layout>
+void batched_matrix_product(const static_mdarray<T, extents<M, K>, Layout>* a,
+                            const static_mdarray<T, extents<K, N>, Layout>* b,
+                            static_mdarray<T, extents<M, N>, Layout>* c, size_t count)
+{
+  batched_matrix_product(batch_view(a, count), batch_view(b, count), batch_view(c, count));
+}
+
+} // end namespace experimental
+} // end namespace std
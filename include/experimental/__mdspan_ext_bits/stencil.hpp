@@ -0,0 +1,432 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/bounds_check.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "for_each_index.hpp"
+#include "parallel_algorithms.hpp"
+#include "parallel_backend.hpp"
+#include "reduce.hpp"
+
+#include <algorithm> // copy, min, max
+#include <array>
+#include <cstddef> // size_t, ptrdiff_t
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// stencil_sweep<R>(policy, a, b, steps, f) advances the grid in a by `steps`
+// time steps of a stencil of radius R and returns whichever of a and b holds
+// the result (the other one is overwritten along the way).  Every point at
+// least R away from the edges is updated as
+//
+//   next(i...) = f(nb)      nb(d...) is current(i + d...), |d| <= R
+//
+// with nb a stencil_neighborhood; the points within R of an edge are fixed
+// boundary values and keep whatever a holds there.
+//
+//   auto u = stencil_sweep<1>(execution::par, a, b, 100, [](auto const& nb) {
+//     return 0.25 * (nb(-1, 0) + nb(1, 0) + nb(0, -1) + nb(0, 1));
+//   });
+//
+// Instead of sweeping the whole grid once per step, blocking.time_steps steps
+// are fused into one pass (time skewing): the engine walks dimension 0 plane
+// by plane and keeps the last 2R + 1 planes of every intermediate step in a
+// ring buffer, so each point is read and written once per pass rather than
+// once per step.  Dimension 1 is cut into slabs narrow enough for the ring
+// buffers to stay in cache.  Each slab also computes the R columns per fused
+// step it borrows from its neighbours (overlapped tiling), so slabs are
+// independent and run concurrently under par / par_unseq.
+
+struct stencil_blocking {
+  size_t time_steps = 4; // steps fused into one pass over memory, 1: none
+  size_t width = 0;      // columns of dimension 1 per slab, 0: sized for the cache
+};
+
+// The points around the one being updated, as handed to the functor of
+// stencil_sweep.  The data members are filled in by the engine.
+template <class T, size_t Rank, size_t Radius>
+class stencil_neighborhood {
+public:
+  using value_type = T;
+
+  static constexpr size_t rank() noexcept { return Rank; }
+  static constexpr size_t radius() noexcept { return Radius; }
+
+  // The current value at offset (d0, d1, ...) from the centre, |d| <= Radius.
+  template <class... Offsets>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  T const& operator()(ptrdiff_t d0, Offsets... ds) const noexcept {
+    static_assert(sizeof...(Offsets) + 1 == Rank, "stencil_neighborhood takes one offset per dimension");
+    return __planes[d0 + ptrdiff_t(Radius)][__pos + __plane_offset(1, ptrdiff_t(ds)...)];
+  }
+
+  // The index of the centre in the grid.
+  array<size_t, Rank> const& index() const noexcept { return __index; }
+
+  T const* __planes[2 * Radius + 1]; // the planes at offsets -Radius ... Radius along dimension 0
+  array<ptrdiff_t, Rank> __strides;  // of dimensions 1 ... Rank-2 within a plane
+  ptrdiff_t __pos;
+  array<size_t, Rank> __index;
+
+private:
+  MDSPAN_FORCE_INLINE_FUNCTION
+  ptrdiff_t __plane_offset(size_t) const noexcept { return 0; }
+
+  template <class... Rest>
+  MDSPAN_FORCE_INLINE_FUNCTION
+  ptrdiff_t __plane_offset(size_t dim, ptrdiff_t d, Rest... rest) const noexcept {
+    return (sizeof...(Rest) == 0 ? d : d * __strides[dim]) + __plane_offset(dim + 1, rest...);
+  }
+};
+
+namespace detail {
+
+// Ring buffers of one slab should fit here.
+_MDSPAN_INLINE_VARIABLE constexpr size_t __stencil_cache_bytes = size_t(1) << 20;
+
+// Results of a row are computed into a local buffer of this many points first,
+// which cannot alias the planes and so lets the compiler vectorize f.
+_MDSPAN_INLINE_VARIABLE constexpr size_t __stencil_chunk = 64;
+
+// Calls g(idx, offset) once per row of a plane: idx runs over [lo, hi) in
+// dimensions 1 ... Rank-2, offset is where the row starts in the plane
+// (relative to origin).  Ranks 1 and 2 have a single row.
+template <size_t Rank, class G>
+void __for_each_plane_row(array<size_t, Rank> idx, array<size_t, Rank> const& lo, array<size_t, Rank> const& hi,
+                          array<size_t, Rank> const& origin, array<ptrdiff_t, Rank> const& strides, G&& g) {
+  for(size_t r = 1; r + 1 < Rank; ++r) {
+    if(lo[r] >= hi[r]) return;
+    idx[r] = lo[r];
+  }
+  while(true) {
+    ptrdiff_t offset = 0;
+    for(size_t r = 1; r + 1 < Rank; ++r) offset += ptrdiff_t(idx[r] - origin[r]) * strides[r];
+    g(idx, offset);
+    size_t r = Rank < 2 ? 0 : Rank - 2;
+    for(; r >= 1; --r) {
+      if(++idx[r] < hi[r]) break;
+      idx[r] = lo[r];
+    }
+    if(r < 1) return;
+  }
+}
+
+template <class MDSpan>
+struct __stencil_is_raw : integral_constant<bool,
+  _MDSPAN_TRAIT(is_same, typename MDSpan::accessor_type, default_accessor<typename MDSpan::element_type>)
+> { };
+
+// Copy m(idx with idx[last] = k), k in [k_lo, k_hi), to or from row[k - k_lo].
+template <class MDSpan, class T, size_t Rank>
+void __stencil_transfer(MDSpan const& m, array<size_t, Rank> idx, size_t last, size_t k_lo, size_t k_hi,
+                        T* row, bool to_row, false_type /* raw */) {
+  const auto acc = m.accessor();
+  for(size_t k = k_lo; k < k_hi; ++k) {
+    idx[last] = k;
+    if(to_row) row[k - k_lo] = acc.access(m.data(), __offset(m.mapping(), idx));
+    else acc.access(m.data(), __offset(m.mapping(), idx)) = row[k - k_lo];
+  }
+}
+
+template <class MDSpan, class T, size_t Rank>
+void __stencil_transfer(MDSpan const& m, array<size_t, Rank> idx, size_t last, size_t k_lo, size_t k_hi,
+                        T* row, bool to_row, true_type /* raw */) {
+  auto const& map = m.mapping();
+  if(!map.is_strided()) {
+    __stencil_transfer(m, idx, last, k_lo, k_hi, row, to_row, false_type());
+    return;
+  }
+  idx[last] = k_lo;
+  T* p = m.data() + __offset(map, idx);
+  const size_t stride = size_t(map.stride(last));
+  const size_t n = k_hi - k_lo;
+  if(to_row) {
+    for(size_t k = 0; k < n; ++k) row[k] = p[k * stride];
+  } else {
+    for(size_t k = 0; k < n; ++k) p[k * stride] = row[k];
+  }
+}
+
+// One slab: output columns [c_lo, c_hi) of dimension 1 (the whole grid for
+// rank 1), advanced by `steps` fused steps from src to dst.  Planes are
+// stored row-major over dimensions 1 ... Rank-1, columns [b_lo, b_hi) of
+// dimension 1 only.  ring(s, p) is plane p after s steps: 2R + 1 planes for
+// every s < steps and one for the last step, which is copied out to dst.
+template <class T, size_t Rank, size_t Radius>
+class __stencil_slab {
+public:
+
+  static constexpr size_t __window = 2 * Radius + 1;
+  static constexpr size_t __last = Rank - 1;
+
+  __stencil_slab(array<size_t, Rank> const& n, size_t c_lo, size_t c_hi, size_t steps)
+    : __n(n), __steps(steps)
+  {
+    const size_t halo = Radius * steps;
+    for(size_t r = 0; r < Rank; ++r) {
+      __lo[r] = 0;
+      __hi[r] = n[r];
+      __out_lo[r] = 0;
+      __out_hi[r] = n[r];
+    }
+    if(Rank > 1) {
+      __out_lo[1] = c_lo;
+      __out_hi[1] = c_hi;
+      __lo[1] = c_lo > halo ? c_lo - halo : 0;
+      __hi[1] = std::min(n[1], c_hi + halo);
+    }
+    __plane_size = 1;
+    __strides[0] = 0;
+    for(size_t r = Rank - 1; r >= 1; --r) {
+      __strides[r] = ptrdiff_t(__plane_size);
+      __plane_size *= __hi[r] - __lo[r];
+    }
+    __ring.resize((steps * __window + 1) * __plane_size);
+  }
+
+  template <class Src, class Dst, class F>
+  void run(Src const& src, Dst const& dst, F const& f) {
+    const ptrdiff_t n0 = ptrdiff_t(__n[0]);
+    const ptrdiff_t lag = ptrdiff_t(Radius);
+    for(ptrdiff_t i = 0; i < n0 + lag * ptrdiff_t(__steps); ++i) {
+      if(i < n0) __load(src, size_t(i));
+      for(size_t s = 1; s <= __steps; ++s) {
+        const ptrdiff_t p = i - lag * ptrdiff_t(s);
+        if(p < 0) break;
+        if(p >= n0) continue;
+        __step(s, size_t(p), f);
+        if(s == __steps) __store(dst, size_t(p));
+      }
+    }
+  }
+
+private:
+
+  T* __plane(size_t s, size_t p) noexcept {
+    return __ring.data() + (s < __steps ? s * __window + p % __window : __steps * __window) * __plane_size;
+  }
+
+  // Where the row starts along the last dimension, relative to the plane.
+  size_t __origin_last(size_t p) const noexcept { return Rank == 1 ? p : __lo[__last]; }
+
+  bool __interior(size_t r, size_t x) const noexcept { return x >= Radius && x + Radius < __n[r]; }
+
+  template <class Src>
+  void __load(Src const& src, size_t p) {
+    array<size_t, Rank> idx = __lo;
+    idx[0] = p;
+    T* plane = __plane(0, p);
+    const size_t k_lo = Rank == 1 ? p : __lo[__last];
+    const size_t k_hi = Rank == 1 ? p + 1 : __hi[__last];
+    __for_each_plane_row(idx, __lo, __hi, __lo, __strides, [&](array<size_t, Rank> const& row, ptrdiff_t offset) {
+      __stencil_transfer(src, row, __last, k_lo, k_hi, plane + offset, true, __stencil_is_raw<Src>());
+    });
+  }
+
+  template <class Dst>
+  void __store(Dst const& dst, size_t p) {
+    array<size_t, Rank> idx = __out_lo;
+    idx[0] = p;
+    T* plane = __plane(__steps, p);
+    const size_t k_lo = Rank == 1 ? p : __out_lo[__last];
+    const size_t k_hi = Rank == 1 ? p + 1 : __out_hi[__last];
+    const size_t origin = __origin_last(p);
+    __for_each_plane_row(idx, __out_lo, __out_hi, __lo, __strides, [&](array<size_t, Rank> const& row, ptrdiff_t offset) {
+      __stencil_transfer(dst, row, __last, k_lo, k_hi, plane + offset + ptrdiff_t(k_lo - origin), false, __stencil_is_raw<Dst>());
+    });
+  }
+
+  // Plane p after s steps, from the planes p - R ... p + R after s - 1.
+  template <class F>
+  void __step(size_t s, size_t p, F const& f) {
+    T const* prev = __plane(s - 1, p);
+    T* next = __plane(s, p);
+    if(!__interior(0, p)) {
+      std::copy(prev, prev + __plane_size, next);
+      return;
+    }
+
+    // Points this slab still needs after step s: its own columns plus R per
+    // step to go on either side, within the interior.
+    const size_t shrink = Radius * (__steps - s);
+    array<size_t, Rank> lo, hi;
+    for(size_t r = 1; r < Rank; ++r) {
+      lo[r] = std::max(Radius, __out_lo[r] > shrink ? __out_lo[r] - shrink : 0);
+      hi[r] = __n[r] > Radius ? std::min(__n[r] - Radius, __out_hi[r] + shrink) : 0;
+    }
+
+    stencil_neighborhood<T, Rank, Radius> nb;
+    for(size_t d = 0; d < __window; ++d) nb.__planes[d] = __plane(s - 1, p + d - Radius);
+    nb.__strides = __strides;
+    nb.__index[0] = p;
+
+    if(Rank == 1) {
+      nb.__pos = 0;
+      next[0] = f(static_cast<stencil_neighborhood<T, Rank, Radius> const&>(nb));
+      return;
+    }
+
+    array<size_t, Rank> idx = __lo;
+    __for_each_plane_row(idx, __lo, __hi, __lo, __strides, [&](array<size_t, Rank> const& row, ptrdiff_t offset) {
+      const ptrdiff_t base = offset - ptrdiff_t(__lo[__last]);
+      bool boundary_row = false, needed_row = true;
+      for(size_t r = 1; r < __last; ++r) {
+        boundary_row = boundary_row || !__interior(r, row[r]);
+        needed_row = needed_row && row[r] >= lo[r] && row[r] < hi[r];
+      }
+      // Boundary values are not recomputed but must be there for step s + 1.
+      if(boundary_row) {
+        std::copy(prev + offset, prev + offset + (__hi[__last] - __lo[__last]), next + offset);
+        return;
+      }
+      const size_t edge_lo = std::min(std::max(__lo[__last], Radius), __hi[__last]);
+      const size_t edge_hi = std::max(std::min(__hi[__last], __n[__last] > Radius ? __n[__last] - Radius : 0), edge_lo);
+      std::copy(prev + base + ptrdiff_t(__lo[__last]), prev + base + ptrdiff_t(edge_lo), next + base + ptrdiff_t(__lo[__last]));
+      std::copy(prev + base + ptrdiff_t(edge_hi), prev + base + ptrdiff_t(__hi[__last]), next + base + ptrdiff_t(edge_hi));
+      if(!needed_row) return;
+
+      stencil_neighborhood<T, Rank, Radius> at = nb;
+      for(size_t r = 1; r < __last; ++r) at.__index[r] = row[r];
+      T chunk[__stencil_chunk];
+      for(ptrdiff_t k0 = ptrdiff_t(lo[__last]); k0 < ptrdiff_t(hi[__last]); k0 += ptrdiff_t(__stencil_chunk)) {
+        const ptrdiff_t n = std::min(ptrdiff_t(__stencil_chunk), ptrdiff_t(hi[__last]) - k0);
+        for(ptrdiff_t k = 0; k < n; ++k) {
+          at.__pos = base + k0 + k;
+          at.__index[__last] = size_t(k0 + k);
+          chunk[k] = f(static_cast<stencil_neighborhood<T, Rank, Radius> const&>(at));
+        }
+        std::copy(chunk, chunk + n, next + base + k0);
+      }
+    });
+  }
+
+  array<size_t, Rank> __n;
+  size_t __steps;
+  array<size_t, Rank> __lo, __hi;         // buffered
+  array<size_t, Rank> __out_lo, __out_hi; // written to dst
+  array<ptrdiff_t, Rank> __strides;
+  size_t __plane_size;
+  vector<T> __ring;
+};
+
+// Columns of dimension 1 per slab.
+template <class T, size_t Rank, size_t Radius>
+size_t __stencil_width(array<size_t, Rank> const& n, size_t steps, size_t tasks, stencil_blocking const& blocking) {
+  if(Rank < 2) return 1;
+  if(blocking.width != 0) return blocking.width;
+  const size_t halo = 2 * Radius * steps;
+  size_t column_bytes = (steps * (2 * Radius + 1) + 1) * sizeof(T);
+  for(size_t r = 2; r < Rank; ++r) column_bytes *= n[r] == 0 ? 1 : n[r];
+  const size_t buffered = __stencil_cache_bytes / column_bytes;
+  size_t width = std::max(buffered > halo ? buffered - halo : 0, 4 * Radius * steps);
+  width = std::min(width, (n[1] + tasks - 1) / tasks);
+  return width == 0 ? 1 : width;
+}
+
+template <size_t Radius, class Policy, class MDSpan, class F>
+MDSpan __stencil_sweep(Policy const& policy, MDSpan a, MDSpan b, size_t steps, F const& f, stencil_blocking const& blocking) {
+  using value_type = remove_const_t<typename MDSpan::element_type>;
+  constexpr size_t rank = MDSpan::extents_type::rank();
+  _MDSPAN_CHECK_EXTENTS("stencil_sweep", a.extents(), b.extents());
+
+  array<size_t, rank> n;
+  size_t size = 1;
+  for(size_t r = 0; r < rank; ++r) {
+    n[r] = a.extent(r);
+    size *= n[r];
+  }
+  if(size == 0) return a;
+
+  const size_t tasks = __policy_tasks(policy);
+  const size_t fuse = blocking.time_steps == 0 ? 1 : blocking.time_steps;
+  for(size_t done = 0; done < steps; ) {
+    const size_t pass = std::min(fuse, steps - done);
+    const size_t width = __stencil_width<value_type, rank, Radius>(n, pass, tasks, blocking);
+    const size_t slabs = rank < 2 ? 1 : (n[rank < 2 ? 0 : 1] + width - 1) / width;
+    __run_tasks(policy, slabs, [&](size_t t) {
+      const size_t c_lo = t * width;
+      const size_t c_hi = rank < 2 ? 1 : std::min(n[rank < 2 ? 0 : 1], c_lo + width);
+      __stencil_slab<value_type, rank, Radius> slab(n, c_lo, c_hi, pass);
+      slab.run(a, b, f);
+    });
+    swap(a, b);
+    done += pass;
+  }
+  return a;
+}
+
+} // end namespace detail
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t Radius, class ExecutionPolicy, class MDSpan, class F,
+  /* requires */ (
+    execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value &&
+    (MDSpan::extents_type::rank() > 0)
+  )
+)
+MDSpan stencil_sweep(ExecutionPolicy const& policy, MDSpan a, MDSpan b, size_t steps, F f,
+                     stencil_blocking blocking = stencil_blocking{}) {
+  return detail::__stencil_sweep<Radius>(policy, a, b, steps, f, blocking);
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  size_t Radius, class MDSpan, class F,
+  /* requires */ (
+    detail::__is_mdspan<MDSpan>::value && (MDSpan::extents_type::rank() > 0)
+  )
+)
+MDSpan stencil_sweep(MDSpan a, MDSpan b, size_t steps, F f, stencil_blocking blocking = stencil_blocking{}) {
+  return detail::__stencil_sweep<Radius>(execution::seq, a, b, steps, f, blocking);
+}
+
+} // end namespace experimental
+} // end namespace std
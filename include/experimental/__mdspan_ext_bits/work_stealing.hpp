@@ -0,0 +1,387 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/submdspan.hpp"
+#include "parallel_algorithms.hpp"
+#include "parallel_backend.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef> // size_t
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility> // pair, index_sequence
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+// for_each_tile: cover an index space with boxes ("tiles") of at most `grain`
+// indices each and call f once per tile, for irregular work where a static
+// split leaves threads idle (triangular loops, per-point costs that vary).
+//
+//   for_each_tile(policy, exts, grain, f)   f(lo, hi): the box [lo, hi), as
+//                                            array<size_t, rank>
+//   for_each_tile(policy, m, grain, f)      f(sub, origin): sub is the
+//                                            submdspan of m over the box,
+//                                            origin its first index in m
+//
+// Under par / par_unseq the space is bisected recursively, outermost layout
+// dimension first, and each thread keeps the halves it has not yet worked on
+// in its own Chase-Lev deque.  A thread works depth first on its own deque
+// and, once that is empty, steals the oldest (largest) box of a random other
+// thread, so load balances without a central queue.  If f throws, no further
+// tiles are started and the exception is rethrown once the tiles already
+// running have finished.
+
+namespace detail {
+
+//------------------------------------------------------------------------------
+// Chase-Lev work-stealing deque of pointers (Le, Pop, Cohen, Zappa Nardelli,
+// "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013).
+// push / take are for the owning thread only, steal may be called by any.
+// Buffers replaced while growing are kept until the deque is destroyed, since
+// a thief may still be reading from one.
+
+template <class T>
+class __chase_lev_deque {
+public:
+
+  explicit __chase_lev_deque(size_t capacity = 64)
+    : __top(0), __bottom(0)
+  {
+    size_t cap = 1;
+    while(cap < capacity) cap *= 2;
+    __buffers.emplace_back(new __ring(cap));
+    __buffer.store(__buffers.back().get(), memory_order_relaxed);
+  }
+
+  __chase_lev_deque(__chase_lev_deque const&) = delete;
+  __chase_lev_deque& operator=(__chase_lev_deque const&) = delete;
+
+  void push(T* item) {
+    const int64_t b = __bottom.load(memory_order_relaxed);
+    const int64_t t = __top.load(memory_order_acquire);
+    __ring* ring = __buffer.load(memory_order_relaxed);
+    if(b - t > int64_t(ring->__mask)) ring = __grow(ring, t, b);
+    ring->__put(b, item);
+    __bottom.store(b + 1, memory_order_release);
+  }
+
+  // The most recently pushed item, or nullptr.
+  T* take() {
+    const int64_t b = __bottom.load(memory_order_relaxed) - 1;
+    __ring* ring = __buffer.load(memory_order_relaxed);
+    __bottom.store(b, memory_order_seq_cst);
+    int64_t t = __top.load(memory_order_seq_cst);
+    if(t > b) {
+      __bottom.store(b + 1, memory_order_relaxed);
+      return nullptr;
+    }
+    T* item = ring->__get(b);
+    if(t == b) {
+      // Last item: race the thieves for it.
+      if(!__top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        item = nullptr;
+      }
+      __bottom.store(b + 1, memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // The oldest item, or nullptr if the deque is empty or another thread won
+  // the race for it.
+  T* steal() {
+    int64_t t = __top.load(memory_order_seq_cst);
+    const int64_t b = __bottom.load(memory_order_seq_cst);
+    if(t >= b) return nullptr;
+    __ring* ring = __buffer.load(memory_order_acquire);
+    T* item = ring->__get(t);
+    if(!__top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  bool empty() const noexcept {
+    return __bottom.load(memory_order_relaxed) <= __top.load(memory_order_relaxed);
+  }
+
+private:
+
+  struct __ring {
+    explicit __ring(size_t capacity) : __mask(capacity - 1), __slots(new atomic<T*>[capacity]) { }
+    T* __get(int64_t i) const noexcept { return __slots[size_t(i) & __mask].load(memory_order_relaxed); }
+    void __put(int64_t i, T* item) noexcept { __slots[size_t(i) & __mask].store(item, memory_order_relaxed); }
+    size_t __mask;
+    unique_ptr<atomic<T*>[]> __slots;
+  };
+
+  __ring* __grow(__ring* old, int64_t t, int64_t b) {
+    __buffers.emplace_back(new __ring(2 * (old->__mask + 1)));
+    __ring* ring = __buffers.back().get();
+    for(int64_t i = t; i < b; ++i) ring->__put(i, old->__get(i));
+    __buffer.store(ring, memory_order_release);
+    return ring;
+  }
+
+  // top and bottom on separate lines: thieves hammer the first, the owner the
+  // second.  Padding rather than alignas, which would need C++17 aligned new.
+  atomic<int64_t> __top;
+  char __pad_top[64 - sizeof(atomic<int64_t>)];
+  atomic<int64_t> __bottom;
+  char __pad_bottom[64 - sizeof(atomic<int64_t>)];
+  atomic<__ring*> __buffer;
+  vector<unique_ptr<__ring>> __buffers;
+};
+
+//------------------------------------------------------------------------------
+
+template <size_t Rank>
+struct __tile_box {
+  array<size_t, Rank> lo;
+  array<size_t, Rank> hi;
+
+  size_t volume() const noexcept {
+    size_t v = 1;
+    for(size_t r = 0; r < Rank; ++r) v *= hi[r] - lo[r];
+    return v;
+  }
+};
+
+// Dimensions outermost first: the layout's loop order when it has a static
+// one, decreasing stride for other strided mappings, row-major otherwise.
+template <class Mapping, size_t... Order>
+array<size_t, Mapping::extents_type::rank()> __tile_split_order(Mapping const&, index_sequence<Order...>*) {
+  return {{Order...}};
+}
+
+template <class Mapping>
+array<size_t, Mapping::extents_type::rank()> __tile_split_order(Mapping const& map, void*) {
+  constexpr size_t rank = Mapping::extents_type::rank();
+  array<size_t, rank> order;
+  for(size_t r = 0; r < rank; ++r) order[r] = r;
+  if(map.is_strided()) {
+    for(size_t a = 1; a < rank; ++a) {
+      for(size_t b = a; b > 0 && map.stride(order[b - 1]) < map.stride(order[b]); --b) {
+        const size_t t = order[b]; order[b] = order[b - 1]; order[b - 1] = t;
+      }
+    }
+  }
+  return order;
+}
+
+template <size_t Rank, class F>
+class __tile_scheduler {
+public:
+
+  using box_type = __tile_box<Rank>;
+
+  __tile_scheduler(array<size_t, Rank> const& order, array<size_t, Rank> const& quantum,
+                   size_t grain, size_t workers, F& f)
+    : __order(order), __quantum(quantum), __grain(grain == 0 ? 1 : grain),
+      __f(f), __workers(workers), __boxes(workers)
+  { }
+
+  void run(box_type const& whole, size_t threads) {
+    __remaining.store(whole.volume(), memory_order_relaxed);
+    if(__remaining.load(memory_order_relaxed) == 0) return;
+    __boxes[0].push_back(whole);
+    __workers[0].__deque.push(&__boxes[0].back());
+    __parallel_for(__workers.size(), threads, [this](size_t w) { __work(w); });
+  }
+
+  // Split b in two along the outermost dimension that can still be split,
+  // keeping the cut on a multiple of that dimension's quantum when possible.
+  bool split(box_type& b, box_type& upper) const {
+    if(b.volume() <= __grain) return false;
+    for(size_t r = 0; r < Rank; ++r) {
+      const size_t d = __order[r];
+      const size_t n = b.hi[d] - b.lo[d];
+      if(n < 2) continue;
+      size_t cut = b.lo[d] + n / 2;
+      const size_t q = __quantum[d];
+      if(q > 1 && cut / q * q > b.lo[d]) cut = cut / q * q;
+      upper = b;
+      upper.lo[d] = cut;
+      b.hi[d] = cut;
+      return true;
+    }
+    return false;
+  }
+
+private:
+
+  struct __worker {
+    __chase_lev_deque<box_type> __deque;
+  };
+
+  void __process(size_t w, box_type b) {
+    box_type upper;
+    while(split(b, upper)) {
+      __boxes[w].push_back(upper);
+      __workers[w].__deque.push(&__boxes[w].back());
+    }
+    // A throwing tile never leaves __remaining, so the other workers must be
+    // told to stop before the exception goes to the backend.
+    try {
+      __f(b);
+    } catch(...) {
+      __cancelled.store(true, memory_order_release);
+      throw;
+    }
+    __remaining.fetch_sub(b.volume(), memory_order_acq_rel);
+  }
+
+  void __work(size_t w) {
+    uint64_t seed = 0x9E3779B97F4A7C15ull * (w + 1);
+    const size_t n = __workers.size();
+    unsigned idle = 0;
+    while(__remaining.load(memory_order_acquire) != 0 && !__cancelled.load(memory_order_acquire)) {
+      box_type* b = __workers[w].__deque.take();
+      if(b == nullptr && n > 1) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        const size_t victim = size_t(seed % (n - 1));
+        b = __workers[victim < w ? victim : victim + 1].__deque.steal();
+      }
+      if(b != nullptr) {
+        idle = 0;
+        __process(w, *b);
+      }
+      else if(++idle > 64) {
+        this_thread::yield();
+      }
+    }
+  }
+
+  array<size_t, Rank> __order;
+  array<size_t, Rank> __quantum;
+  size_t __grain;
+  F& __f;
+  vector<__worker> __workers;
+  // Box storage per worker; std::deque keeps addresses stable on push_back.
+  vector<std::deque<box_type>> __boxes;
+  atomic<size_t> __remaining{0};
+  atomic<bool> __cancelled{false};
+};
+
+template <class Mapping, class F>
+void __for_each_tile(size_t threads, bool parallel, Mapping const& map, size_t element_bytes, size_t grain, F& f) {
+  constexpr size_t rank = Mapping::extents_type::rank();
+  using order_t = typename __layout_loop_order<typename Mapping::layout_type, rank>::type;
+  using box_t = __tile_box<rank>;
+
+  box_t whole;
+  for(size_t r = 0; r < rank; ++r) {
+    whole.lo[r] = 0;
+    whole.hi[r] = map.extents().extent(r);
+  }
+  if(whole.volume() == 0) return;
+
+  // Cut positions that keep the written lines of neighbouring tiles apart.
+  array<size_t, rank> quantum;
+  for(size_t r = 0; r < rank; ++r) {
+    const size_t bytes = map.is_strided() ? map.stride(r) * element_bytes : 0;
+    quantum[r] = element_bytes == 0 ? 1 : __parallel_cache_line / __gcd(__parallel_cache_line, bytes);
+  }
+
+  auto leaf = [&](box_t const& b) { f(b.lo, b.hi); };
+  const size_t workers = parallel ? __parallel_concurrency(threads) : 1;
+  __tile_scheduler<rank, decltype(leaf)> sched(
+    __tile_split_order(map, static_cast<order_t*>(nullptr)), quantum, grain, workers, leaf);
+  sched.run(whole, threads);
+}
+
+template <class MDSpan, class F, size_t... Is>
+void __call_tile(MDSpan const& m, F& f, array<size_t, sizeof...(Is)> const& lo,
+                 array<size_t, sizeof...(Is)> const& hi, index_sequence<Is...>) {
+  f(submdspan(m, pair<size_t, size_t>(lo[Is], hi[Is])...), lo);
+}
+
+inline size_t __tile_threads(execution::sequenced_policy const&) noexcept { return 1; }
+inline bool __tile_parallel(execution::sequenced_policy const&) noexcept { return false; }
+template <class Policy>
+size_t __tile_threads(Policy const& p) noexcept { return __policy_threads(p); }
+template <class Policy>
+bool __tile_parallel(Policy const&) noexcept { return true; }
+
+} // end namespace detail
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class Extents, class F,
+  /* requires */ (execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_extents_v<Extents>)
+)
+void for_each_tile(ExecutionPolicy const& policy, Extents const& exts, size_t grain, F f) {
+  detail::__for_each_tile(detail::__tile_threads(policy), detail::__tile_parallel(policy),
+    layout_right::mapping<Extents>(exts), 0, grain, f);
+}
+
+MDSPAN_TEMPLATE_REQUIRES(
+  class ExecutionPolicy, class MDSpan, class F,
+  /* requires */ (
+    execution::is_execution_policy<ExecutionPolicy>::value && detail::__is_mdspan<MDSpan>::value &&
+    (MDSpan::extents_type::rank() > 0)
+  )
+)
+void for_each_tile(ExecutionPolicy const& policy, MDSpan m, size_t grain, F f) {
+  constexpr size_t rank = MDSpan::extents_type::rank();
+  auto leaf = [&](array<size_t, rank> const& lo, array<size_t, rank> const& hi) {
+    detail::__call_tile(m, f, lo, hi, make_index_sequence<rank>());
+  };
+  detail::__for_each_tile(detail::__tile_threads(policy), detail::__tile_parallel(policy),
+    m.mapping(), sizeof(typename MDSpan::element_type), grain, leaf);
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,210 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "macros.hpp"
+#include "dynamic_extent.hpp"
+
+#include <cstddef> // size_t
+
+#if MDSPAN_CHECK_BOUNDS
+#  include <cstdio> // fprintf
+#  include <cstdlib> // abort
+#  include <array>
+#  include <tuple>
+#endif
+
+namespace std {
+namespace experimental {
+namespace detail {
+
+// Two extents types of equal rank agree in every dimension that is static in
+// both; algorithms static_assert this before comparing the dynamic extents
+// with _MDSPAN_CHECK_EXTENTS.
+MDSPAN_INLINE_FUNCTION
+constexpr bool __static_extent_match(size_t a, size_t b) noexcept {
+  return a == dynamic_extent || b == dynamic_extent || a == b;
+}
+
+template <class Extents1, class Extents2>
+MDSPAN_INLINE_FUNCTION
+constexpr bool __static_extents_match(size_t r = 0) noexcept {
+  return r >= Extents1::rank() ||
+    (__static_extent_match(Extents1::static_extent(r), Extents2::static_extent(r)) &&
+     __static_extents_match<Extents1, Extents2>(r + 1));
+}
+
+#if MDSPAN_CHECK_BOUNDS
+
+// Report the offending multi-index together with the extents and abort.
+// Element access is noexcept, so throwing is not an option here.
+[[noreturn]] inline void
+__mdspan_index_out_of_bounds(const size_t* indices, const size_t* exts, size_t rank) noexcept {
+  std::fprintf(stderr, "mdspan: index (");
+  for(size_t r = 0; r < rank; ++r) {
+    std::fprintf(stderr, r == 0 ? "%zu" : ", %zu", indices[r]);
+  }
+  std::fprintf(stderr, ") is out of bounds for extents (");
+  for(size_t r = 0; r < rank; ++r) {
+    std::fprintf(stderr, r == 0 ? "%zu" : ", %zu", exts[r]);
+  }
+  std::fprintf(stderr, ")\n");
+  std::abort();
+}
+
+[[noreturn]] inline void
+__mdspan_slice_out_of_bounds(size_t first, size_t last, size_t ext) noexcept {
+  std::fprintf(stderr, "mdspan: submdspan slice [%zu, %zu) is out of bounds for extent %zu\n", first, last, ext);
+  std::abort();
+}
+
+inline void __print_extents(const size_t* exts, size_t rank) noexcept {
+  std::fprintf(stderr, "(");
+  for(size_t r = 0; r < rank; ++r) {
+    std::fprintf(stderr, r == 0 ? "%zu" : ", %zu", exts[r]);
+  }
+  std::fprintf(stderr, ")");
+}
+
+[[noreturn]] inline void
+__mdspan_extents_mismatch(const char* what, const size_t* a, const size_t* b, size_t rank) noexcept {
+  std::fprintf(stderr, "mdspan: %s: extents ", what);
+  __print_extents(a, rank);
+  std::fprintf(stderr, " and ");
+  __print_extents(b, rank);
+  std::fprintf(stderr, " do not match\n");
+  std::abort();
+}
+
+[[noreturn]] inline void
+__mdspan_extent_mismatch(const char* what, size_t a, size_t b) noexcept {
+  std::fprintf(stderr, "mdspan: %s: extent %zu does not match %zu\n", what, a, b);
+  std::abort();
+}
+
+template <class Extents1, class Extents2>
+MDSPAN_INLINE_FUNCTION
+void __check_extents(const char* what, Extents1 const& a, Extents2 const& b) noexcept {
+  static_assert(Extents1::rank() == Extents2::rank(), "Extents of different rank never match.");
+  for(size_t r = 0; r < Extents1::rank(); ++r) {
+    if(a.extent(r) != b.extent(r)) {
+      size_t a_array[Extents1::rank() + 1] = { }, b_array[Extents1::rank() + 1] = { };
+      for(size_t e = 0; e < Extents1::rank(); ++e) {
+        a_array[e] = a.extent(e);
+        b_array[e] = b.extent(e);
+      }
+      __mdspan_extents_mismatch(what, a_array, b_array, Extents1::rank());
+    }
+  }
+}
+
+MDSPAN_INLINE_FUNCTION
+void __check_extent(const char* what, size_t a, size_t b) noexcept {
+  if(a != b) __mdspan_extent_mismatch(what, a, b);
+}
+
+template <class Extents>
+MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+void __check_indices_impl(Extents const& exts, const size_t* indices) noexcept {
+  for(size_t r = 0; r < Extents::rank(); ++r) {
+    if(indices[r] >= exts.extent(r)) {
+      size_t extents_array[Extents::rank() + 1] = { };
+      for(size_t e = 0; e < Extents::rank(); ++e) extents_array[e] = exts.extent(e);
+      __mdspan_index_out_of_bounds(indices, extents_array, Extents::rank());
+    }
+  }
+}
+
+template <class Extents, class... Indices>
+MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+void __check_indices(Extents const& exts, Indices... indices) noexcept {
+  // Negative indices convert to huge size_t values and fail the check too.
+  const size_t indices_array[] = { size_t(indices)..., 0 };
+  __check_indices_impl(exts, indices_array);
+}
+
+template <class Extents, class SizeType, size_t N>
+MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+void __check_indices_array(Extents const& exts, array<SizeType, N> const& indices) noexcept {
+  size_t indices_array[N + 1] = { };
+  for(size_t r = 0; r < N; ++r) indices_array[r] = size_t(indices[r]);
+  __check_indices_impl(exts, indices_array);
+}
+
+MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+void __check_slice(size_t val, size_t ext) noexcept {
+  if(val >= ext) __mdspan_slice_out_of_bounds(val, val + 1, ext);
+}
+
+MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+void __check_slice(std::tuple<size_t, size_t> const& val, size_t ext) noexcept {
+  if(std::get<0>(val) > std::get<1>(val) || std::get<1>(val) > ext)
+    __mdspan_slice_out_of_bounds(std::get<0>(val), std::get<1>(val), ext);
+}
+
+template <class Slice>
+MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+void __check_slice(Slice const&, size_t) noexcept { }
+
+#  define _MDSPAN_CHECK_INDICES(EXTS, ...) ::std::experimental::detail::__check_indices(EXTS, __VA_ARGS__)
+#  define _MDSPAN_CHECK_INDICES_ARRAY(EXTS, INDICES) ::std::experimental::detail::__check_indices_array(EXTS, INDICES)
+#  define _MDSPAN_CHECK_SLICE(SLICE, EXT) ::std::experimental::detail::__check_slice(SLICE, EXT)
+// Operands of an algorithm: equal extents, or one equal extent.
+#  define _MDSPAN_CHECK_EXTENTS(WHAT, A, B) ::std::experimental::detail::__check_extents(WHAT, A, B)
+#  define _MDSPAN_CHECK_EXTENT(WHAT, A, B) ::std::experimental::detail::__check_extent(WHAT, size_t(A), size_t(B))
+
+#else
+
+#  define _MDSPAN_CHECK_INDICES(EXTS, ...)
+#  define _MDSPAN_CHECK_INDICES_ARRAY(EXTS, INDICES)
+#  define _MDSPAN_CHECK_SLICE(SLICE, EXT)
+#  define _MDSPAN_CHECK_EXTENTS(WHAT, A, B)
+#  define _MDSPAN_CHECK_EXTENT(WHAT, A, B)
+
+#endif // MDSPAN_CHECK_BOUNDS
+
+} // end namespace detail
+} // end namespace experimental
+} // end namespace std
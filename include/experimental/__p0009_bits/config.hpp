@@ -252,6 +252,12 @@ static_assert(_MDSPAN_CPLUSPLUS >= MDSPAN_CXX_STD_14, "mdspan requires C++14 or
 #  endif
 #endif
 
+// Opt-in bounds checking of every mdspan index and submdspan slice.  When
+// disabled (the default) the checks are not compiled at all.
+#ifndef MDSPAN_CHECK_BOUNDS
+#  define MDSPAN_CHECK_BOUNDS 0
+#endif
+
 #ifndef MDSPAN_USE_BRACKET_OPERATOR
 #  if defined(__cpp_multidimensional_subscript)
 #    define MDSPAN_USE_BRACKET_OPERATOR 1
@@ -73,6 +73,14 @@
 #  define MDSPAN_INLINE_FUNCTION_DEFAULTED
 #endif
 
+#ifndef _MDSPAN_UNLIKELY
+#  if defined(__GNUC__) || defined(__clang__)
+#    define _MDSPAN_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#  else
+#    define _MDSPAN_UNLIKELY(x) (x)
+#  endif
+#endif
+
 //==============================================================================
 // <editor-fold desc="Preprocessor helpers"> {{{1
 
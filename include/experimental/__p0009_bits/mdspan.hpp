@@ -44,6 +44,7 @@
 
 #pragma once
 
+#include "bounds_check.hpp"
 #include "default_accessor.hpp"
 #include "layout_right.hpp"
 #include "extents.hpp"
@@ -199,6 +200,7 @@ public:
   MDSPAN_FORCE_INLINE_FUNCTION
   constexpr reference operator[](SizeTypes... indices) const noexcept
   {
+    _MDSPAN_CHECK_INDICES(__mapping_ref().extents(), indices...);
     return __accessor_ref().access(__ptr_ref(), __mapping_ref()(size_type(indices)...));
   }
   #endif
@@ -213,6 +215,7 @@ public:
   MDSPAN_FORCE_INLINE_FUNCTION
   constexpr reference operator[](const array<SizeType, N>& indices) const noexcept
   {
+    _MDSPAN_CHECK_INDICES_ARRAY(__mapping_ref().extents(), indices);
     return __impl::template __callop<reference>(*this, indices);
   }
 
@@ -227,6 +230,7 @@ public:
   MDSPAN_FORCE_INLINE_FUNCTION
   constexpr reference operator[](Index idx) const noexcept
   {
+    _MDSPAN_CHECK_INDICES(__mapping_ref().extents(), idx);
     return __accessor_ref().access(__ptr_ref(), __mapping_ref()(size_type(idx)));
   }
   #endif
@@ -242,6 +246,7 @@ public:
   MDSPAN_FORCE_INLINE_FUNCTION
   constexpr reference operator()(SizeTypes... indices) const noexcept
   {
+    _MDSPAN_CHECK_INDICES(__mapping_ref().extents(), indices...);
     return __accessor_ref().access(__ptr_ref(), __mapping_ref()(size_type(indices)...));
   }
 
@@ -255,6 +260,7 @@ public:
   MDSPAN_FORCE_INLINE_FUNCTION
   constexpr reference operator()(const array<SizeType, N>& indices) const noexcept
   {
+    _MDSPAN_CHECK_INDICES_ARRAY(__mapping_ref().extents(), indices);
     return __impl::template __callop<reference>(*this, indices);
   }
   #endif
@@ -45,6 +45,7 @@
 #pragma once
 
 #include "mdspan.hpp"
+#include "bounds_check.hpp"
 #include "full_extent_t.hpp"
 #include "dynamic_extent.hpp"
 #include "layout_left.hpp"
@@ -73,7 +74,10 @@ struct __slice_wrap {
 template <size_t OldExtent, size_t OldStaticStride>
 MDSPAN_INLINE_FUNCTION constexpr
 __slice_wrap<OldExtent, OldStaticStride, size_t>
-__wrap_slice(size_t val, size_t ext, size_t stride) { return { val, ext, stride }; }
+__wrap_slice(size_t val, size_t ext, size_t stride) {
+  _MDSPAN_CHECK_SLICE(val, ext);
+  return { val, ext, stride };
+}
 
 template <size_t OldExtent, size_t OldStaticStride>
 MDSPAN_INLINE_FUNCTION constexpr
@@ -86,6 +90,7 @@ MDSPAN_INLINE_FUNCTION constexpr
 __slice_wrap<OldExtent, OldStaticStride, std::tuple<size_t, size_t>>
 __wrap_slice(std::tuple<size_t, size_t> const& val, size_t ext, size_t stride)
 {
+  _MDSPAN_CHECK_SLICE(val, ext);
   return { val, ext, stride };
 }
 
@@ -0,0 +1,136 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "conjugated.hpp"
+#include "linalg_helpers.hpp"
+
+#include <cstddef> // size_t
+#include <utility> // declval
+
+namespace std {
+namespace experimental {
+namespace linalg {
+
+namespace detail {
+
+template <class T, class V1, class V2>
+T __dot_unscaled(V1 const& v1, V2 const& v2, T sum) {
+  auto const a1 = v1.accessor();
+  auto const a2 = v2.accessor();
+  auto const m1 = v1.mapping();
+  auto const m2 = v2.mapping();
+  const size_t n = v1.extent(0);
+  for(size_t i = 0; i < n; ++i) {
+    sum += a1.access(v1.data(), m1(i)) * a2.access(v2.data(), m2(i));
+  }
+  return sum;
+}
+
+} // end namespace detail
+
+// Returns init + sum(v1[i] * v2[i]).  If either argument is a scaled() view
+// the scaling factors are applied once to the sum, not to every element.
+template <
+  class ET1, class Extents1, class Layout1, class Accessor1,
+  class ET2, class Extents2, class Layout2, class Accessor2,
+  class T
+>
+T dot(
+  mdspan<ET1, Extents1, Layout1, Accessor1> const& v1,
+  mdspan<ET2, Extents2, Layout2, Accessor2> const& v2,
+  T init)
+{
+  static_assert(Extents1::rank() == 1 && Extents2::rank() == 1,
+    "std::experimental::linalg::dot requires rank-1 mdspans.");
+  const auto alpha = detail::__combine_scaling(detail::__scaling_factor(v1), detail::__scaling_factor(v2));
+  return init + T(detail::__apply_scaling(alpha,
+    detail::__dot_unscaled(detail::__unscaled(v1), detail::__unscaled(v2), T{})));
+}
+
+template <
+  class ET1, class Extents1, class Layout1, class Accessor1,
+  class ET2, class Extents2, class Layout2, class Accessor2
+>
+auto dot(
+  mdspan<ET1, Extents1, Layout1, Accessor1> const& v1,
+  mdspan<ET2, Extents2, Layout2, Accessor2> const& v2)
+  -> decltype(declval<typename Accessor1::reference>() * declval<typename Accessor2::reference>())
+{
+  using sum_t = decltype(declval<typename Accessor1::reference>() * declval<typename Accessor2::reference>());
+  return dot(v1, v2, sum_t{});
+}
+
+// Conjugated dot product: init + sum(conj(v1[i]) * v2[i]).
+template <
+  class ET1, class Extents1, class Layout1, class Accessor1,
+  class ET2, class Extents2, class Layout2, class Accessor2,
+  class T
+>
+T dotc(
+  mdspan<ET1, Extents1, Layout1, Accessor1> const& v1,
+  mdspan<ET2, Extents2, Layout2, Accessor2> const& v2,
+  T init)
+{
+  return dot(conjugated(v1), v2, init);
+}
+
+template <
+  class ET1, class Extents1, class Layout1, class Accessor1,
+  class ET2, class Extents2, class Layout2, class Accessor2
+>
+auto dotc(
+  mdspan<ET1, Extents1, Layout1, Accessor1> const& v1,
+  mdspan<ET2, Extents2, Layout2, Accessor2> const& v2)
+  -> decltype(dot(conjugated(v1), v2))
+{
+  return dot(conjugated(v1), v2);
+}
+
+} // end namespace linalg
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,97 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "linalg_helpers.hpp"
+
+namespace std {
+namespace experimental {
+namespace linalg {
+
+namespace detail {
+
+template <class AlphaX, class X, class AlphaY, class Y, class Z>
+void __add_unscaled(AlphaX const& alpha_x, X const& x, AlphaY const& alpha_y, Y const& y, Z const& z) {
+  auto const ax = x.accessor();
+  auto const ay = y.accessor();
+  auto const az = z.accessor();
+  auto const mx = x.mapping();
+  auto const my = y.mapping();
+  auto const mz = z.mapping();
+  experimental::for_each_index(mz, [&](auto... idxs) {
+    az.access(z.data(), mz(idxs...)) =
+      __apply_scaling(alpha_x, ax.access(x.data(), mx(idxs...))) +
+      __apply_scaling(alpha_y, ay.access(y.data(), my(idxs...)));
+  });
+}
+
+} // end namespace detail
+
+// z = x + y, elementwise, for mdspans of any (matching) rank.  Passing
+// scaled() views computes z = alpha * x + beta * y in a single pass over
+// memory without materializing the scaled operands.  z may alias x or y.
+template <
+  class ETX, class ExtentsX, class LayoutX, class AccessorX,
+  class ETY, class ExtentsY, class LayoutY, class AccessorY,
+  class ETZ, class ExtentsZ, class LayoutZ, class AccessorZ
+>
+void add(
+  mdspan<ETX, ExtentsX, LayoutX, AccessorX> const& x,
+  mdspan<ETY, ExtentsY, LayoutY, AccessorY> const& y,
+  mdspan<ETZ, ExtentsZ, LayoutZ, AccessorZ> const& z)
+{
+  static_assert(ExtentsX::rank() == ExtentsZ::rank() && ExtentsY::rank() == ExtentsZ::rank(),
+    "std::experimental::linalg::add requires mdspans of the same rank.");
+  detail::__add_unscaled(
+    detail::__scaling_factor(x), detail::__unscaled(x),
+    detail::__scaling_factor(y), detail::__unscaled(y),
+    z);
+}
+
+} // end namespace linalg
+} // end namespace experimental
+} // end namespace std
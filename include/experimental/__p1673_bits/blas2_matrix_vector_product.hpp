@@ -0,0 +1,422 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__mdspan_ext_bits/parallel_algorithms.hpp"
+#include "../__mdspan_ext_bits/reduce.hpp"
+#include "../__mdspan_ext_bits/simd.hpp"
+#include "linalg_helpers.hpp"
+
+#include <algorithm> // min
+#include <cstddef> // size_t, ptrdiff_t
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+namespace linalg {
+
+namespace detail {
+
+//==============================================================================
+// matrix_vector_product picks its inner loop from the layout of A:
+//
+//   rows of A contiguous (layout_right):     y(i) = dot(A(i, :), x), a few rows
+//                                            at a time so each load of x is
+//                                            shared, with simd accumulators
+//   columns of A contiguous (layout_left):   y(block) += A(block, j) * x(j), a
+//                                            few columns at a time into a
+//                                            block of y held in a local buffer
+//   anything else:                           the same loops through the
+//                                            accessor and mapping, by element
+//
+// Either way the rows of y are split into blocks, and each block is computed
+// and written by exactly one task, so the parallel overloads need no atomics
+// or reduction.  x is first packed into a contiguous buffer in y's value type
+// (it is much smaller than A).  With several right-hand sides (rank-2 x and
+// y) the kernels work on a few of them at once, so every element of A loaded
+// from memory is used for each of them.
+
+template <class T, bool = experimental::detail::__simd_vectorizable<T>::value>
+struct __gemv_tiling {
+  static constexpr size_t lanes() noexcept {
+    return sizeof(T) >= experimental::detail::__simd_native_bytes ? 1 : experimental::detail::__simd_native_bytes / sizeof(T);
+  }
+  // Rows and right-hand sides per step of the dot kernel: rows * rhs
+  // accumulators plus rows + rhs loaded vectors must fit in the registers.
+  static constexpr size_t rows() noexcept { return 4; }
+  static constexpr size_t rhs() noexcept { return experimental::detail::__simd_native_bytes == 64 ? 4 : 2; }
+  // Rows of y per block (and at most per task).
+  static constexpr size_t block() noexcept { return 256; }
+};
+
+template <class T>
+struct __gemv_tiling<T, false> {
+  static constexpr size_t lanes() noexcept { return 1; }
+  static constexpr size_t rows() noexcept { return 1; }
+  static constexpr size_t rhs() noexcept { return 1; }
+  static constexpr size_t block() noexcept { return 256; }
+};
+
+// A rank-1 x or y is a single right-hand side; a rank-2 one has extent(1).
+template <class V>
+using __gemv_rank = integral_constant<size_t, V::extents_type::rank()>;
+
+template <class V>
+size_t __gemv_rhs_count(V const&, integral_constant<size_t, 1>) { return 1; }
+
+template <class V>
+size_t __gemv_rhs_count(V const& v, integral_constant<size_t, 2>) { return v.extent(1); }
+
+template <class V>
+size_t __gemv_offset(V const& v, size_t i, size_t, integral_constant<size_t, 1>) { return size_t(v.mapping()(i)); }
+
+template <class V>
+size_t __gemv_offset(V const& v, size_t i, size_t r, integral_constant<size_t, 2>) { return size_t(v.mapping()(i, r)); }
+
+// out[i * NB + r] = sum over j < k of a[i * lda + j] * x[r * k + j].
+template <class T, size_t MB, size_t NB, size_t Lanes>
+struct __gemv_dot_kernel {
+  using __batch = experimental::detail::__simd_batch<T, Lanes>;
+  using __vector = typename __batch::type;
+  template <size_t N>
+  using __unrolled = experimental::detail::__static_for<0, N>;
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __run(ptrdiff_t k, T const* a, ptrdiff_t lda, T const* x, T* out) noexcept {
+    __vector c[MB * NB];
+    __unrolled<MB * NB>::__apply([&](size_t ir) { c[ir] = __vector(); });
+    ptrdiff_t j = 0;
+    for(; j + ptrdiff_t(Lanes) <= k; j += Lanes) {
+      __vector av[MB], xv[NB];
+      __unrolled<MB>::__apply([&](size_t i) { __batch::__load(av[i], a + ptrdiff_t(i) * lda + j); });
+      __unrolled<NB>::__apply([&](size_t r) { __batch::__load(xv[r], x + ptrdiff_t(r) * k + j); });
+      __unrolled<MB * NB>::__apply([&](size_t ir) { c[ir] += av[ir / NB] * xv[ir % NB]; });
+    }
+    __unrolled<MB * NB>::__apply([&](size_t ir) {
+      T lanes[Lanes];
+      __batch::__store(c[ir], lanes);
+      T sum = lanes[0];
+      for(size_t l = 1; l < Lanes; ++l) sum += lanes[l];
+      T const* const ai = a + ptrdiff_t(ir / NB) * lda;
+      T const* const xr = x + ptrdiff_t(ir % NB) * k;
+      for(ptrdiff_t jj = j; jj < k; ++jj) sum += ai[jj] * xr[jj];
+      out[ir] = sum;
+    });
+  }
+};
+
+// buf[r * mb + i] = sum over j of A(i0 + i, j) * xp[r * k + j] for r < nb,
+// from rows of A with unit stride, starting at a with row stride lda.
+template <class T>
+void __gemv_rows_raw(ptrdiff_t mb, ptrdiff_t k, T const* a, ptrdiff_t lda, T const* xp, size_t nb, T* buf) {
+  using tiling = __gemv_tiling<T>;
+  constexpr size_t MB = tiling::rows();
+  constexpr size_t NB = tiling::rhs();
+  T out[MB * NB];
+  ptrdiff_t i = 0;
+  for(; i + ptrdiff_t(MB) <= mb; i += MB) {
+    if(nb == NB) {
+      __gemv_dot_kernel<T, MB, NB, tiling::lanes()>::__run(k, a + i * lda, lda, xp, out);
+      for(size_t ir = 0; ir < MB * NB; ++ir) buf[ptrdiff_t(ir % NB) * mb + i + ptrdiff_t(ir / NB)] = out[ir];
+    } else {
+      for(size_t r = 0; r < nb; ++r) {
+        __gemv_dot_kernel<T, MB, 1, tiling::lanes()>::__run(k, a + i * lda, lda, xp + ptrdiff_t(r) * k, out);
+        for(size_t ii = 0; ii < MB; ++ii) buf[ptrdiff_t(r) * mb + i + ptrdiff_t(ii)] = out[ii];
+      }
+    }
+  }
+  for(; i < mb; ++i) {
+    for(size_t r = 0; r < nb; ++r) {
+      __gemv_dot_kernel<T, 1, 1, tiling::lanes()>::__run(k, a + i * lda, lda, xp + ptrdiff_t(r) * k, out);
+      buf[ptrdiff_t(r) * mb + i] = out[0];
+    }
+  }
+}
+
+// The same result from columns of A with unit stride, starting at a with
+// column stride lda: four columns at a time are added into the block of y in
+// buf for every right-hand side while they are still in L1.
+template <class T>
+void __gemv_columns_raw(ptrdiff_t mb, ptrdiff_t k, T const* a, ptrdiff_t lda, T const* xp, size_t nb, T* buf) {
+  std::fill(buf, buf + ptrdiff_t(nb) * mb, T());
+  ptrdiff_t j = 0;
+  for(; j + 4 <= k; j += 4) {
+    T const* const a0 = a + j * lda;
+    T const* const a1 = a0 + lda;
+    T const* const a2 = a1 + lda;
+    T const* const a3 = a2 + lda;
+    for(size_t r = 0; r < nb; ++r) {
+      T const* const xr = xp + ptrdiff_t(r) * k + j;
+      const T x0 = xr[0], x1 = xr[1], x2 = xr[2], x3 = xr[3];
+      T* const yr = buf + ptrdiff_t(r) * mb;
+      for(ptrdiff_t i = 0; i < mb; ++i) yr[i] += a0[i] * x0 + a1[i] * x1 + a2[i] * x2 + a3[i] * x3;
+    }
+  }
+  for(; j < k; ++j) {
+    T const* const aj = a + j * lda;
+    for(size_t r = 0; r < nb; ++r) {
+      const T xj = xp[ptrdiff_t(r) * k + j];
+      T* const yr = buf + ptrdiff_t(r) * mb;
+      for(ptrdiff_t i = 0; i < mb; ++i) yr[i] += aj[i] * xj;
+    }
+  }
+}
+
+// Through the accessor and mapping, in the loop order that walks A in memory
+// order when either of its dimensions has unit stride.
+template <class T, class A>
+void __gemv_block(A const& a, size_t i0, size_t mb, T const* xp, size_t nb, T* buf, false_type /* raw */) {
+  const auto acc = a.accessor();
+  const auto map = a.mapping();
+  const size_t k = a.extent(1);
+  if(__unit_stride_dim(map) == 0) {
+    std::fill(buf, buf + nb * mb, T());
+    for(size_t j = 0; j < k; ++j) {
+      for(size_t r = 0; r < nb; ++r) {
+        const T xj = xp[r * k + j];
+        for(size_t i = 0; i < mb; ++i) buf[r * mb + i] += T(acc.access(a.data(), map(i0 + i, j))) * xj;
+      }
+    }
+  } else {
+    for(size_t i = 0; i < mb; ++i) {
+      for(size_t r = 0; r < nb; ++r) {
+        T sum = T();
+        for(size_t j = 0; j < k; ++j) sum += T(acc.access(a.data(), map(i0 + i, j))) * xp[r * k + j];
+        buf[r * mb + i] = sum;
+      }
+    }
+  }
+}
+
+template <class T, class A>
+void __gemv_block(A const& a, size_t i0, size_t mb, T const* xp, size_t nb, T* buf, true_type /* raw */) {
+  const auto map = a.mapping();
+  const ptrdiff_t k = ptrdiff_t(a.extent(1));
+  T const* const base = a.data() + map(i0, 0);
+  switch(__unit_stride_dim(map)) {
+    case 1: __gemv_rows_raw(ptrdiff_t(mb), k, base, ptrdiff_t(map.stride(0)), xp, nb, buf); break;
+    case 0: __gemv_columns_raw(ptrdiff_t(mb), k, base, ptrdiff_t(map.stride(1)), xp, nb, buf); break;
+    default: __gemv_block(a, i0, mb, xp, nb, buf, false_type()); break;
+  }
+}
+
+// Plain pointer access to a strided A of the value type the kernels compute in.
+template <class A, class T>
+struct __gemv_is_raw : integral_constant<bool,
+  experimental::detail::__simd_is_raw<A>::value &&
+  experimental::detail::__simd_vectorizable<T>::value &&
+  A::mapping_type::is_always_strided() &&
+  _MDSPAN_TRAIT(is_same, remove_const_t<typename A::element_type>, T)
+> { };
+
+// y = alpha * A * x, plus z if update.  z may be y: every element of z is
+// read before the same element of y is written.
+template <class Policy, class Alpha, class A, class X, class Z, class Y>
+void __matrix_vector_product(Policy const& policy, Alpha const& alpha, A const& a, X const& x,
+                             Z const& z, Y const& y, bool update) {
+  using T = typename Y::value_type;
+  using tiling = __gemv_tiling<T>;
+  using rank = __gemv_rank<Y>;
+  const size_t m = a.extent(0);
+  const size_t k = a.extent(1);
+  const size_t nrhs = __gemv_rhs_count(y, rank());
+  _MDSPAN_CHECK_EXTENT("matrix_vector_product", x.extent(0), k);
+  _MDSPAN_CHECK_EXTENT("matrix_vector_product", y.extent(0), m);
+  _MDSPAN_CHECK_EXTENT("matrix_vector_product", __gemv_rhs_count(x, rank()), nrhs);
+  _MDSPAN_CHECK_EXTENTS("matrix_vector_product", z.extents(), y.extents());
+  if(m == 0 || nrhs == 0) return;
+
+  vector<T> xp(k * nrhs);
+  {
+    const auto acc = x.accessor();
+    for(size_t r = 0; r < nrhs; ++r) {
+      for(size_t j = 0; j < k; ++j) xp[r * k + j] = T(acc.access(x.data(), __gemv_offset(x, j, r, rank())));
+    }
+  }
+
+  // Blocks of rows of y are the parallel tasks; shrink them (down to one
+  // step of the dot kernel) until every thread gets at least one.
+  const size_t tasks_wanted = experimental::detail::__policy_tasks(policy);
+  const size_t rows_per_task = ((m + tasks_wanted - 1) / tasks_wanted + tiling::rows() - 1) / tiling::rows() * tiling::rows();
+  const size_t mb_max = std::min(tiling::block(), rows_per_task);
+
+  experimental::detail::__run_tasks(policy, (m + mb_max - 1) / mb_max, [&](size_t task) {
+    const size_t i0 = task * mb_max;
+    const size_t mb = std::min(mb_max, m - i0);
+    const auto y_acc = y.accessor();
+    const auto z_acc = z.accessor();
+    T buf[tiling::rhs() * tiling::block()];
+    for(size_t r0 = 0; r0 < nrhs; r0 += tiling::rhs()) {
+      const size_t nb = std::min(tiling::rhs(), nrhs - r0);
+      if(k == 0) std::fill(buf, buf + nb * mb, T());
+      else __gemv_block(a, i0, mb, xp.data() + r0 * k, nb, buf, __gemv_is_raw<A, T>());
+      for(size_t r = 0; r < nb; ++r) {
+        for(size_t i = 0; i < mb; ++i) {
+          T value = T(__apply_scaling(alpha, buf[r * mb + i]));
+          if(update) value = T(z_acc.access(z.data(), __gemv_offset(z, i0 + i, r0 + r, rank()))) + value;
+          y_acc.access(y.data(), __gemv_offset(y, i0 + i, r0 + r, rank())) = value;
+        }
+      }
+    }
+  });
+}
+
+template <class A, class X, class Y>
+struct __gemv_check {
+  static_assert(A::extents_type::rank() == 2,
+    "std::experimental::linalg::matrix_vector_product requires a rank-2 A.");
+  static_assert(X::extents_type::rank() == Y::extents_type::rank() &&
+    (Y::extents_type::rank() == 1 || Y::extents_type::rank() == 2),
+    "std::experimental::linalg::matrix_vector_product requires vectors (rank 1) or blocks of vectors (rank 2) x and y.");
+  static_assert(
+    experimental::detail::__static_extent_match(A::extents_type::static_extent(1), X::extents_type::static_extent(0)) &&
+    experimental::detail::__static_extent_match(A::extents_type::static_extent(0), Y::extents_type::static_extent(0)) &&
+    (Y::extents_type::rank() == 1 ||
+     experimental::detail::__static_extent_match(X::extents_type::static_extent(Y::extents_type::rank() - 1),
+                                                 Y::extents_type::static_extent(Y::extents_type::rank() - 1))),
+    "std::experimental::linalg::matrix_vector_product requires A (M x K), x (K or K x R) and y (M or M x R).");
+  static constexpr bool value = true;
+};
+
+} // end namespace detail
+
+// y = A * x for a rank-2 A of any layout and accessor.  The kernel follows the
+// layout of A: dot products over rows when they are contiguous (layout_right),
+// updates of a block of y by columns when those are (layout_left), so both
+// read A in memory order; pass transposed(A) for y = A^T * x.  x and y may
+// also be rank 2 (K x R and M x R), computing R products at once while
+// reading A only once per few of them.  scaled() factors of A and x are
+// applied once per element of y.  y must not alias A or x.  The overloads
+// taking an execution policy split the rows of y over threads under par /
+// par_unseq; each row is written by one thread.
+template <
+  class ETA, class ExtentsA, class LayoutA, class AccessorA,
+  class ETX, class ExtentsX, class LayoutX, class AccessorX,
+  class ETY, class ExtentsY, class LayoutY, class AccessorY
+>
+void matrix_vector_product(
+  mdspan<ETA, ExtentsA, LayoutA, AccessorA> const& A,
+  mdspan<ETX, ExtentsX, LayoutX, AccessorX> const& x,
+  mdspan<ETY, ExtentsY, LayoutY, AccessorY> const& y)
+{
+  static_assert(detail::__gemv_check<mdspan<ETA, ExtentsA, LayoutA, AccessorA>, mdspan<ETX, ExtentsX, LayoutX, AccessorX>,
+    mdspan<ETY, ExtentsY, LayoutY, AccessorY>>::value, "");
+  detail::__matrix_vector_product(execution::seq,
+    detail::__combine_scaling(detail::__scaling_factor(A), detail::__scaling_factor(x)),
+    detail::__unscaled(A), detail::__unscaled(x), y, y, false);
+}
+
+template <
+  class ExecutionPolicy,
+  class ETA, class ExtentsA, class LayoutA, class AccessorA,
+  class ETX, class ExtentsX, class LayoutX, class AccessorX,
+  class ETY, class ExtentsY, class LayoutY, class AccessorY,
+  class = typename enable_if<execution::is_execution_policy<ExecutionPolicy>::value>::type
+>
+void matrix_vector_product(
+  ExecutionPolicy const& policy,
+  mdspan<ETA, ExtentsA, LayoutA, AccessorA> const& A,
+  mdspan<ETX, ExtentsX, LayoutX, AccessorX> const& x,
+  mdspan<ETY, ExtentsY, LayoutY, AccessorY> const& y)
+{
+  static_assert(detail::__gemv_check<mdspan<ETA, ExtentsA, LayoutA, AccessorA>, mdspan<ETX, ExtentsX, LayoutX, AccessorX>,
+    mdspan<ETY, ExtentsY, LayoutY, AccessorY>>::value, "");
+  detail::__matrix_vector_product(policy,
+    detail::__combine_scaling(detail::__scaling_factor(A), detail::__scaling_factor(x)),
+    detail::__unscaled(A), detail::__unscaled(x), y, y, false);
+}
+
+// y = A * x + z.  z may be y (y += A * x).
+template <
+  class ETA, class ExtentsA, class LayoutA, class AccessorA,
+  class ETX, class ExtentsX, class LayoutX, class AccessorX,
+  class ETZ, class ExtentsZ, class LayoutZ, class AccessorZ,
+  class ETY, class ExtentsY, class LayoutY, class AccessorY
+>
+void matrix_vector_product(
+  mdspan<ETA, ExtentsA, LayoutA, AccessorA> const& A,
+  mdspan<ETX, ExtentsX, LayoutX, AccessorX> const& x,
+  mdspan<ETZ, ExtentsZ, LayoutZ, AccessorZ> const& z,
+  mdspan<ETY, ExtentsY, LayoutY, AccessorY> const& y)
+{
+  static_assert(detail::__gemv_check<mdspan<ETA, ExtentsA, LayoutA, AccessorA>, mdspan<ETX, ExtentsX, LayoutX, AccessorX>,
+    mdspan<ETY, ExtentsY, LayoutY, AccessorY>>::value && ExtentsZ::rank() == ExtentsY::rank() &&
+    experimental::detail::__static_extents_match<ExtentsZ, ExtentsY>(),
+    "std::experimental::linalg::matrix_vector_product requires z of the extents of y.");
+  detail::__matrix_vector_product(execution::seq,
+    detail::__combine_scaling(detail::__scaling_factor(A), detail::__scaling_factor(x)),
+    detail::__unscaled(A), detail::__unscaled(x), z, y, true);
+}
+
+template <
+  class ExecutionPolicy,
+  class ETA, class ExtentsA, class LayoutA, class AccessorA,
+  class ETX, class ExtentsX, class LayoutX, class AccessorX,
+  class ETZ, class ExtentsZ, class LayoutZ, class AccessorZ,
+  class ETY, class ExtentsY, class LayoutY, class AccessorY,
+  class = typename enable_if<execution::is_execution_policy<ExecutionPolicy>::value>::type
+>
+void matrix_vector_product(
+  ExecutionPolicy const& policy,
+  mdspan<ETA, ExtentsA, LayoutA, AccessorA> const& A,
+  mdspan<ETX, ExtentsX, LayoutX, AccessorX> const& x,
+  mdspan<ETZ, ExtentsZ, LayoutZ, AccessorZ> const& z,
+  mdspan<ETY, ExtentsY, LayoutY, AccessorY> const& y)
+{
+  static_assert(detail::__gemv_check<mdspan<ETA, ExtentsA, LayoutA, AccessorA>, mdspan<ETX, ExtentsX, LayoutX, AccessorX>,
+    mdspan<ETY, ExtentsY, LayoutY, AccessorY>>::value && ExtentsZ::rank() == ExtentsY::rank() &&
+    experimental::detail::__static_extents_match<ExtentsZ, ExtentsY>(),
+    "std::experimental::linalg::matrix_vector_product requires z of the extents of y.");
+  detail::__matrix_vector_product(policy,
+    detail::__combine_scaling(detail::__scaling_factor(A), detail::__scaling_factor(x)),
+    detail::__unscaled(A), detail::__unscaled(x), z, y, true);
+}
+
+} // end namespace linalg
+} // end namespace experimental
+} // end namespace std
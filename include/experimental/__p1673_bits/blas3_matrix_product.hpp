@@ -0,0 +1,331 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__mdspan_ext_bits/parallel_algorithms.hpp"
+#include "../__mdspan_ext_bits/reduce.hpp"
+#include "../__mdspan_ext_bits/simd.hpp"
+#include "linalg_helpers.hpp"
+
+#include <algorithm> // min
+#include <cstddef> // size_t
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+namespace linalg {
+
+namespace detail {
+
+//==============================================================================
+// matrix_product follows the usual GotoBLAS / BLIS structure:
+//
+//   for each nc-wide block of columns of C
+//     for each kc-deep slice of the inner dimension
+//       pack B(slice, block) into panels of NR columns
+//       for each mc-high block of rows of C        <- one task per block
+//         pack A(block, slice) into panels of MR rows
+//         for each NR-wide panel of B, each MR-high panel of A
+//           micro-kernel: MR x NR tile of C += A panel * B panel
+//
+// Packing reads the operands through their accessor and mapping once per
+// block, so every layout (and scaled() / conjugated() views) feeds the same
+// contiguous panels, and the micro-kernel streams through them with unit
+// stride while an MR x NR tile of C stays in registers.  The kc x nc panel of
+// B is sized for the last-level cache and an mc x kc block of A for L2.
+
+// Register tile and cache blocking for packed value type T.  The tile is MR
+// rows by two vectors of the widest register the target was compiled for
+// (__simd_native_bytes); types that do not vectorize get a small scalar tile.
+template <class T, bool = experimental::detail::__simd_vectorizable<T>::value>
+struct __gemm_tiling {
+  static constexpr size_t lanes() noexcept {
+    return sizeof(T) >= experimental::detail::__simd_native_bytes ? 1 : experimental::detail::__simd_native_bytes / sizeof(T);
+  }
+  // AVX-512 has 32 vector registers, the others 16: leave room for B and A.
+  static constexpr size_t mr() noexcept { return experimental::detail::__simd_native_bytes == 64 ? 12 : 6; }
+  static constexpr size_t nr() noexcept { return 2 * lanes(); }
+  static constexpr size_t kc() noexcept { return 256; }
+  static constexpr size_t mc() noexcept { return ((size_t(1) << 17) / (kc() * sizeof(T))) / mr() * mr(); }
+  static constexpr size_t nc() noexcept { return ((size_t(1) << 22) / (kc() * sizeof(T))) / nr() * nr(); }
+};
+
+template <class T>
+struct __gemm_tiling<T, false> {
+  static constexpr size_t lanes() noexcept { return 1; }
+  static constexpr size_t mr() noexcept { return 4; }
+  static constexpr size_t nr() noexcept { return 4; }
+  static constexpr size_t kc() noexcept { return 128; }
+  static constexpr size_t mc() noexcept { return 64; }
+  static constexpr size_t nc() noexcept { return 1024; }
+};
+
+// tile[i * NR + j] = sum over p < kc of a[p * MR + i] * b[p * NR + j].  The
+// accumulators are NR / lanes simd batches per row; the array fallback of
+// __simd_batch makes this the scalar kernel for types that do not vectorize.
+template <class T, size_t MR, size_t NR, size_t Lanes>
+struct __gemm_micro_kernel {
+  using __batch = experimental::detail::__simd_batch<T, Lanes>;
+  using __vector = typename __batch::type;
+  static constexpr size_t __vectors = NR / Lanes;
+  template <size_t N>
+  using __unrolled = experimental::detail::__static_for<0, N>;
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static void __run(size_t kc, T const* a, T const* b, T* tile) noexcept {
+    __vector c[MR * __vectors];
+    __unrolled<MR * __vectors>::__apply([&](size_t j) { c[j] = __vector(); });
+    for(size_t p = 0; p < kc; ++p) {
+      __vector bv[__vectors];
+      __unrolled<__vectors>::__apply([&](size_t v) { __batch::__load(bv[v], b + v * Lanes); });
+      __unrolled<MR * __vectors>::__apply([&](size_t j) {
+        c[j] += a[j / __vectors] * bv[j % __vectors];
+      });
+      a += MR;
+      b += NR;
+    }
+    __unrolled<MR * __vectors>::__apply([&](size_t j) {
+      __batch::__store(c[j], tile + (j / __vectors) * NR + (j % __vectors) * Lanes);
+    });
+  }
+};
+
+// Rows [i0, i0 + mc) by columns [p0, p0 + kc) of a as panels of MR rows: for
+// every p, the MR values of one column of the panel next to each other.  Rows
+// past mc are zero, so the micro-kernel never needs an edge case.
+template <size_t MR, class T, class A>
+void __gemm_pack_a(A const& a, size_t i0, size_t mc, size_t p0, size_t kc, T* buf) {
+  const auto acc = a.accessor();
+  const auto map = a.mapping();
+  const bool rows_contiguous = __unit_stride_dim(map) == 1;
+  for(size_t r = 0; r < mc; r += MR, buf += MR * kc) {
+    const size_t rows = std::min(MR, mc - r);
+    if(rows_contiguous) {
+      for(size_t i = 0; i < rows; ++i) {
+        for(size_t p = 0; p < kc; ++p) buf[p * MR + i] = T(acc.access(a.data(), map(i0 + r + i, p0 + p)));
+      }
+    } else {
+      for(size_t p = 0; p < kc; ++p) {
+        for(size_t i = 0; i < rows; ++i) buf[p * MR + i] = T(acc.access(a.data(), map(i0 + r + i, p0 + p)));
+      }
+    }
+    for(size_t p = 0; p < kc; ++p) {
+      for(size_t i = rows; i < MR; ++i) buf[p * MR + i] = T();
+    }
+  }
+}
+
+// Rows [p0, p0 + kc) by columns [j0, j0 + nc) of b as panels of NR columns,
+// zero past nc.
+template <size_t NR, class T, class B>
+void __gemm_pack_b(B const& b, size_t p0, size_t kc, size_t j0, size_t nc, T* buf) {
+  const auto acc = b.accessor();
+  const auto map = b.mapping();
+  const bool columns_contiguous = __unit_stride_dim(map) == 0;
+  for(size_t c = 0; c < nc; c += NR, buf += NR * kc) {
+    const size_t cols = std::min(NR, nc - c);
+    if(columns_contiguous) {
+      for(size_t j = 0; j < cols; ++j) {
+        for(size_t p = 0; p < kc; ++p) buf[p * NR + j] = T(acc.access(b.data(), map(p0 + p, j0 + c + j)));
+      }
+    } else {
+      for(size_t p = 0; p < kc; ++p) {
+        for(size_t j = 0; j < cols; ++j) buf[p * NR + j] = T(acc.access(b.data(), map(p0 + p, j0 + c + j)));
+      }
+    }
+    for(size_t p = 0; p < kc; ++p) {
+      for(size_t j = cols; j < NR; ++j) buf[p * NR + j] = T();
+    }
+  }
+}
+
+// C(i0 + i, j0 + j) = alpha * tile (or += for every slice of the inner
+// dimension after the first), for the rows x cols part inside C, walking C in
+// memory order when its columns are the contiguous ones.
+template <size_t NR, class Alpha, class C, class T>
+void __gemm_store_tile(Alpha const& alpha, C const& c, size_t i0, size_t j0, size_t rows, size_t cols,
+                       T const* tile, bool accumulate) {
+  const auto acc = c.accessor();
+  const auto map = c.mapping();
+  auto store = [&](size_t i, size_t j) {
+    auto&& ref = acc.access(c.data(), map(i0 + i, j0 + j));
+    const T value = T(__apply_scaling(alpha, tile[i * NR + j]));
+    if(accumulate) ref = ref + value;
+    else ref = value;
+  };
+  if(__unit_stride_dim(map) == 0) {
+    for(size_t j = 0; j < cols; ++j) {
+      for(size_t i = 0; i < rows; ++i) store(i, j);
+    }
+  } else {
+    for(size_t i = 0; i < rows; ++i) {
+      for(size_t j = 0; j < cols; ++j) store(i, j);
+    }
+  }
+}
+
+template <class Policy, class Alpha, class A, class B, class C>
+void __matrix_product(Policy const& policy, Alpha const& alpha, A const& a, B const& b, C const& c) {
+  using T = typename C::value_type;
+  using tiling = __gemm_tiling<T>;
+  constexpr size_t MR = tiling::mr();
+  constexpr size_t NR = tiling::nr();
+  using kernel = __gemm_micro_kernel<T, MR, NR, tiling::lanes()>;
+
+  _MDSPAN_CHECK_EXTENT("matrix_product", a.extent(0), c.extent(0));
+  _MDSPAN_CHECK_EXTENT("matrix_product", a.extent(1), b.extent(0));
+  _MDSPAN_CHECK_EXTENT("matrix_product", b.extent(1), c.extent(1));
+  const size_t m = c.extent(0);
+  const size_t n = c.extent(1);
+  const size_t k = a.extent(1);
+  if(m == 0 || n == 0) return;
+  if(k == 0) {
+    const auto acc = c.accessor();
+    for(size_t i = 0; i < m; ++i) {
+      for(size_t j = 0; j < n; ++j) acc.access(c.data(), c.mapping()(i, j)) = T();
+    }
+    return;
+  }
+
+  // Blocks of rows of C are the parallel tasks; shrink them (down to MR rows)
+  // until every thread gets at least one.
+  const size_t tasks_wanted = experimental::detail::__policy_tasks(policy);
+  const size_t rows_per_task = ((m + tasks_wanted - 1) / tasks_wanted + MR - 1) / MR * MR;
+  const size_t mc = std::min(tiling::mc(), rows_per_task);
+  const size_t kc_max = std::min(tiling::kc(), k);
+  const size_t nc_max = std::min(tiling::nc(), (n + NR - 1) / NR * NR);
+  vector<T> b_pack(kc_max * nc_max);
+  // One A panel per task, allocated once and repacked for every block of B.
+  const size_t tasks = (m + mc - 1) / mc;
+  const size_t a_panel_size = (mc + MR - 1) / MR * MR * kc_max;
+  vector<T> a_pack(tasks * a_panel_size);
+
+  for(size_t jc = 0; jc < n; jc += tiling::nc()) {
+    const size_t nc = std::min(tiling::nc(), n - jc);
+    for(size_t pc = 0; pc < k; pc += tiling::kc()) {
+      const size_t kc = std::min(tiling::kc(), k - pc);
+      __gemm_pack_b<NR>(b, pc, kc, jc, nc, b_pack.data());
+      T const* const b_panels = b_pack.data();
+      experimental::detail::__run_tasks(policy, tasks, [&](size_t task) {
+        const size_t ic = task * mc;
+        const size_t mcur = std::min(mc, m - ic);
+        T* const a_panels = a_pack.data() + task * a_panel_size;
+        __gemm_pack_a<MR>(a, ic, mcur, pc, kc, a_panels);
+        T tile[MR * NR];
+        for(size_t jr = 0; jr < nc; jr += NR) {
+          for(size_t ir = 0; ir < mcur; ir += MR) {
+            kernel::__run(kc, a_panels + ir * kc, b_panels + jr * kc, tile);
+            __gemm_store_tile<NR>(alpha, c, ic + ir, jc + jr, std::min(MR, mcur - ir), std::min(NR, nc - jr), tile, pc > 0);
+          }
+        }
+      });
+    }
+  }
+}
+
+template <class A, class B, class C>
+struct __gemm_check {
+  static_assert(A::extents_type::rank() == 2 && B::extents_type::rank() == 2 && C::extents_type::rank() == 2,
+    "std::experimental::linalg::matrix_product requires rank-2 mdspans.");
+  static_assert(
+    experimental::detail::__static_extent_match(A::extents_type::static_extent(0), C::extents_type::static_extent(0)) &&
+    experimental::detail::__static_extent_match(A::extents_type::static_extent(1), B::extents_type::static_extent(0)) &&
+    experimental::detail::__static_extent_match(B::extents_type::static_extent(1), C::extents_type::static_extent(1)),
+    "std::experimental::linalg::matrix_product requires A (M x K), B (K x N) and C (M x N).");
+  static constexpr bool value = true;
+};
+
+} // end namespace detail
+
+// C = A * B for rank-2 mdspans of any layout (layout_left, layout_right,
+// layout_stride, ...) and accessor.  The operands are packed into contiguous
+// panels and multiplied by a register-blocked micro-kernel sized for the
+// vector registers the target is compiled for, in C's value_type.  scaled()
+// factors of A and B are applied once per element of C.  C must not alias A
+// or B.  The overload taking an execution policy splits the rows of C over
+// threads under par / par_unseq.
+template <
+  class ETA, class ExtentsA, class LayoutA, class AccessorA,
+  class ETB, class ExtentsB, class LayoutB, class AccessorB,
+  class ETC, class ExtentsC, class LayoutC, class AccessorC
+>
+void matrix_product(
+  mdspan<ETA, ExtentsA, LayoutA, AccessorA> const& A,
+  mdspan<ETB, ExtentsB, LayoutB, AccessorB> const& B,
+  mdspan<ETC, ExtentsC, LayoutC, AccessorC> const& C)
+{
+  static_assert(detail::__gemm_check<mdspan<ETA, ExtentsA, LayoutA, AccessorA>, mdspan<ETB, ExtentsB, LayoutB, AccessorB>,
+    mdspan<ETC, ExtentsC, LayoutC, AccessorC>>::value, "");
+  detail::__matrix_product(execution::seq,
+    detail::__combine_scaling(detail::__scaling_factor(A), detail::__scaling_factor(B)),
+    detail::__unscaled(A), detail::__unscaled(B), C);
+}
+
+template <
+  class ExecutionPolicy,
+  class ETA, class ExtentsA, class LayoutA, class AccessorA,
+  class ETB, class ExtentsB, class LayoutB, class AccessorB,
+  class ETC, class ExtentsC, class LayoutC, class AccessorC,
+  class = typename enable_if<execution::is_execution_policy<ExecutionPolicy>::value>::type
+>
+void matrix_product(
+  ExecutionPolicy const& policy,
+  mdspan<ETA, ExtentsA, LayoutA, AccessorA> const& A,
+  mdspan<ETB, ExtentsB, LayoutB, AccessorB> const& B,
+  mdspan<ETC, ExtentsC, LayoutC, AccessorC> const& C)
+{
+  static_assert(detail::__gemm_check<mdspan<ETA, ExtentsA, LayoutA, AccessorA>, mdspan<ETB, ExtentsB, LayoutB, AccessorB>,
+    mdspan<ETC, ExtentsC, LayoutC, AccessorC>>::value, "");
+  detail::__matrix_product(policy,
+    detail::__combine_scaling(detail::__scaling_factor(A), detail::__scaling_factor(B)),
+    detail::__unscaled(A), detail::__unscaled(B), C);
+}
+
+} // end namespace linalg
+} // end namespace experimental
+} // end namespace std
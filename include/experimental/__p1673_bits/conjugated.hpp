@@ -0,0 +1,146 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+
+#include <complex>
+#include <cstddef> // size_t
+
+namespace std {
+namespace experimental {
+namespace linalg {
+
+namespace detail {
+
+// Only std::complex is conjugated; every other element type passes through
+// unchanged, so conjugated() on a real-valued mdspan is free.
+template <class T>
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr T __conj_if_needed(T const& t) { return t; }
+
+template <class T>
+MDSPAN_FORCE_INLINE_FUNCTION
+_MDSPAN_CONSTEXPR_14 complex<T> __conj_if_needed(complex<T> const& t) { return complex<T>(t.real(), -t.imag()); }
+
+} // end namespace detail
+
+// Read-only accessor that returns the complex conjugate of every element of
+// the nested accessor.
+template <class NestedAccessor>
+class conjugated_accessor {
+public:
+  using nested_accessor_type = NestedAccessor;
+  using element_type = add_const_t<remove_cv_t<typename NestedAccessor::element_type>>;
+  using reference = remove_const_t<element_type>;
+  using pointer = typename NestedAccessor::pointer;
+  using offset_policy = conjugated_accessor<typename NestedAccessor::offset_policy>;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr conjugated_accessor() = default;
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr explicit conjugated_accessor(NestedAccessor const& a)
+    : __nested_accessor(a)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherNestedAccessor,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_constructible, NestedAccessor, OtherNestedAccessor const&)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr conjugated_accessor(conjugated_accessor<OtherNestedAccessor> const& other)
+    : __nested_accessor(other.nested_accessor())
+  { }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const {
+    return detail::__conj_if_needed(reference(__nested_accessor.access(p, i)));
+  }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr typename offset_policy::pointer offset(pointer p, size_t i) const {
+    return __nested_accessor.offset(p, i);
+  }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr NestedAccessor nested_accessor() const { return __nested_accessor; }
+
+private:
+  NestedAccessor __nested_accessor;
+};
+
+// Returns a read-only view of conj(x) without touching memory.
+template <class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<
+  typename conjugated_accessor<Accessor>::element_type,
+  Extents, Layout, conjugated_accessor<Accessor>
+>
+conjugated(mdspan<ElementType, Extents, Layout, Accessor> const& x)
+{
+  using accessor_t = conjugated_accessor<Accessor>;
+  return mdspan<typename accessor_t::element_type, Extents, Layout, accessor_t>(
+    x.data(), x.mapping(), accessor_t(x.accessor())
+  );
+}
+
+// Conjugating twice gives back a view through the original accessor.
+template <class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<typename Accessor::element_type, Extents, Layout, Accessor>
+conjugated(mdspan<ElementType, Extents, Layout, conjugated_accessor<Accessor>> const& x)
+{
+  return mdspan<typename Accessor::element_type, Extents, Layout, Accessor>(
+    x.data(), x.mapping(), x.accessor().nested_accessor()
+  );
+}
+
+} // end namespace linalg
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,157 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__mdspan_ext_bits/for_each_index.hpp"
+#include "scaled.hpp"
+
+#include <cstddef> // size_t
+
+namespace std {
+namespace experimental {
+namespace linalg {
+namespace detail {
+
+//==============================================================================
+// Scaling factor extraction
+//
+// Kernels call __scaling_factor(x) and __unscaled(x) to split a (possibly
+// nested) scaled() view into one combined factor and the underlying mdspan.
+// The inner loops then read the underlying data directly and apply the factor
+// once per result instead of once per element.
+
+struct __unit_scaling_factor { };
+
+template <class T>
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr T __apply_scaling(__unit_scaling_factor, T const& t) { return t; }
+
+template <class ScalingFactor, class T>
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr auto __apply_scaling(ScalingFactor const& s, T const& t) -> decltype(s * t) { return s * t; }
+
+MDSPAN_INLINE_FUNCTION
+constexpr __unit_scaling_factor __combine_scaling(__unit_scaling_factor, __unit_scaling_factor) { return { }; }
+
+template <class S>
+MDSPAN_INLINE_FUNCTION
+constexpr S __combine_scaling(__unit_scaling_factor, S const& s) { return s; }
+
+template <class S>
+MDSPAN_INLINE_FUNCTION
+constexpr S __combine_scaling(S const& s, __unit_scaling_factor) { return s; }
+
+template <class S1, class S2>
+MDSPAN_INLINE_FUNCTION
+constexpr auto __combine_scaling(S1 const& s1, S2 const& s2) -> decltype(s1 * s2) { return s1 * s2; }
+
+template <class MDSpan>
+struct __scaled_unwrap {
+  MDSPAN_INLINE_FUNCTION
+  static constexpr __unit_scaling_factor __factor(MDSpan const&) { return { }; }
+  MDSPAN_INLINE_FUNCTION
+  static constexpr MDSpan __base(MDSpan const& x) { return x; }
+};
+
+template <class ElementType, class Extents, class Layout, class ScalingFactor, class NestedAccessor>
+struct __scaled_unwrap<mdspan<ElementType, Extents, Layout, scaled_accessor<ScalingFactor, NestedAccessor>>> {
+  using __nested_t = mdspan<typename NestedAccessor::element_type, Extents, Layout, NestedAccessor>;
+  using __inner_t = __scaled_unwrap<__nested_t>;
+
+  MDSPAN_INLINE_FUNCTION
+  static constexpr __nested_t __nested(mdspan<ElementType, Extents, Layout, scaled_accessor<ScalingFactor, NestedAccessor>> const& x) {
+    return __nested_t(x.data(), x.mapping(), x.accessor().nested_accessor());
+  }
+  MDSPAN_INLINE_FUNCTION
+  static constexpr auto __factor(mdspan<ElementType, Extents, Layout, scaled_accessor<ScalingFactor, NestedAccessor>> const& x)
+    -> decltype(__combine_scaling(x.accessor().scaling_factor(), __inner_t::__factor(__nested(x))))
+  {
+    return __combine_scaling(x.accessor().scaling_factor(), __inner_t::__factor(__nested(x)));
+  }
+  MDSPAN_INLINE_FUNCTION
+  static constexpr auto __base(mdspan<ElementType, Extents, Layout, scaled_accessor<ScalingFactor, NestedAccessor>> const& x)
+    -> decltype(__inner_t::__base(__nested(x)))
+  {
+    return __inner_t::__base(__nested(x));
+  }
+};
+
+template <class MDSpan>
+MDSPAN_INLINE_FUNCTION
+constexpr auto __scaling_factor(MDSpan const& x) -> decltype(__scaled_unwrap<MDSpan>::__factor(x)) {
+  return __scaled_unwrap<MDSpan>::__factor(x);
+}
+
+template <class MDSpan>
+MDSPAN_INLINE_FUNCTION
+constexpr auto __unscaled(MDSpan const& x) -> decltype(__scaled_unwrap<MDSpan>::__base(x)) {
+  return __scaled_unwrap<MDSpan>::__base(x);
+}
+
+// The dimension of a rank-2 mapping with stride 1, or 2 for neither (or a
+// mapping that is not always strided).  Kernels walk that dimension in their
+// inner loop so they read memory in order.
+template <class Mapping>
+size_t __unit_stride_dim(Mapping const& map, true_type /* always strided */) {
+  return map.stride(1) == 1 ? 1 : map.stride(0) == 1 ? 0 : 2;
+}
+
+template <class Mapping>
+size_t __unit_stride_dim(Mapping const&, false_type /* always strided */) {
+  return 2;
+}
+
+template <class Mapping>
+size_t __unit_stride_dim(Mapping const& map) {
+  return __unit_stride_dim(map, integral_constant<bool, Mapping::is_always_strided()>());
+}
+
+} // end namespace detail
+} // end namespace linalg
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,128 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+
+#include <cstddef> // size_t
+#include <utility> // declval
+
+namespace std {
+namespace experimental {
+namespace linalg {
+
+// Read-only accessor that multiplies every element of the nested accessor by
+// a scaling factor on access.  Nothing is ever written back to memory; the
+// kernels in <experimental/linalg> recognize this accessor and hoist the
+// scaling factor out of their inner loops instead.
+template <class ScalingFactor, class NestedAccessor>
+class scaled_accessor {
+public:
+  using nested_accessor_type = NestedAccessor;
+  using scaling_factor_type = ScalingFactor;
+  using element_type = add_const_t<
+    decltype(declval<ScalingFactor>() * declval<typename NestedAccessor::element_type>())
+  >;
+  using reference = remove_const_t<element_type>;
+  using pointer = typename NestedAccessor::pointer;
+  using offset_policy = scaled_accessor<ScalingFactor, typename NestedAccessor::offset_policy>;
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr scaled_accessor(ScalingFactor const& s, NestedAccessor const& a)
+    : __scaling_factor(s), __nested_accessor(a)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherNestedAccessor,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_constructible, NestedAccessor, OtherNestedAccessor const&)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr scaled_accessor(scaled_accessor<ScalingFactor, OtherNestedAccessor> const& other)
+    : __scaling_factor(other.scaling_factor()), __nested_accessor(other.nested_accessor())
+  { }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const {
+    return __scaling_factor * typename NestedAccessor::element_type(__nested_accessor.access(p, i));
+  }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr typename offset_policy::pointer offset(pointer p, size_t i) const {
+    return __nested_accessor.offset(p, i);
+  }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr ScalingFactor scaling_factor() const { return __scaling_factor; }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr NestedAccessor nested_accessor() const { return __nested_accessor; }
+
+private:
+  ScalingFactor __scaling_factor;
+  NestedAccessor __nested_accessor;
+};
+
+// Returns a read-only view of `alpha * x` without touching memory.
+template <class ScalingFactor, class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<
+  typename scaled_accessor<ScalingFactor, Accessor>::element_type,
+  Extents, Layout, scaled_accessor<ScalingFactor, Accessor>
+>
+scaled(ScalingFactor const& alpha, mdspan<ElementType, Extents, Layout, Accessor> const& x)
+{
+  using accessor_t = scaled_accessor<ScalingFactor, Accessor>;
+  return mdspan<typename accessor_t::element_type, Extents, Layout, accessor_t>(
+    x.data(), x.mapping(), accessor_t(alpha, x.accessor())
+  );
+}
+
+} // end namespace linalg
+} // end namespace experimental
+} // end namespace std
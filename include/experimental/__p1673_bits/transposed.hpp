@@ -0,0 +1,181 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/layout_stride.hpp"
+
+#include <array>
+#include <cstddef> // size_t
+
+namespace std {
+namespace experimental {
+namespace linalg {
+
+namespace detail {
+
+template <class Extents>
+struct __transpose_extents {
+  static_assert(Extents::rank() == 2, "std::experimental::linalg::transposed requires a rank-2 mdspan.");
+  using type = experimental::extents<Extents::static_extent(1), Extents::static_extent(0)>;
+
+  MDSPAN_INLINE_FUNCTION
+  static constexpr type __apply(Extents const& e) { return type(e.extent(1), e.extent(0)); }
+};
+
+template <class Extents>
+using __transpose_extents_t = typename __transpose_extents<Extents>::type;
+
+} // end namespace detail
+
+// Layout of the transpose of a Layout-mapped matrix: element (i, j) is element
+// (j, i) of the nested mapping.  transposed() only needs it for layouts other
+// than layout_left, layout_right and layout_stride, which transpose into each
+// other (or themselves).
+template <class Layout>
+struct layout_transpose {
+  template <class Extents>
+  class mapping {
+  public:
+    using layout_type = layout_transpose;
+    using extents_type = Extents;
+    using size_type = typename Extents::size_type;
+    using nested_mapping_type = typename Layout::template mapping<detail::__transpose_extents_t<Extents>>;
+
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping() noexcept = default;
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr explicit mapping(nested_mapping_type const& map)
+      : __nested_mapping(map),
+        __extents(detail::__transpose_extents<typename nested_mapping_type::extents_type>::__apply(map.extents()))
+    { }
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr size_type operator()(size_t i, size_t j) const { return __nested_mapping(j, i); }
+
+    MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __extents; }
+    MDSPAN_INLINE_FUNCTION constexpr nested_mapping_type nested_mapping() const noexcept { return __nested_mapping; }
+    MDSPAN_INLINE_FUNCTION constexpr size_type required_span_size() const { return __nested_mapping.required_span_size(); }
+    MDSPAN_INLINE_FUNCTION constexpr size_type stride(size_t r) const { return __nested_mapping.stride(r == 0 ? 1 : 0); }
+
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_unique() { return nested_mapping_type::is_always_unique(); }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_contiguous() { return nested_mapping_type::is_always_contiguous(); }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_strided() { return nested_mapping_type::is_always_strided(); }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_unique() const { return __nested_mapping.is_unique(); }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_contiguous() const { return __nested_mapping.is_contiguous(); }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_strided() const { return __nested_mapping.is_strided(); }
+
+  private:
+    nested_mapping_type __nested_mapping;
+    extents_type __extents;
+  };
+};
+
+// Returns a view of the transpose of the rank-2 mdspan a without touching
+// memory.  The accessor (and so any scaled() or conjugated() view) is kept.
+template <class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<ElementType, detail::__transpose_extents_t<Extents>, layout_transpose<Layout>, Accessor>
+transposed(mdspan<ElementType, Extents, Layout, Accessor> const& a)
+{
+  using mapping_t = typename layout_transpose<Layout>::template mapping<detail::__transpose_extents_t<Extents>>;
+  return mdspan<ElementType, detail::__transpose_extents_t<Extents>, layout_transpose<Layout>, Accessor>(
+    a.data(), mapping_t(a.mapping()), a.accessor()
+  );
+}
+
+template <class ElementType, class Extents, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<ElementType, detail::__transpose_extents_t<Extents>, layout_right, Accessor>
+transposed(mdspan<ElementType, Extents, layout_left, Accessor> const& a)
+{
+  using extents_t = detail::__transpose_extents_t<Extents>;
+  return mdspan<ElementType, extents_t, layout_right, Accessor>(
+    a.data(), layout_right::mapping<extents_t>(detail::__transpose_extents<Extents>::__apply(a.extents())), a.accessor()
+  );
+}
+
+template <class ElementType, class Extents, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<ElementType, detail::__transpose_extents_t<Extents>, layout_left, Accessor>
+transposed(mdspan<ElementType, Extents, layout_right, Accessor> const& a)
+{
+  using extents_t = detail::__transpose_extents_t<Extents>;
+  return mdspan<ElementType, extents_t, layout_left, Accessor>(
+    a.data(), layout_left::mapping<extents_t>(detail::__transpose_extents<Extents>::__apply(a.extents())), a.accessor()
+  );
+}
+
+template <class ElementType, class Extents, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<ElementType, detail::__transpose_extents_t<Extents>, layout_stride, Accessor>
+transposed(mdspan<ElementType, Extents, layout_stride, Accessor> const& a)
+{
+  using extents_t = detail::__transpose_extents_t<Extents>;
+  return mdspan<ElementType, extents_t, layout_stride, Accessor>(
+    a.data(),
+    layout_stride::mapping<extents_t>(detail::__transpose_extents<Extents>::__apply(a.extents()),
+      array<size_t, 2>{{size_t(a.stride(1)), size_t(a.stride(0))}}),
+    a.accessor()
+  );
+}
+
+// Transposing a layout_transpose view gives back the original mapping.
+template <class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<ElementType, detail::__transpose_extents_t<Extents>, Layout, Accessor>
+transposed(mdspan<ElementType, Extents, layout_transpose<Layout>, Accessor> const& a)
+{
+  return mdspan<ElementType, detail::__transpose_extents_t<Extents>, Layout, Accessor>(
+    a.data(), a.mapping().nested_mapping(), a.accessor()
+  );
+}
+
+} // end namespace linalg
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,396 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+#include "../__p0009_bits/bounds_check.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__mdspan_ext_bits/layout_copy.hpp"
+
+#include <cstddef> // size_t
+#include <array>
+#include <memory> // uses_allocator
+#include <utility> // move
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// Builds the container for a given required span size.  Fixed-size
+// containers like array are value-initialized instead; their size must be at
+// least the required span size.
+template <class Container>
+struct __mdarray_container_factory {
+  static Container __make(size_t n) { return Container(n); }
+};
+
+template <class T, size_t N>
+struct __mdarray_container_factory<array<T, N>> {
+  static array<T, N> __make(size_t) noexcept { return array<T, N>{}; }
+};
+
+} // end namespace detail
+
+//==============================================================================
+// mdarray (P1684): an owning multidimensional array.  The container is sized
+// from the mapping's required_span_size(), moves without copying elements, and
+// converts to an mdspan over its storage at no cost.
+
+template <
+  class ElementType,
+  class Extents,
+  class LayoutPolicy = layout_right,
+  class Container = vector<ElementType>
+>
+class mdarray {
+private:
+  static_assert(detail::__is_extents_v<Extents>, "std::experimental::mdarray's Extents template parameter must be a specialization of std::experimental::extents.");
+
+public:
+
+  //--------------------------------------------------------------------------------
+  // Domain and codomain types
+
+  using extents_type = Extents;
+  using layout_type = LayoutPolicy;
+  using container_type = Container;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+  using element_type = ElementType;
+  using value_type = remove_cv_t<element_type>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using pointer = decltype(std::declval<container_type&>().data());
+  using const_pointer = decltype(std::declval<container_type const&>().data());
+  using reference = typename container_type::reference;
+  using const_reference = typename container_type::const_reference;
+
+  using mdspan_type = mdspan<element_type, extents_type, layout_type>;
+  using const_mdspan_type = mdspan<const element_type, extents_type, layout_type>;
+
+  //--------------------------------------------------------------------------------
+  // [mdarray.cons], mdarray constructors, assignment, and destructor
+
+  // Fully static extents get storage for all their elements; otherwise the
+  // dynamic extents are zero and so is the storage.
+  mdarray() : mdarray(mapping_type()) { }
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED mdarray(const mdarray&) = default;
+  MDSPAN_INLINE_FUNCTION_DEFAULTED mdarray(mdarray&&) = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class... SizeTypes,
+    /* requires */ (
+      sizeof...(SizeTypes) > 0 &&
+      _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, SizeTypes, size_type) /* && ... */) &&
+      _MDSPAN_TRAIT(is_constructible, extents_type, SizeTypes...) &&
+      _MDSPAN_TRAIT(is_constructible, mapping_type, extents_type)
+    )
+  )
+  explicit mdarray(SizeTypes... dynamic_extents)
+    : mdarray(mapping_type(extents_type(dynamic_extents...)))
+  { }
+
+  MDSPAN_FUNCTION_REQUIRES(
+    (explicit),
+    mdarray, (const extents_type& exts), ,
+    /* requires */ (_MDSPAN_TRAIT(is_constructible, mapping_type, extents_type))
+  ) : mdarray(mapping_type(exts))
+  { }
+
+  explicit mdarray(const mapping_type& m)
+    : __ctr(detail::__mdarray_container_factory<container_type>::__make(m.required_span_size())), __map(m)
+  { }
+
+  // The container must hold at least m.required_span_size() elements.
+  mdarray(const mapping_type& m, const container_type& c)
+    : __ctr(c), __map(m)
+  { }
+
+  mdarray(const mapping_type& m, container_type&& c)
+    : __ctr(std::move(c)), __map(m)
+  { }
+
+  // Allocator-extended constructors, e.g. for aligned, huge-page or NUMA
+  // placement of the elements.
+  MDSPAN_TEMPLATE_REQUIRES(
+    class Alloc,
+    /* requires */ (
+      _MDSPAN_TRAIT(uses_allocator, container_type, Alloc) &&
+      _MDSPAN_TRAIT(is_constructible, container_type, size_t, const Alloc&) &&
+      _MDSPAN_TRAIT(is_constructible, mapping_type, extents_type)
+    )
+  )
+  mdarray(const extents_type& exts, const Alloc& a)
+    : mdarray(mapping_type(exts), a)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class Alloc,
+    /* requires */ (
+      _MDSPAN_TRAIT(uses_allocator, container_type, Alloc) &&
+      _MDSPAN_TRAIT(is_constructible, container_type, size_t, const Alloc&)
+    )
+  )
+  mdarray(const mapping_type& m, const Alloc& a)
+    : __ctr(m.required_span_size(), a), __map(m)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class Alloc,
+    /* requires */ (
+      _MDSPAN_TRAIT(uses_allocator, container_type, Alloc) &&
+      _MDSPAN_TRAIT(is_constructible, container_type, container_type&&, const Alloc&)
+    )
+  )
+  mdarray(const mapping_type& m, container_type&& c, const Alloc& a)
+    : __ctr(std::move(c), a), __map(m)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType, class OtherExtents, class OtherLayoutPolicy, class OtherContainer,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_constructible, mapping_type, typename OtherLayoutPolicy::template mapping<OtherExtents>) &&
+      _MDSPAN_TRAIT(is_constructible, container_type, OtherContainer const&)
+    )
+  )
+  mdarray(const mdarray<OtherElementType, OtherExtents, OtherLayoutPolicy, OtherContainer>& other)
+    : __ctr(other.__ctr), __map(other.__map)
+  { }
+
+  // Copy the elements of an mdspan into freshly allocated storage with this
+  // layout, with the layout-aware copy() of mdspan_algorithm.
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType, class OtherExtents, class OtherLayoutPolicy, class OtherAccessor,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_constructible, extents_type, OtherExtents) &&
+      _MDSPAN_TRAIT(is_constructible, mapping_type, extents_type) &&
+      _MDSPAN_TRAIT(is_convertible, typename OtherAccessor::reference, value_type)
+    )
+  )
+  explicit mdarray(const mdspan<OtherElementType, OtherExtents, OtherLayoutPolicy, OtherAccessor>& other)
+    : mdarray(mapping_type(extents_type(other.extents())))
+  {
+    experimental::copy(other, to_mdspan());
+  }
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED mdarray& operator=(const mdarray&) = default;
+  MDSPAN_INLINE_FUNCTION_DEFAULTED mdarray& operator=(mdarray&&) = default;
+  MDSPAN_INLINE_FUNCTION_DEFAULTED ~mdarray() = default;
+
+  //--------------------------------------------------------------------------------
+  // [mdarray.members], mdarray element access
+
+  #if MDSPAN_USE_BRACKET_OPERATOR
+  MDSPAN_TEMPLATE_REQUIRES(
+    class... SizeTypes,
+    /* requires */ (
+      _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, SizeTypes, size_type) /* && ... */) &&
+      extents_type::rank() == sizeof...(SizeTypes)
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference operator[](SizeTypes... indices) noexcept
+  {
+    _MDSPAN_CHECK_INDICES(__map.extents(), indices...);
+    return __ctr[__map(size_type(indices)...)];
+  }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class... SizeTypes,
+    /* requires */ (
+      _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, SizeTypes, size_type) /* && ... */) &&
+      extents_type::rank() == sizeof...(SizeTypes)
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  const_reference operator[](SizeTypes... indices) const noexcept
+  {
+    _MDSPAN_CHECK_INDICES(__map.extents(), indices...);
+    return __ctr[__map(size_type(indices)...)];
+  }
+  #else
+  MDSPAN_TEMPLATE_REQUIRES(
+    class Index,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, Index, size_type) &&
+      extents_type::rank() == 1
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference operator[](Index idx) noexcept
+  {
+    _MDSPAN_CHECK_INDICES(__map.extents(), idx);
+    return __ctr[__map(size_type(idx))];
+  }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class Index,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, Index, size_type) &&
+      extents_type::rank() == 1
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  const_reference operator[](Index idx) const noexcept
+  {
+    _MDSPAN_CHECK_INDICES(__map.extents(), idx);
+    return __ctr[__map(size_type(idx))];
+  }
+  #endif
+
+  #if MDSPAN_USE_PAREN_OPERATOR
+  MDSPAN_TEMPLATE_REQUIRES(
+    class... SizeTypes,
+    /* requires */ (
+      _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, SizeTypes, size_type) /* && ... */) &&
+      extents_type::rank() == sizeof...(SizeTypes)
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference operator()(SizeTypes... indices) noexcept
+  {
+    _MDSPAN_CHECK_INDICES(__map.extents(), indices...);
+    return __ctr[__map(size_type(indices)...)];
+  }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class... SizeTypes,
+    /* requires */ (
+      _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, SizeTypes, size_type) /* && ... */) &&
+      extents_type::rank() == sizeof...(SizeTypes)
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  const_reference operator()(SizeTypes... indices) const noexcept
+  {
+    _MDSPAN_CHECK_INDICES(__map.extents(), indices...);
+    return __ctr[__map(size_type(indices)...)];
+  }
+  #endif
+
+  //--------------------------------------------------------------------------------
+  // [mdarray.members], mdarray observers of the domain and the mapping
+
+  MDSPAN_INLINE_FUNCTION static constexpr size_t rank() noexcept { return extents_type::rank(); }
+  MDSPAN_INLINE_FUNCTION static constexpr size_t rank_dynamic() noexcept { return extents_type::rank_dynamic(); }
+  MDSPAN_INLINE_FUNCTION static constexpr size_type static_extent(size_t r) noexcept { return extents_type::static_extent(r); }
+
+  MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __map.extents(); }
+  MDSPAN_INLINE_FUNCTION constexpr size_type extent(size_t r) const noexcept { return __map.extents().extent(r); }
+  MDSPAN_INLINE_FUNCTION constexpr size_type size() const noexcept {
+    return __size_impl(make_index_sequence<extents_type::rank()>());
+  }
+
+  pointer data() noexcept { return __ctr.data(); }
+  const_pointer data() const noexcept { return __ctr.data(); }
+
+  const container_type& container() const noexcept { return __ctr; }
+
+  // Move the storage out; the mdarray is left with an empty container.
+  container_type extract_container() && noexcept { return std::move(__ctr); }
+
+  MDSPAN_INLINE_FUNCTION static constexpr bool is_always_unique() noexcept { return mapping_type::is_always_unique(); }
+  MDSPAN_INLINE_FUNCTION static constexpr bool is_always_contiguous() noexcept { return mapping_type::is_always_contiguous(); }
+  MDSPAN_INLINE_FUNCTION static constexpr bool is_always_strided() noexcept { return mapping_type::is_always_strided(); }
+
+  MDSPAN_INLINE_FUNCTION constexpr const mapping_type& mapping() const noexcept { return __map; }
+  MDSPAN_INLINE_FUNCTION constexpr bool is_unique() const noexcept { return __map.is_unique(); }
+  MDSPAN_INLINE_FUNCTION constexpr bool is_contiguous() const noexcept { return __map.is_contiguous(); }
+  MDSPAN_INLINE_FUNCTION constexpr bool is_strided() const noexcept { return __map.is_strided(); }
+  MDSPAN_INLINE_FUNCTION constexpr size_type stride(size_t r) const { return __map.stride(r); }
+
+  //--------------------------------------------------------------------------------
+  // [mdarray.members], conversion to mdspan
+
+  mdspan_type to_mdspan() noexcept {
+    return mdspan_type(__ctr.data(), __map);
+  }
+  const_mdspan_type to_mdspan() const noexcept {
+    return const_mdspan_type(__ctr.data(), __map);
+  }
+
+  template <class OtherAccessor>
+  mdspan<typename OtherAccessor::element_type, extents_type, layout_type, OtherAccessor>
+  to_mdspan(const OtherAccessor& a) {
+    return mdspan<typename OtherAccessor::element_type, extents_type, layout_type, OtherAccessor>(__ctr.data(), __map, a);
+  }
+
+  template <class OtherElementType, class OtherExtents, class OtherLayoutPolicy, class OtherAccessor,
+    class = enable_if_t<_MDSPAN_TRAIT(is_assignable,
+      mdspan<OtherElementType, OtherExtents, OtherLayoutPolicy, OtherAccessor>&, mdspan_type)>>
+  operator mdspan<OtherElementType, OtherExtents, OtherLayoutPolicy, OtherAccessor>() noexcept {
+    return to_mdspan();
+  }
+
+  template <class OtherElementType, class OtherExtents, class OtherLayoutPolicy, class OtherAccessor,
+    class = enable_if_t<_MDSPAN_TRAIT(is_assignable,
+      mdspan<OtherElementType, OtherExtents, OtherLayoutPolicy, OtherAccessor>&, const_mdspan_type)>>
+  operator mdspan<OtherElementType, OtherExtents, OtherLayoutPolicy, OtherAccessor>() const noexcept {
+    return to_mdspan();
+  }
+
+private:
+
+  container_type __ctr{};
+  _MDSPAN_NO_UNIQUE_ADDRESS mapping_type __map{};
+
+  template <size_t... Idxs>
+  constexpr size_type __size_impl(index_sequence<Idxs...>) const noexcept {
+    return _MDSPAN_FOLD_TIMES_RIGHT((__map.extents().template __extent<Idxs>()), /* * ... * */ 1);
+  }
+
+  template <class, class, class, class>
+  friend class mdarray;
+
+};
+
+} // end namespace experimental
+} // end namespace std
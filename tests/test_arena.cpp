@@ -0,0 +1,125 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_memory>
+#include <cstdint>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestArena, test_make_mdspan_sizing_and_alignment) {
+  stdex::arena a(4096);
+  auto m = stdex::make_mdspan<double, stdex::extents<dyn, 7>, stdex::layout_left>(a, 5);
+  static_assert(std::is_same<decltype(m)::layout_type, stdex::layout_left>::value, "");
+  ASSERT_EQ(m.extent(0), 5);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(m.data()) % 64, 0u);
+  ASSERT_EQ(a.bytes_used(), 35 * sizeof(double));
+  auto n = stdex::make_mdspan<char, stdex::dextents<1>>(a, 3);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(n.data()) % 64, 0u);
+  ASSERT_GE(static_cast<void*>(n.data()), static_cast<void*>(m.data() + 35));
+  __MDSPAN_OP(m, 4, 6) = 1.5;
+  ASSERT_EQ((__MDSPAN_OP(m, 4, 6)), 1.5);
+}
+
+TEST(TestArena, test_reset_reuses_memory) {
+  stdex::arena a(1 << 16);
+  const void* first = nullptr;
+  for(int iter = 0; iter < 10; ++iter) {
+    auto x = stdex::make_mdspan<float, stdex::dextents<2>>(a, 64, 64);
+    auto y = stdex::make_mdspan<float, stdex::dextents<2>>(a, 64, 64);
+    if(iter == 0) first = x.data();
+    ASSERT_EQ(static_cast<const void*>(x.data()), first);
+    ASSERT_NE(x.data(), y.data());
+    a.reset();
+  }
+  ASSERT_EQ(a.chunk_count(), 1u);
+  ASSERT_EQ(a.bytes_used(), 0u);
+}
+
+TEST(TestArena, test_grows_with_oversized_requests) {
+  stdex::arena a(1024);
+  auto small = stdex::make_mdspan<int, stdex::dextents<1>>(a, 100);
+  auto big = stdex::make_mdspan<int, stdex::dextents<1>>(a, 10000);
+  ASSERT_EQ(a.chunk_count(), 2u);
+  ASSERT_GE(a.bytes_reserved(), 1024 + 10000 * sizeof(int));
+  __MDSPAN_OP(big, 9999) = 3;
+  __MDSPAN_OP(small, 99) = 4;
+  a.reset();
+  // both chunks are retained and reused in order
+  auto again = stdex::make_mdspan<int, stdex::dextents<1>>(a, 10000);
+  ASSERT_EQ(again.data(), big.data());
+  ASSERT_EQ(a.chunk_count(), 2u);
+  ASSERT_THROW(a.allocate(8, 3), std::invalid_argument);
+}
+
+TEST(TestArena, test_mark_rewind_and_poison) {
+  stdex::arena a(4096, true);
+  ASSERT_TRUE(a.poisoning());
+  auto keep = stdex::make_mdspan<unsigned char, stdex::dextents<1>>(a, 16);
+  for(size_t i = 0; i < 16; ++i) __MDSPAN_OP(keep, i) = 1;
+  auto m = a.mark();
+  auto tmp = stdex::make_mdspan<unsigned char, stdex::dextents<1>>(a, 32);
+  // fresh memory is poisoned, not zeroed
+  ASSERT_EQ((__MDSPAN_OP(tmp, 0)), stdex::arena_poison_byte);
+  for(size_t i = 0; i < 32; ++i) __MDSPAN_OP(tmp, i) = 2;
+  a.rewind(m);
+  for(size_t i = 0; i < 32; ++i) ASSERT_EQ((__MDSPAN_OP(tmp, i)), stdex::arena_poison_byte);
+  for(size_t i = 0; i < 16; ++i) ASSERT_EQ((__MDSPAN_OP(keep, i)), 1);
+  auto reused = stdex::make_mdspan<unsigned char, stdex::dextents<1>>(a, 32);
+  ASSERT_EQ(reused.data(), tmp.data());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(TestArena, test_chunks_are_not_touched) {
+  // A fresh chunk is not zero-filled, so its pages stay unmapped until used.
+  stdex::arena a(size_t(16) << 20);
+  auto m = stdex::make_mdspan<double, stdex::dextents<1>>(a, size_t(1) << 20);
+  const auto report = stdex::numa_page_distribution(m);
+  ASSERT_GE(report.total_pages, 2u);
+  ASSERT_GE(report.untouched_pages, report.total_pages - 1);
+}
+#endif
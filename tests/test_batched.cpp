@@ -0,0 +1,162 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan>
+#include <experimental/mdspan_algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+// A batch of well-conditioned n x n matrices with small integer entries, so
+// that determinants are exact and inverses accurate.
+template <size_t N, class MDSpan>
+void fill_matrices(MDSpan m) {
+  for(size_t b = 0; b < m.extent(0); ++b) {
+    for(size_t i = 0; i < N; ++i) {
+      for(size_t j = 0; j < N; ++j) {
+        __MDSPAN_OP(m, b, i, j) = double(int((b * 5 + i * 3 + j * 7) % 9) - 4) + (i == j ? 10.0 + double(b % 3) : 0.0);
+      }
+    }
+  }
+}
+
+template <size_t N, class MDSpan>
+double reference_determinant(MDSpan m, size_t b) {
+  double a[N][N];
+  for(size_t i = 0; i < N; ++i) for(size_t j = 0; j < N; ++j) a[i][j] = __MDSPAN_OP(m, b, i, j);
+  double det = 1;
+  for(size_t k = 0; k < N; ++k) {
+    det *= a[k][k];
+    for(size_t i = k + 1; i < N; ++i) {
+      const double f = a[i][k] / a[k][k];
+      for(size_t j = k; j < N; ++j) a[i][j] -= f * a[k][j];
+    }
+  }
+  return det;
+}
+
+template <size_t N, class Layout>
+void check_square_kernels(size_t count) {
+  using matrices = stdex::mdspan<double, stdex::extents<dyn, N, N>, Layout>;
+  using vectors = stdex::mdspan<double, stdex::extents<dyn, N>, Layout>;
+  std::vector<double> da(count * N * N), dinv(count * N * N), dd(count), db(count * N), dx(count * N);
+  matrices a(da.data(), count), inv(dinv.data(), count);
+  vectors b(db.data(), count), x(dx.data(), count);
+  stdex::mdspan<double, stdex::dextents<1>> d(dd.data(), count);
+  fill_matrices<N>(a);
+  for(size_t m = 0; m < count; ++m) for(size_t i = 0; i < N; ++i) __MDSPAN_OP(b, m, i) = double(i + m % 4) - 1.0;
+
+  stdex::batched_determinant(a, d);
+  stdex::batched_inverse(a, inv);
+  stdex::batched_solve(a, b, x);
+  for(size_t m = 0; m < count; ++m) {
+    const double expected = reference_determinant<N>(a, m);
+    ASSERT_NEAR(dd[m], expected, 1e-9 * std::abs(expected)) << "matrix " << m << " of " << N << " x " << N;
+    for(size_t i = 0; i < N; ++i) {
+      double ax = 0;
+      for(size_t j = 0; j < N; ++j) {
+        double prod = 0;
+        for(size_t k = 0; k < N; ++k) prod += __MDSPAN_OP(a, m, i, k) * __MDSPAN_OP(inv, m, k, j);
+        ASSERT_NEAR(prod, i == j ? 1.0 : 0.0, 1e-12);
+        ax += __MDSPAN_OP(a, m, i, j) * __MDSPAN_OP(x, m, j);
+      }
+      const double bi = __MDSPAN_OP(b, m, i);
+      ASSERT_NEAR(ax, bi, 1e-12);
+    }
+  }
+}
+
+} // namespace
+
+TEST(TestBatched, test_square_kernels) {
+  // Batch sizes around the number of lanes, in both the structure-of-arrays
+  // (layout_left) and array-of-structures (layout_right) layout.
+  for(size_t count : {1, 7, 16, 37}) {
+    check_square_kernels<1, stdex::layout_right>(count);
+    check_square_kernels<2, stdex::layout_left>(count);
+    check_square_kernels<3, stdex::layout_right>(count);
+    check_square_kernels<3, stdex::layout_left>(count);
+    check_square_kernels<5, stdex::layout_right>(count);
+  }
+}
+
+TEST(TestBatched, test_add_and_matrix_product) {
+  const size_t count = 21;
+  std::vector<float> da(count * 2 * 3), db(count * 3 * 4), dc(count * 2 * 4), ds(count * 2 * 3);
+  stdex::mdspan<float, stdex::extents<dyn, 2, 3>, stdex::layout_left> a(da.data(), count);
+  stdex::mdspan<float, stdex::extents<dyn, 3, 4>> b(db.data(), count);
+  stdex::mdspan<float, stdex::extents<dyn, 2, 4>> c(dc.data(), count);
+  stdex::mdspan<float, stdex::extents<dyn, 2, 3>> s(ds.data(), count);
+  for(size_t i = 0; i < da.size(); ++i) da[i] = float(i % 7);
+  for(size_t i = 0; i < db.size(); ++i) db[i] = float(i % 5) - 2;
+
+  stdex::batched_matrix_product(a, b, c);
+  stdex::batched_add(a, a, s);
+  for(size_t m = 0; m < count; ++m) {
+    for(size_t i = 0; i < 2; ++i) {
+      for(size_t j = 0; j < 4; ++j) {
+        float expected = 0;
+        for(size_t k = 0; k < 3; ++k) expected += __MDSPAN_OP(a, m, i, k) * __MDSPAN_OP(b, m, k, j);
+        const float actual = __MDSPAN_OP(c, m, i, j);
+        ASSERT_EQ(actual, expected);
+      }
+      for(size_t k = 0; k < 3; ++k) {
+        const float sum = __MDSPAN_OP(s, m, i, k);
+        const float twice = 2 * __MDSPAN_OP(a, m, i, k);
+        ASSERT_EQ(sum, twice);
+      }
+    }
+  }
+
+  // In place: s = s + s
+  stdex::batched_add(s, s, s);
+  const float last = __MDSPAN_OP(s, count - 1, 1, 2);
+  const float four_times = 4 * __MDSPAN_OP(a, count - 1, 1, 2);
+  ASSERT_EQ(last, four_times);
+}
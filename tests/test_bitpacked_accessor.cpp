@@ -0,0 +1,169 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_accessors>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestBitpackedAccessor, test_bitpacked_accessor_element_access) {
+  std::vector<uint64_t> words(stdex::bitpacked_word_count(10 * 13), 0);
+  stdex::bitpacked_mdspan<stdex::extents<dyn, dyn>> m(words.data(), 10, 13);
+  ASSERT_EQ(m.extent(0), 10);
+  ASSERT_EQ(m.extent(1), 13);
+  __MDSPAN_OP(m, 0, 0) = true;
+  __MDSPAN_OP(m, 4, 12) = true;  // linear index 64: first bit of word 1
+  __MDSPAN_OP(m, 9, 12) = true;  // linear index 129: second bit of word 2
+  ASSERT_EQ(words[0], uint64_t(1));
+  ASSERT_EQ(words[1], uint64_t(1));
+  ASSERT_EQ(words[2], uint64_t(2));
+  ASSERT_TRUE((__MDSPAN_OP(m, 4, 12)));
+  ASSERT_FALSE((__MDSPAN_OP(m, 0, 1)));
+  __MDSPAN_OP(m, 4, 12) = false;
+  ASSERT_FALSE((__MDSPAN_OP(m, 4, 12)));
+  ASSERT_EQ(words[1], uint64_t(0));
+}
+
+TEST(TestBitpackedAccessor, test_bitpacked_accessor_const_view) {
+  std::vector<uint8_t> words(stdex::bitpacked_word_count<uint8_t>(12), 0);
+  stdex::bitpacked_mdspan<stdex::extents<3, 4>, stdex::layout_right, uint8_t> m(words.data());
+  __MDSPAN_OP(m, 2, 3) = true;
+  stdex::bitpacked_mdspan<stdex::extents<3, 4>, stdex::layout_right, const uint8_t> cm = m;
+  static_assert(std::is_same<decltype(__MDSPAN_OP(cm, 0, 0)), bool>::value, "");
+  ASSERT_TRUE((__MDSPAN_OP(cm, 2, 3)));
+  ASSERT_FALSE((__MDSPAN_OP(cm, 2, 2)));
+  ASSERT_EQ(words[1], uint8_t(1 << 3));
+}
+
+TEST(TestBitpackedAccessor, test_bitpacked_accessor_submdspan_mid_word) {
+  std::vector<uint32_t> words(stdex::bitpacked_word_count<uint32_t>(8 * 10), 0);
+  stdex::bitpacked_mdspan<stdex::extents<8, 10>, stdex::layout_right, uint32_t> m(words.data());
+  // Row 3 starts at bit 30 of word 0 and straddles into word 1.
+  auto row = stdex::submdspan(m, 3, stdex::full_extent);
+  ASSERT_EQ(row.data().word, words.data());
+  ASSERT_EQ(row.data().bit, 30);
+  stdex::mask_fill(row, true);
+  ASSERT_EQ(stdex::mask_count(m), 10);
+  ASSERT_EQ(words[0], uint32_t(3) << 30);
+  ASSERT_EQ(words[1], uint32_t(0xff));
+  ASSERT_TRUE(stdex::mask_all(row));
+  ASSERT_FALSE(stdex::mask_all(m));
+  ASSERT_FALSE(stdex::mask_any(stdex::submdspan(m, 4, stdex::full_extent)));
+  auto col = stdex::submdspan(m, stdex::full_extent, 5);
+  ASSERT_EQ(stdex::mask_count(col), 1);
+  ASSERT_TRUE((__MDSPAN_OP(col, 3)));
+}
+
+TEST(TestBitpackedAccessor, test_bitpacked_accessor_reductions_tail) {
+  // 70 bits: one full word plus a 6 bit tail; garbage past the tail is ignored.
+  std::vector<uint64_t> words(2, 0);
+  stdex::bitpacked_mdspan<stdex::extents<dyn>> m(words.data(), 70);
+  ASSERT_FALSE(stdex::mask_any(m));
+  words[1] = ~uint64_t(0) << 6;
+  ASSERT_FALSE(stdex::mask_any(m));
+  ASSERT_EQ(stdex::mask_count(m), 0);
+  stdex::mask_fill(m, true);
+  ASSERT_EQ(stdex::mask_count(m), 70);
+  ASSERT_TRUE(stdex::mask_all(m));
+  ASSERT_EQ(words[1], ~uint64_t(0));
+  stdex::mask_fill(m, false);
+  ASSERT_EQ(words[0], uint64_t(0));
+  ASSERT_EQ(words[1], ~uint64_t(0) << 6);
+}
+
+TEST(TestBitpackedAccessor, test_bitpacked_accessor_binary_ops) {
+  constexpr size_t n = 100;
+  std::vector<uint64_t> wa(2, 0), wb(2, 0), wo(2, 0);
+  stdex::bitpacked_mdspan<stdex::extents<dyn, dyn>> a(wa.data(), 10, 10), b(wb.data(), 10, 10), out(wo.data(), 10, 10);
+  for(size_t i = 0; i < 10; ++i) {
+    for(size_t j = 0; j < 10; ++j) {
+      __MDSPAN_OP(a, i, j) = (i + j) % 2 == 0;
+      __MDSPAN_OP(b, i, j) = (i * j) % 3 == 0;
+    }
+  }
+  auto check = [&](auto op) {
+    for(size_t i = 0; i < 10; ++i) {
+      for(size_t j = 0; j < 10; ++j) {
+        ASSERT_EQ(bool(__MDSPAN_OP(out, i, j)), op(bool(__MDSPAN_OP(a, i, j)), bool(__MDSPAN_OP(b, i, j))));
+      }
+    }
+  };
+  stdex::mask_and(a, b, out);
+  check([](bool x, bool y) { return x && y; });
+  stdex::mask_or(a, b, out);
+  check([](bool x, bool y) { return x || y; });
+  stdex::mask_xor(a, b, out);
+  check([](bool x, bool y) { return x != y; });
+  stdex::mask_andnot(a, b, out);
+  check([](bool x, bool y) { return x && !y; });
+  stdex::mask_not(a, out);
+  check([](bool x, bool) { return !x; });
+  ASSERT_EQ(stdex::mask_count(out) + stdex::mask_count(a), n);
+  // Bits past the end of the view must be untouched by the word path.
+  ASSERT_EQ(wo[1] >> (n - 64), uint64_t(0));
+}
+
+TEST(TestBitpackedAccessor, test_bitpacked_accessor_binary_ops_mixed_layouts) {
+  std::vector<uint64_t> wa(1, 0), wb(1, 0), wo(1, 0);
+  stdex::bitpacked_mdspan<stdex::extents<4, 6>, stdex::layout_right> a(wa.data());
+  stdex::bitpacked_mdspan<stdex::extents<4, 6>, stdex::layout_left> b(wb.data());
+  stdex::bitpacked_mdspan<stdex::extents<4, 6>, stdex::layout_right> out(wo.data());
+  for(size_t i = 0; i < 4; ++i) {
+    for(size_t j = 0; j < 6; ++j) {
+      __MDSPAN_OP(a, i, j) = j % 2 == 0;
+      __MDSPAN_OP(b, i, j) = i == 1;
+    }
+  }
+  stdex::mask_and(a, b, out);
+  for(size_t i = 0; i < 4; ++i) {
+    for(size_t j = 0; j < 6; ++j) {
+      ASSERT_EQ(bool(__MDSPAN_OP(out, i, j)), i == 1 && j % 2 == 0);
+    }
+  }
+  ASSERT_EQ(stdex::mask_count(out), 3);
+}
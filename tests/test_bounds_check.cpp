@@ -0,0 +1,185 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#define MDSPAN_CHECK_BOUNDS 1
+#include <experimental/mdspan>
+#include <experimental/mdspan_accessors>
+#include <experimental/mdspan_algorithm>
+#include <experimental/linalg>
+#include <array>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestBoundsCheck, test_bounds_check_in_bounds) {
+  std::vector<int> d(3 * 4, 0);
+  stdex::mdspan<int, stdex::extents<3, dyn>> m(d.data(), 4);
+  __MDSPAN_OP(m, 2, 3) = 42;
+  ASSERT_EQ(d[11], 42);
+  ASSERT_EQ((m[std::array<size_t, 2>{2, 3}]), 42);
+  auto sub = stdex::submdspan(m, std::make_tuple(1, 3), stdex::full_extent);
+  ASSERT_EQ(sub.extent(0), 2);
+  auto empty = stdex::submdspan(m, std::make_tuple(3, 3), 0);
+  ASSERT_EQ(empty.extent(0), 0);
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_index) {
+  std::vector<int> d(3 * 4, 0);
+  stdex::mdspan<int, stdex::extents<3, dyn>> m(d.data(), 4);
+  ASSERT_DEATH((__MDSPAN_OP(m, 1, 4) = 1), "index \\(1, 4\\) is out of bounds for extents \\(3, 4\\)");
+  ASSERT_DEATH((__MDSPAN_OP(m, 3, 0) = 1), "out of bounds");
+  ASSERT_DEATH((__MDSPAN_OP(m, -1, 0) = 1), "out of bounds");
+  ASSERT_DEATH((m[std::array<int, 2>{0, 5}] = 1), "index \\(0, 5\\)");
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_rank1) {
+  std::vector<double> d(5, 0);
+  stdex::mdspan<double, stdex::extents<dyn>> m(d.data(), 5);
+  ASSERT_DEATH(m[5] = 1.0, "index \\(5\\) is out of bounds for extents \\(5\\)");
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_submdspan) {
+  std::vector<int> d(3 * 4, 0);
+  stdex::mdspan<int, stdex::extents<3, 4>> m(d.data());
+  ASSERT_DEATH(stdex::submdspan(m, 3, stdex::full_extent), "slice \\[3, 4\\) is out of bounds for extent 3");
+  ASSERT_DEATH(stdex::submdspan(m, stdex::full_extent, std::make_tuple(2, 5)), "slice \\[2, 5\\)");
+  ASSERT_DEATH(stdex::submdspan(m, std::make_tuple(2, 1), 0), "slice \\[2, 1\\)");
+  // Sub-views are checked against their own extents.
+  auto sub = stdex::submdspan(m, std::make_tuple(1, 3), stdex::full_extent);
+  ASSERT_DEATH((__MDSPAN_OP(sub, 2, 0) = 1), "extents \\(2, 4\\)");
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_copy_extents) {
+  std::vector<double> a(8 * 8, 1.0), b(4 * 4, 0.0);
+  stdex::mdspan<double, stdex::dextents<2>> src(a.data(), 8, 8);
+  stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left> dst(b.data(), 4, 4);
+  ASSERT_DEATH(stdex::copy(src, dst), "copy: extents \\(8, 8\\) and \\(4, 4\\) do not match");
+  ASSERT_DEATH(stdex::copy(stdex::execution::par, src, dst), "copy: extents");
+  stdex::copy(stdex::submdspan(src, std::make_tuple(0, 4), std::make_tuple(2, 6)), dst);
+  ASSERT_EQ(b[15], 1.0);
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_reduce_axis_extents) {
+  std::vector<double> a(3 * 4, 1.0), b(4, 0.0);
+  stdex::mdspan<double, stdex::dextents<2>> src(a.data(), 3, 4);
+  stdex::mdspan<double, stdex::dextents<1>> dst(b.data(), 3);
+  ASSERT_DEATH(stdex::reduce_axis<0>(src, dst, 0.0, std::plus<>()), "reduce_axis: extent 4 does not match 3");
+  stdex::reduce_axis<1>(src, dst, 0.0, std::plus<>());
+  ASSERT_EQ(b[2], 4.0);
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_matrix_product_extents) {
+  std::vector<double> a(3 * 4, 1.0), b(5 * 2, 1.0), c(3 * 2, 0.0);
+  stdex::mdspan<double, stdex::dextents<2>> A(a.data(), 3, 4);
+  stdex::mdspan<double, stdex::dextents<2>> B(b.data(), 5, 2);
+  stdex::mdspan<double, stdex::dextents<2>> C(c.data(), 3, 2);
+  ASSERT_DEATH(stdex::linalg::matrix_product(A, B, C), "matrix_product: extent 4 does not match 5");
+  stdex::mdspan<double, stdex::dextents<2>> B2(b.data(), 4, 2);
+  stdex::mdspan<double, stdex::dextents<2>> C2(c.data(), 2, 2);
+  ASSERT_DEATH(stdex::linalg::matrix_product(stdex::execution::par, A, B2, C2), "matrix_product: extent 3 does not match 2");
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_matrix_vector_product_extents) {
+  std::vector<double> a(3 * 4, 1.0), x(5, 1.0), y(3, 0.0);
+  stdex::mdspan<double, stdex::dextents<2>> A(a.data(), 3, 4);
+  stdex::mdspan<double, stdex::dextents<1>> X(x.data(), 5);
+  stdex::mdspan<double, stdex::dextents<1>> Y(y.data(), 3);
+  ASSERT_DEATH(stdex::linalg::matrix_vector_product(A, X, Y), "matrix_vector_product: extent 5 does not match 4");
+  stdex::mdspan<double, stdex::dextents<1>> X4(x.data(), 4);
+  stdex::mdspan<double, stdex::dextents<1>> Z(x.data(), 2);
+  ASSERT_DEATH(stdex::linalg::matrix_vector_product(A, X4, Z, Y), "matrix_vector_product: extents \\(2\\) and \\(3\\)");
+  stdex::linalg::matrix_vector_product(A, X4, Y);
+  ASSERT_EQ(y[2], 4.0);
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_batched_extents) {
+  std::vector<double> a(4 * 2 * 2, 1.0), b(3 * 2, 1.0), c(3 * 2 * 2, 0.0);
+  stdex::mdspan<double, stdex::extents<stdex::dynamic_extent, 2, 2>, stdex::layout_left> A(a.data(), 4);
+  stdex::mdspan<double, stdex::extents<stdex::dynamic_extent, 2, 2>, stdex::layout_left> C(c.data(), 3);
+  stdex::mdspan<double, stdex::extents<stdex::dynamic_extent, 2>, stdex::layout_left> B(b.data(), 3);
+  ASSERT_DEATH(stdex::batched_add(A, C, C), "batched_add: extent 4 does not match 3");
+  ASSERT_DEATH(stdex::batched_solve(A, B, B), "batched_solve: extent 4 does not match 3");
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_elementwise_extents) {
+  std::vector<double> a(4 * 3, 1.0), b(3 * 4, 1.0);
+  stdex::mdspan<double, stdex::dextents<2>> ma(a.data(), 4, 3);
+  stdex::mdspan<double, stdex::dextents<2>> mb(b.data(), 3, 4);
+  ASSERT_DEATH(stdex::elementwise(ma) + mb, "elementwise: extents \\(4, 3\\) and \\(3, 4\\) do not match");
+  ASSERT_DEATH(stdex::assign(mb, stdex::elementwise(ma) * 2.0), "assign: extents \\(3, 4\\) and \\(4, 3\\) do not match");
+  stdex::assign(ma, 2.0 * stdex::elementwise(ma) + 1.0);
+  ASSERT_EQ(a[11], 3.0);
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_transform_extents) {
+  std::vector<double> a(4 * 4, 1.0), b(3 * 4, 0.0);
+  stdex::mdspan<double, stdex::dextents<2>> in(a.data(), 4, 4);
+  stdex::mdspan<double, stdex::dextents<2>> out(b.data(), 3, 4);
+  auto twice = [](double x) { return 2 * x; };
+  auto plus = [](double x, double y) { return x + y; };
+  ASSERT_DEATH(stdex::transform(stdex::execution::seq, in, out, twice), "transform: extents \\(4, 4\\) and \\(3, 4\\) do not match");
+  ASSERT_DEATH(stdex::transform(stdex::execution::par, out, in, out, plus), "transform: extents \\(4, 4\\) and \\(3, 4\\) do not match");
+  stdex::transform(stdex::execution::par, stdex::submdspan(in, std::make_tuple(1, 4), stdex::full_extent), out, twice);
+  ASSERT_EQ(b[11], 2.0);
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_stencil_extents) {
+  std::vector<double> a(8 * 8, 1.0), b(8 * 8, 0.0);
+  stdex::mdspan<double, stdex::dextents<2>> ma(a.data(), 8, 8);
+  stdex::mdspan<double, stdex::dextents<2>> mb(b.data(), 6, 8);
+  auto average = [](auto const& nb) { return (nb(0, 0) + nb(-1, 0) + nb(1, 0)) / 3; };
+  ASSERT_DEATH(stdex::stencil_sweep<1>(ma, mb, 1, average), "stencil_sweep: extents \\(8, 8\\) and \\(6, 8\\) do not match");
+}
+
+TEST(TestBoundsCheckDeathTest, test_bounds_check_byteswap_copy_extents) {
+  std::vector<unsigned char> raw(6 * sizeof(float));
+  std::vector<float> native(4);
+  stdex::mdspan<float, stdex::extents<2, 3>, stdex::layout_right, stdex::byteswap_accessor<float>> sw(raw.data());
+  stdex::mdspan<float, stdex::dextents<2>> dst(native.data(), 2, 2);
+  ASSERT_DEATH(stdex::byteswap_copy(sw, dst), "byteswap_copy: extents \\(2, 3\\) and \\(2, 2\\) do not match");
+}
@@ -0,0 +1,183 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_accessors>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestByteswapAccessor, test_big_endian_view) {
+  // 2 x 2 big-endian uint32, as found in a network capture
+  const unsigned char raw[] = {
+    0x00, 0x00, 0x00, 0x01,   0x00, 0x00, 0x01, 0x00,
+    0x01, 0x02, 0x03, 0x04,   0xff, 0xff, 0xff, 0xfe
+  };
+  stdex::mdspan<const uint32_t, stdex::extents<2, 2>, stdex::layout_right, stdex::big_endian_accessor<const uint32_t>> m(raw);
+  ASSERT_EQ((__MDSPAN_OP(m, 0, 0)), 1u);
+  ASSERT_EQ((__MDSPAN_OP(m, 0, 1)), 256u);
+  ASSERT_EQ((__MDSPAN_OP(m, 1, 0)), 0x01020304u);
+  ASSERT_EQ((__MDSPAN_OP(m, 1, 1)), 0xfffffffeu);
+  auto row = stdex::submdspan(m, 1, stdex::full_extent);
+  ASSERT_EQ((__MDSPAN_OP(row, 0)), 0x01020304u);
+}
+
+TEST(TestByteswapAccessor, test_byteswap_write) {
+  std::vector<unsigned char> raw(3 * sizeof(double));
+  stdex::mdspan<double, stdex::extents<3>, stdex::layout_right, stdex::byteswap_accessor<double>> m(raw.data());
+  __MDSPAN_OP(m, 1) = 2.5;
+  __MDSPAN_OP(m, 1) *= 2.0;
+  ASSERT_EQ(double(__MDSPAN_OP(m, 1)), 5.0);
+  double native = 5.0;
+  unsigned char expected[sizeof(double)];
+  std::memcpy(expected, &native, sizeof(double));
+  for(size_t b = 0; b < sizeof(double); ++b) {
+    ASSERT_EQ(raw[sizeof(double) + b], expected[sizeof(double) - 1 - b]);
+  }
+}
+
+TEST(TestUnalignedAccessor, test_packed_record_field) {
+  // Packed records { int32_t id; double value; }, 12 bytes each, starting at
+  // an odd address.
+  std::vector<unsigned char> raw(1 + 4 * 12);
+  for(int r = 0; r < 4; ++r) {
+    int32_t id = r;
+    double value = 1.5 * r;
+    std::memcpy(raw.data() + 1 + r * 12, &id, 4);
+    std::memcpy(raw.data() + 1 + r * 12 + 4, &value, 8);
+  }
+  stdex::mdspan<const double, stdex::extents<dyn>, stdex::layout_right, stdex::unaligned_accessor<const double, 12>>
+    values(raw.data() + 1 + 4, 4);
+  stdex::mdspan<int32_t, stdex::extents<dyn>, stdex::layout_right, stdex::unaligned_accessor<int32_t, 12>>
+    ids(raw.data() + 1, 4);
+  ASSERT_EQ((__MDSPAN_OP(values, 3)), 4.5);
+  ASSERT_EQ(int32_t(__MDSPAN_OP(ids, 2)), 2);
+  __MDSPAN_OP(ids, 2) = 42;
+  ASSERT_EQ(int32_t(__MDSPAN_OP(ids, 2)), 42);
+  ASSERT_EQ((__MDSPAN_OP(values, 2)), 3.0);
+}
+
+template <class T>
+void check_roundtrip(size_t n) {
+  std::vector<T> native(n), back(n);
+  for(size_t i = 0; i < n; ++i) native[i] = T(i * 3 + 1);
+  std::vector<unsigned char> raw(n * sizeof(T));
+  using swapped_t = stdex::mdspan<T, stdex::extents<dyn>, stdex::layout_right, stdex::byteswap_accessor<T>>;
+  stdex::mdspan<T, stdex::extents<dyn>> src(native.data(), n), dst(back.data(), n);
+  swapped_t sw(raw.data(), n);
+  stdex::byteswap_copy(src, sw);
+  for(size_t i = 0; i < n; ++i) ASSERT_EQ(T(__MDSPAN_OP(sw, i)), native[i]);
+  // Bytes really are reversed
+  const unsigned char* native_bytes = reinterpret_cast<const unsigned char*>(native.data());
+  for(size_t b = 0; b < sizeof(T); ++b) ASSERT_EQ(raw[b], native_bytes[sizeof(T) - 1 - b]);
+  stdex::byteswap_copy(stdex::mdspan<const T, stdex::extents<dyn>, stdex::layout_right, stdex::byteswap_accessor<const T>>(sw), dst);
+  ASSERT_EQ(back, native);
+}
+
+TEST(TestByteswapCopy, test_byteswap_copy_contiguous) {
+  check_roundtrip<uint16_t>(37);
+  check_roundtrip<uint32_t>(101);
+  check_roundtrip<uint64_t>(64);
+  check_roundtrip<float>(19);
+}
+
+TEST(TestByteswapCopy, test_byteswap_copy_layout_change) {
+  std::vector<uint32_t> native(6);
+  std::vector<unsigned char> raw(6 * 4);
+  stdex::mdspan<uint32_t, stdex::extents<2, 3>, stdex::layout_right, stdex::byteswap_accessor<uint32_t>> sw(raw.data());
+  for(size_t i = 0; i < 2; ++i)
+    for(size_t j = 0; j < 3; ++j)
+      __MDSPAN_OP(sw, i, j) = uint32_t(i * 3 + j);
+  stdex::mdspan<uint32_t, stdex::extents<2, 3>, stdex::layout_left> dst(native.data());
+  stdex::byteswap_copy(sw, dst);
+  ASSERT_EQ((__MDSPAN_OP(dst, 1, 2)), 5u);
+  ASSERT_EQ(native[1], 3u);
+  // static into dynamic extents
+  std::vector<uint32_t> dynamic(6);
+  stdex::mdspan<uint32_t, stdex::dextents<2>> ddst(dynamic.data(), 2, 3);
+  stdex::byteswap_copy(sw, ddst);
+  ASSERT_EQ(dynamic[4], 4u);
+}
+
+TEST(TestByteswapCopy, test_byteswap_complex_per_component) {
+  // The real and imaginary parts are swapped in place, not exchanged.
+  std::vector<std::complex<float>> native{{1.f, 2.f}, {-3.f, 0.5f}, {7.f, -8.f}}, back(3);
+  std::vector<unsigned char> raw(3 * sizeof(std::complex<float>));
+  stdex::mdspan<std::complex<float>, stdex::extents<3>> src(native.data()), dst(back.data());
+  stdex::mdspan<std::complex<float>, stdex::extents<3>, stdex::layout_right, stdex::byteswap_accessor<std::complex<float>>> sw(raw.data());
+  stdex::byteswap_copy(src, sw);
+  const std::complex<float> first = __MDSPAN_OP(sw, 0);
+  ASSERT_EQ(first, std::complex<float>(1.f, 2.f));
+  const unsigned char* re = reinterpret_cast<const unsigned char*>(native.data());
+  for(size_t b = 0; b < sizeof(float); ++b) {
+    ASSERT_EQ(raw[b], re[sizeof(float) - 1 - b]);
+    ASSERT_EQ(raw[sizeof(float) + b], re[2 * sizeof(float) - 1 - b]);
+  }
+  __MDSPAN_OP(sw, 1) += std::complex<float>(1.f, 1.f);
+  stdex::byteswap_copy(sw, dst);
+  ASSERT_EQ(back[1], std::complex<float>(-2.f, 1.5f));
+  ASSERT_EQ(back[2], native[2]);
+}
+
+TEST(TestByteswapCopy, test_byteswap_copy_strided_and_swapped_to_swapped) {
+  // Big-endian doubles, the second field of 12-byte records, repacked into a
+  // dense big-endian array and then converted.
+  std::vector<unsigned char> records(4 * 12), packed(4 * sizeof(double));
+  stdex::mdspan<double, stdex::extents<4>, stdex::layout_right, stdex::byteswap_accessor<double, 12>> field(records.data() + 4);
+  for(size_t i = 0; i < 4; ++i) __MDSPAN_OP(field, i) = 0.25 * double(i);
+  stdex::mdspan<double, stdex::extents<4>, stdex::layout_right, stdex::byteswap_accessor<double>> dense(packed.data());
+  stdex::byteswap_copy(field, dense);
+  ASSERT_EQ(0, std::memcmp(packed.data() + 3 * sizeof(double), records.data() + 3 * 12 + 4, sizeof(double)));
+  std::vector<double> native(4);
+  stdex::byteswap_copy(dense, stdex::mdspan<double, stdex::extents<4>>(native.data()));
+  ASSERT_EQ(native[3], 0.75);
+  std::vector<double> back{9., 8., 7., 6.};
+  stdex::byteswap_copy(stdex::mdspan<double, stdex::extents<4>>(back.data()), field);
+  ASSERT_EQ(double(__MDSPAN_OP(field, 1)), 8.0);
+}
@@ -0,0 +1,136 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_accessors>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestCompressedAccessor, test_integer_roundtrip) {
+  std::vector<int32_t> data;
+  for(int i = 0; i < 1000; ++i) data.push_back(1000 - 3 * i + (i % 7));
+  data.push_back(std::numeric_limits<int32_t>::max());
+  data.push_back(std::numeric_limits<int32_t>::min());
+  stdex::compressed_storage<int32_t> s(data.data(), data.size(), 64);
+  ASSERT_EQ(s.size(), data.size());
+  ASSERT_EQ(s.block_count(), (data.size() + 63) / 64);
+  for(size_t i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(s.load(i), data[i]);
+  }
+}
+
+TEST(TestCompressedAccessor, test_smooth_field_compresses) {
+  const size_t nx = 32, ny = 32, nz = 32;
+  std::vector<double> field(nx * ny * nz);
+  stdex::mdspan<double, stdex::extents<dyn, dyn, dyn>> f(field.data(), nx, ny, nz);
+  for(size_t i = 0; i < nx; ++i)
+    for(size_t j = 0; j < ny; ++j)
+      for(size_t k = 0; k < nz; ++k)
+        __MDSPAN_OP(f, i, j, k) = 290.0 + 0.25 * double(i % 4) + 0.125 * double(j) + double(k) / 64.0;
+  auto s = stdex::compress(f, 64);
+  // values on a 1/64 grid: small exact deltas in the ordered integer image
+  ASSERT_GT(s.compression_ratio(), 1.25);
+  auto c = stdex::make_compressed_mdspan(s, f.mapping());
+  for(size_t i = 0; i < nx; ++i)
+    for(size_t j = 0; j < ny; ++j)
+      for(size_t k = 0; k < nz; ++k)
+        ASSERT_EQ((__MDSPAN_OP(c, i, j, k)), (__MDSPAN_OP(f, i, j, k)));
+}
+
+TEST(TestCompressedAccessor, test_xor_encoding_float) {
+  std::vector<float> data{1.0f, -1.0f, 0.0f, -0.0f, 3.5f, std::numeric_limits<float>::infinity(), 1e-40f, 7.25f};
+  for(auto enc : {stdex::block_encoding::xor_previous, stdex::block_encoding::delta}) {
+    stdex::compressed_storage<float> s(data.data(), data.size(), 4, enc);
+    auto c = stdex::make_compressed_mdspan(s, stdex::layout_right::mapping<stdex::extents<8>>());
+    for(size_t i = 0; i < data.size(); ++i) {
+      float v = __MDSPAN_OP(c, i);
+      ASSERT_EQ(std::signbit(v), std::signbit(data[i]));
+      ASSERT_EQ(v, data[i]);
+    }
+  }
+}
+
+TEST(TestCompressedAccessor, test_constant_block) {
+  std::vector<uint16_t> data(256, 42);
+  stdex::compressed_storage<uint16_t> s(data.data(), data.size(), 128);
+  // headers only: no residual bits for a constant block
+  ASSERT_LT(s.compressed_bytes(), data.size() * sizeof(uint16_t) / 4);
+  auto c = stdex::make_compressed_mdspan(s, stdex::layout_right::mapping<stdex::extents<16, 16>>());
+  ASSERT_EQ((__MDSPAN_OP(c, 15, 15)), 42);
+  ASSERT_THROW(stdex::compressed_storage<uint16_t>(data.data(), data.size(), 48), std::invalid_argument);
+}
+
+TEST(TestCompressedAccessor, test_layouts_and_submdspan) {
+  std::vector<int64_t> data(12 * 10);
+  for(size_t i = 0; i < data.size(); ++i) data[i] = int64_t(i * i) - 500;
+  stdex::mdspan<int64_t, stdex::extents<dyn, dyn>, stdex::layout_left> l(data.data(), 12, 10);
+  auto s = stdex::compress(l, 16);
+  auto c = stdex::make_compressed_mdspan(s, l.mapping());
+  static_assert(std::is_same<decltype(c)::layout_type, stdex::layout_left>::value, "");
+  for(size_t i = 0; i < 12; ++i)
+    for(size_t j = 0; j < 10; ++j)
+      ASSERT_EQ((__MDSPAN_OP(c, i, j)), (__MDSPAN_OP(l, i, j)));
+  auto col = stdex::submdspan(c, stdex::full_extent, 7);
+  for(size_t i = 0; i < 12; ++i)
+    ASSERT_EQ((__MDSPAN_OP(col, i)), (__MDSPAN_OP(l, i, 7)));
+}
+
+TEST(TestCompressedAccessor, test_two_storages_share_cache) {
+  std::vector<int> a(64, 1), b(64, 2);
+  stdex::compressed_storage<int> sa(a.data(), a.size(), 64);
+  stdex::compressed_storage<int> sb(b.data(), b.size(), 64);
+  auto ca = stdex::make_compressed_mdspan(sa, stdex::layout_right::mapping<stdex::extents<64>>());
+  auto cb = stdex::make_compressed_mdspan(sb, stdex::layout_right::mapping<stdex::extents<64>>());
+  // both map block 0 to the same cache slot
+  ASSERT_EQ((__MDSPAN_OP(ca, 3)), 1);
+  ASSERT_EQ((__MDSPAN_OP(cb, 3)), 2);
+  ASSERT_EQ((__MDSPAN_OP(ca, 5)), 1);
+  ASSERT_NE(sa.id(), sb.id());
+}
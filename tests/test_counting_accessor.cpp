@@ -0,0 +1,178 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_accessors>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestCountingAccessor, test_counting_accessor_reads_writes) {
+  std::vector<int> d(12, 1);
+  stdex::mdspan<int, stdex::extents<3, 4>> m(d.data());
+  stdex::access_counters counters;
+  auto c = stdex::make_counting_mdspan(m, counters);
+  int sum = 0;
+  for(size_t i = 0; i < 3; ++i) {
+    for(size_t j = 0; j < 4; ++j) {
+      sum += __MDSPAN_OP(c, i, j);
+    }
+  }
+  ASSERT_EQ(sum, 12);
+  __MDSPAN_OP(c, 2, 3) = 5;
+  __MDSPAN_OP(c, 0, 0) += 2;
+  ASSERT_EQ(d[11], 5);
+  ASSERT_EQ(d[0], 3);
+  auto s = counters.summary();
+  ASSERT_EQ(s.reads, 13);
+  ASSERT_EQ(s.writes, 2);
+  ASSERT_EQ(s.bytes_read, 13 * sizeof(int));
+  ASSERT_EQ(s.bytes_written, 2 * sizeof(int));
+  ASSERT_EQ(s.min_address, reinterpret_cast<uintptr_t>(d.data()));
+  ASSERT_EQ(s.max_address, reinterpret_cast<uintptr_t>(d.data() + 12));
+  counters.reset();
+  ASSERT_EQ(counters.summary().accesses(), 0);
+}
+
+TEST(TestCountingAccessor, test_counting_accessor_submdspan_range) {
+  std::vector<double> d(20, 0);
+  stdex::mdspan<double, stdex::extents<dyn, dyn>> m(d.data(), 4, 5);
+  stdex::access_counters counters;
+  auto row = stdex::submdspan(stdex::make_counting_mdspan(m, counters), 2, stdex::full_extent);
+  double sum = 0;
+  for(size_t j = 0; j < row.extent(0); ++j) sum += __MDSPAN_OP(row, j);
+  auto s = counters.summary();
+  ASSERT_EQ(s.reads, 5);
+  ASSERT_EQ(s.address_range_bytes(), 5 * sizeof(double));
+  ASSERT_EQ(s.min_address, reinterpret_cast<uintptr_t>(d.data() + 10));
+}
+
+TEST(TestCountingAccessor, test_counting_accessor_threads_merge) {
+  std::vector<int> d(1000, 1);
+  stdex::mdspan<int, stdex::extents<dyn>> m(d.data(), 1000);
+  stdex::access_counters counters;
+  auto c = stdex::make_counting_mdspan(m, counters);
+  std::vector<std::thread> threads;
+  for(size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([=] {
+      for(size_t i = t * 250; i < (t + 1) * 250; ++i) __MDSPAN_OP(c, i) = int(i);
+    });
+  }
+  for(auto& t : threads) t.join();
+  ASSERT_EQ(counters.summary().writes, 1000);
+  ASSERT_EQ(d[999], 999);
+}
+
+TEST(TestCountingAccessor, test_counting_accessor_trace_ring_buffer) {
+  std::vector<int> d(10, 0);
+  stdex::mdspan<int, stdex::extents<10>> m(d.data());
+  stdex::access_counters counters(4);
+  auto c = stdex::make_counting_mdspan(m, counters);
+  for(size_t i = 0; i < 10; ++i) __MDSPAN_OP(c, i) = 1;
+  auto trace = counters.trace();
+  ASSERT_EQ(trace.size(), 4);
+  for(size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(trace[i].address, reinterpret_cast<uintptr_t>(d.data() + 6 + i));
+    ASSERT_TRUE(trace[i].is_write);
+  }
+}
+
+TEST(TestCacheSimulator, test_cache_simulator_lru) {
+  // 2 sets, 2 ways, 64 byte lines
+  stdex::cache_simulator cache(256, 64, 2);
+  ASSERT_EQ(cache.sets(), 2);
+  cache.access(0);       // set 0, miss
+  cache.access(8, 8);    // same line, hit
+  cache.access(128);     // set 0, miss
+  cache.access(0);       // hit, line 2 becomes LRU
+  cache.access(256);     // set 0, miss, evicts line 2
+  cache.access(128);     // miss
+  cache.access(0);       // evicted by the previous access: miss
+  ASSERT_EQ(cache.hits(), 2);
+  ASSERT_EQ(cache.misses(), 5);
+  cache.access(60, 8);   // straddles lines 0 and 1
+  ASSERT_EQ(cache.hits() + cache.misses(), 9);
+  ASSERT_THROW(stdex::cache_simulator(1000, 48, 2), std::invalid_argument);
+}
+
+TEST(TestCacheSimulator, test_cache_simulator_layout_comparison) {
+  // Column traversal of a row-major matrix touches a new line on every access
+  // once the matrix no longer fits in the cache; layout_left does not.
+  constexpr size_t n = 64;
+  std::vector<double> d(n * n, 0);
+  auto traverse_columns = [&](auto m) {
+    stdex::access_counters counters(n * n);
+    auto c = stdex::make_counting_mdspan(m, counters);
+    double sum = 0;
+    for(size_t j = 0; j < n; ++j)
+      for(size_t i = 0; i < n; ++i)
+        sum += __MDSPAN_OP(c, i, j);
+    stdex::cache_simulator cache(4096, 64, 4);
+    cache.replay(counters.trace());
+    return cache.misses();
+  };
+  auto right_misses = traverse_columns(stdex::mdspan<double, stdex::extents<n, n>, stdex::layout_right>(d.data()));
+  auto left_misses = traverse_columns(stdex::mdspan<double, stdex::extents<n, n>, stdex::layout_left>(d.data()));
+  // (+1 because the vector's storage need not start on a line boundary)
+  ASSERT_LE(left_misses, n * n * sizeof(double) / 64 + 1);
+  ASSERT_EQ(right_misses, n * n);
+}
+
+TEST(TestCacheSimulator, test_cache_simulator_streaming) {
+  std::vector<int> d(1024, 0);
+  stdex::mdspan<int, stdex::extents<dyn>> m(d.data(), 1024);
+  stdex::cache_simulator cache(1024, 64, 2);
+  stdex::access_counters counters;
+  counters.simulate(&cache);
+  auto c = stdex::make_counting_mdspan(m, counters);
+  for(size_t i = 0; i < 1024; ++i) __MDSPAN_OP(c, i) = 1;
+  ASSERT_EQ(cache.hits() + cache.misses(), 1024);
+  ASSERT_LE(cache.misses(), 1024 * sizeof(int) / 64 + 1);
+  counters.simulate(nullptr);
+  __MDSPAN_OP(c, 0) = 2;
+  ASSERT_EQ(cache.hits() + cache.misses(), 1024);
+}
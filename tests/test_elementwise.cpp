@@ -0,0 +1,123 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+template <class Policy>
+void check_fused_update(Policy policy) {
+  // Five updates of o, fused: o = ((o + s) * 2 - a) / 2 + 1 with a = 2 * s.
+  std::vector<double> o(6 * 5 * 4), s(o.size()), a(o.size());
+  stdex::mdspan<double, stdex::extents<dyn, 5, 4>> mo(o.data(), 6);
+  stdex::mdspan<double, stdex::extents<dyn, 5, 4>, stdex::layout_left> ms(s.data(), 6);
+  stdex::mdspan<double, stdex::dextents<3>> ma(a.data(), 6, 5, 4);
+  stdex::for_each_index(mo.extents(), [&](size_t i, size_t j, size_t k) {
+    const size_t n = (i * 5 + j) * 4 + k;
+    __MDSPAN_OP(mo, i, j, k) = double(n);
+    __MDSPAN_OP(ms, i, j, k) = double(n % 7);
+    __MDSPAN_OP(ma, i, j, k) = 2.0 * double(n % 7);
+  });
+
+  stdex::assign(policy, mo, ((stdex::elementwise(mo) + ms) * 2.0 - ma) / 2.0 + 1.0);
+  for(size_t i = 0; i < 6; ++i) {
+    for(size_t j = 0; j < 5; ++j) {
+      for(size_t k = 0; k < 4; ++k) {
+        const double actual = __MDSPAN_OP(mo, i, j, k);
+        const size_t n = (i * 5 + j) * 4 + k;
+        ASSERT_EQ(actual, double(n) + 1.0);
+      }
+    }
+  }
+}
+
+TEST(TestElementwise, test_fused_update) {
+  check_fused_update(stdex::execution::seq);
+  check_fused_update(stdex::execution::par);
+  check_fused_update(stdex::execution::par_unseq.with_threads(3));
+}
+
+TEST(TestElementwise, test_map_cast_and_scalars) {
+  std::vector<std::int16_t> n(12);
+  std::vector<float> x(12), y(12, -1.f);
+  for(size_t i = 0; i < 12; ++i) { n[i] = std::int16_t(30000 + i); x[i] = float(i); }
+  stdex::mdspan<std::int16_t, stdex::extents<3, 4>> mn(n.data());
+  stdex::mdspan<float, stdex::extents<3, 4>> mx(x.data());
+  stdex::mdspan<float, stdex::dextents<2>> my(y.data(), 3, 4);
+
+  // The cast happens per element, before the addition that would overflow int16_t.
+  auto e = stdex::elementwise_cast<float>(mn) + stdex::elementwise_map([](float v) { return v * v; }, mx);
+  static_assert(std::is_same<decltype(e)::value_type, float>::value, "");
+  stdex::assign(my, -(1.f - e));
+  for(size_t i = 0; i < 12; ++i) ASSERT_EQ(y[i], float(30000 + i) + float(i * i) - 1.f);
+
+  stdex::assign(my, stdex::elementwise_map([](float v, float w) { return v < w ? v : w; }, mx, 5.f));
+  for(size_t i = 0; i < 12; ++i) ASSERT_EQ(y[i], i < 5 ? float(i) : 5.f);
+
+  // A scalar alone is a fill.
+  stdex::assign(my, 2.5f);
+  for(float v : y) ASSERT_EQ(v, 2.5f);
+}
+
+TEST(TestElementwise, test_static_extents) {
+  // Static extents of any operand are kept; scalars broadcast.
+  std::vector<int> a(8 * 3), b(a.size());
+  stdex::mdspan<int, stdex::extents<dyn, 3>> ma(a.data(), 8);
+  stdex::mdspan<int, stdex::extents<8, dyn>> mb(b.data(), 3);
+  auto e = stdex::elementwise(ma) + stdex::elementwise(mb) * 2;
+  static_assert(decltype(e)::extents_type::static_extent(0) == 8, "");
+  static_assert(decltype(e)::extents_type::static_extent(1) == 3, "");
+  static_assert(decltype(e)::extents_type::rank_dynamic() == 0, "");
+  ASSERT_EQ(e.extents().extent(0), 8u);
+  ASSERT_EQ(e.extents().extent(1), 3u);
+
+  for(size_t i = 0; i < a.size(); ++i) { a[i] = int(i); b[i] = 1; }
+  stdex::assign(ma, e);
+  for(size_t i = 0; i < a.size(); ++i) ASSERT_EQ(a[i], int(i) + 2);
+}
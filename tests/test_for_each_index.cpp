@@ -0,0 +1,172 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestForEachIndex, test_extents_row_major) {
+  std::vector<std::array<size_t, 3>> visited;
+  stdex::for_each_index(stdex::extents<2, dyn, 3>(2), [&](size_t i, size_t j, size_t k) {
+    visited.push_back({{i, j, k}});
+  });
+  ASSERT_EQ(visited.size(), 12u);
+  ASSERT_EQ(visited[0], (std::array<size_t, 3>{{0, 0, 0}}));
+  ASSERT_EQ(visited[1], (std::array<size_t, 3>{{0, 0, 1}}));
+  ASSERT_EQ(visited[3], (std::array<size_t, 3>{{0, 1, 0}}));
+  ASSERT_EQ(visited[11], (std::array<size_t, 3>{{1, 1, 2}}));
+}
+
+TEST(TestForEachIndex, test_layout_picks_stride_one_innermost) {
+  std::vector<int> buf(4 * 5 * 6);
+  stdex::mdspan<int, stdex::extents<dyn, 5, dyn>, stdex::layout_left> l(buf.data(), 4, 6);
+  std::vector<size_t> offsets;
+  stdex::for_each_index(l, [&](size_t i, size_t j, size_t k) { offsets.push_back(l.mapping()(i, j, k)); });
+  ASSERT_EQ(offsets.size(), buf.size());
+  for(size_t n = 0; n < offsets.size(); ++n) ASSERT_EQ(offsets[n], n);
+
+  stdex::mdspan<int, stdex::extents<dyn, 5, dyn>> r(buf.data(), 4, 6);
+  offsets.clear();
+  stdex::for_each_index(r.mapping(), [&](size_t i, size_t j, size_t k) { offsets.push_back(r.mapping()(i, j, k)); });
+  for(size_t n = 0; n < offsets.size(); ++n) ASSERT_EQ(offsets[n], n);
+}
+
+TEST(TestForEachIndex, test_layout_stride_runtime_order) {
+  // a 3 x 4 x 2 box stored with strides {2, 6, 1}: dimension 1 is outermost
+  using exts_t = stdex::dextents<3>;
+  stdex::layout_stride::mapping<exts_t> map(exts_t(3, 4, 2), std::array<size_t, 3>{{2, 6, 1}});
+  std::vector<size_t> offsets;
+  size_t count = 0;
+  stdex::for_each_index(map, [&](size_t i, size_t j, size_t k) {
+    offsets.push_back(map(i, j, k));
+    ++count;
+  });
+  ASSERT_EQ(count, 24u);
+  for(size_t n = 0; n < offsets.size(); ++n) ASSERT_EQ(offsets[n], n);
+}
+
+TEST(TestForEachIndex, test_static_unroll_and_edge_ranks) {
+  int sum = 0;
+  stdex::for_each_index(stdex::extents<3, 3>(), [&](size_t i, size_t j) { sum += int(10 * i + j); });
+  ASSERT_EQ(sum, 3 * (0 + 10 + 20) + 3 * (0 + 1 + 2));
+
+  int calls = 0;
+  stdex::for_each_index(stdex::extents<>(), [&]() { ++calls; });
+  ASSERT_EQ(calls, 1);
+
+  stdex::for_each_index(stdex::extents<dyn, 0>(5), [&](size_t, size_t) { ++calls; });
+  stdex::layout_stride::mapping<stdex::dextents<2>> empty(stdex::dextents<2>(0, 3), std::array<size_t, 2>{{3, 1}});
+  stdex::for_each_index(empty, [&](size_t, size_t) { ++calls; });
+  ASSERT_EQ(calls, 1);
+
+  // rank 5, mixed static and dynamic
+  size_t n = 0;
+  stdex::for_each_index(stdex::extents<2, dyn, 1, 3, dyn>(4, 2), [&](size_t, size_t, size_t, size_t, size_t) { ++n; });
+  ASSERT_EQ(n, 2u * 4 * 1 * 3 * 2);
+}
+
+TEST(TestForEachIndex, test_cache_oblivious_visits_every_index_once) {
+  std::vector<int> count(37 * 19 * 5, 0);
+  auto exts = stdex::dextents<3>(37, 19, 5);
+  stdex::for_each_index_cache_oblivious<4>(exts, [&](size_t i, size_t j, size_t k) {
+    ++count[(i * 19 + j) * 5 + k];
+  });
+  for(int c : count) ASSERT_EQ(c, 1);
+
+  // Default base-case box, a layout_left mapping and an empty index space.
+  std::vector<int> count2(40 * 50, 0);
+  auto map = stdex::layout_left::mapping<stdex::extents<40, dyn>>(stdex::extents<40, dyn>(50));
+  stdex::for_each_index_cache_oblivious(map, [&](size_t i, size_t j) { ++count2[map(i, j)]; });
+  for(int c : count2) ASSERT_EQ(c, 1);
+  int calls = 0;
+  stdex::for_each_index_cache_oblivious(stdex::dextents<2>(0, 10), [&](size_t, size_t) { ++calls; });
+  ASSERT_EQ(calls, 0);
+}
+
+TEST(TestForEachIndex, test_cache_oblivious_boxes) {
+  // 20 x 12 with 8-boxes: cuts at multiples of 8, full boxes typed static.
+  size_t full = 0, partial = 0, volume = 0;
+  stdex::for_each_box_cache_oblivious<8>(stdex::dextents<2>(20, 12), [&](auto origin, auto box) {
+    ASSERT_EQ(origin[0] % 8, 0u);
+    ASSERT_EQ(origin[1] % 8, 0u);
+    ASSERT_LE(origin[0] + box.extent(0), 20u);
+    ASSERT_LE(origin[1] + box.extent(1), 12u);
+    if(decltype(box)::rank_dynamic() == 0) {
+      ++full;
+      ASSERT_EQ(box.extent(0), 8u);
+      ASSERT_EQ(box.extent(1), 8u);
+    }
+    else {
+      ++partial;
+    }
+    volume += box.extent(0) * box.extent(1);
+  });
+  ASSERT_EQ(full, 2u);
+  ASSERT_EQ(partial, 4u);
+  ASSERT_EQ(volume, 240u);
+
+  // The traversal stays local: consecutive boxes touch neighbouring regions.
+  std::vector<std::array<size_t, 2>> origins;
+  stdex::for_each_box_cache_oblivious<4>(stdex::dextents<2>(16, 16), [&](auto origin, auto) {
+    origins.push_back({{origin[0], origin[1]}});
+  });
+  ASSERT_EQ(origins.size(), 16u);
+  for(size_t b = 0; b < 16; b += 4) {
+    // every aligned group of four boxes is one 8 x 8 quadrant
+    for(size_t q = 1; q < 4; ++q) {
+      ASSERT_EQ(origins[b + q][0] / 8, origins[b][0] / 8);
+      ASSERT_EQ(origins[b + q][1] / 8, origins[b][1] / 8);
+    }
+  }
+
+  int calls = 0;
+  stdex::for_each_index_cache_oblivious(stdex::extents<>(), [&]() { ++calls; });
+  ASSERT_EQ(calls, 1);
+}
@@ -0,0 +1,152 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_algorithm>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+template <class T, class Src, class Dst>
+void check_copy_2d(size_t n0, size_t n1) {
+  using exts_t = stdex::extents<dyn, dyn>;
+  std::vector<T> a(n0 * n1), b(n0 * n1, T(-1));
+  auto src = stdex::mdspan<T, exts_t, Src>(a.data(), n0, n1);
+  auto dst = stdex::mdspan<T, exts_t, Dst>(b.data(), n0, n1);
+  for(size_t i = 0; i < n0; ++i)
+    for(size_t j = 0; j < n1; ++j)
+      __MDSPAN_OP(src, i, j) = T(i * 1000 + j);
+  stdex::copy(src, dst);
+  for(size_t i = 0; i < n0; ++i) {
+    for(size_t j = 0; j < n1; ++j) {
+      T v = __MDSPAN_OP(dst, i, j);
+      ASSERT_EQ(v, T(i * 1000 + j)) << i << " " << j;
+    }
+  }
+}
+
+TEST(TestLayoutCopy, test_copy_same_layout) {
+  check_copy_2d<int, stdex::layout_right, stdex::layout_right>(13, 7);
+  check_copy_2d<double, stdex::layout_left, stdex::layout_left>(13, 7);
+  check_copy_2d<int, stdex::layout_right, stdex::layout_right>(0, 7);
+}
+
+TEST(TestLayoutCopy, test_copy_transposed_layouts) {
+  // 4- and 8-byte element types take the SSE tiles, others the scalar ones;
+  // the odd sizes exercise the block and tile edges.
+  check_copy_2d<int, stdex::layout_left, stdex::layout_right>(37, 19);
+  check_copy_2d<int, stdex::layout_right, stdex::layout_left>(37, 19);
+  check_copy_2d<float, stdex::layout_right, stdex::layout_left>(64, 64);
+  check_copy_2d<double, stdex::layout_left, stdex::layout_right>(70, 33);
+  check_copy_2d<double, stdex::layout_right, stdex::layout_left>(33, 70);
+  check_copy_2d<short, stdex::layout_right, stdex::layout_left>(21, 9);
+  check_copy_2d<int, stdex::layout_right, stdex::layout_left>(3, 50);
+}
+
+TEST(TestLayoutCopy, test_copy_strided) {
+  // Padded rows: a layout_stride source whose columns are contiguous.
+  std::vector<int> a(40 * 12, 0), b(40 * 10, -1);
+  auto src = stdex::mdspan<int, stdex::dextents<2>, stdex::layout_stride>(
+    a.data(), stdex::layout_stride::mapping<stdex::dextents<2>>(
+      stdex::dextents<2>(10, 40), std::array<size_t, 2>{1, 12}));
+  auto dst = stdex::mdspan<int, stdex::dextents<2>, stdex::layout_right>(b.data(), 10, 40);
+  for(size_t i = 0; i < 10; ++i)
+    for(size_t j = 0; j < 40; ++j)
+      __MDSPAN_OP(src, i, j) = int(i * 100 + j);
+  stdex::copy(src, dst);
+  for(size_t i = 0; i < 10; ++i) {
+    for(size_t j = 0; j < 40; ++j) {
+      int v = __MDSPAN_OP(dst, i, j);
+      ASSERT_EQ(v, int(i * 100 + j));
+    }
+  }
+  // Back into a padded strided destination: the padding is left alone.
+  std::vector<int> c(40 * 12, -1);
+  auto dst2 = stdex::mdspan<int, stdex::dextents<2>, stdex::layout_stride>(
+    c.data(), stdex::layout_stride::mapping<stdex::dextents<2>>(
+      stdex::dextents<2>(10, 40), std::array<size_t, 2>{1, 12}));
+  stdex::copy(dst, dst2);
+  for(size_t k = 0; k < c.size(); ++k) {
+    if(k % 12 < 10) { ASSERT_EQ(c[k], a[k]); }
+    else { ASSERT_EQ(c[k], -1); }
+  }
+  // Padded rows on both sides, with different padding: a copy per row.
+  std::vector<int> d(10 * 45, -1);
+  auto dst3 = stdex::mdspan<int, stdex::dextents<2>, stdex::layout_stride>(
+    d.data(), stdex::layout_stride::mapping<stdex::dextents<2>>(
+      stdex::dextents<2>(10, 40), std::array<size_t, 2>{45, 1}));
+  stdex::copy(dst, dst3);
+  for(size_t k = 0; k < d.size(); ++k) {
+    if(k % 45 < 40) { ASSERT_EQ(d[k], b[k / 45 * 40 + k % 45]); }
+    else { ASSERT_EQ(d[k], -1); }
+  }
+}
+
+TEST(TestLayoutCopy, test_copy_rank3_and_const_source) {
+  std::vector<double> a(4 * 5 * 6), b(4 * 5 * 6, -1.0);
+  auto src = stdex::mdspan<double, stdex::extents<4, 5, 6>, stdex::layout_left>(a.data());
+  auto dst = stdex::mdspan<double, stdex::extents<4, 5, 6>, stdex::layout_right>(b.data());
+  for(size_t i = 0; i < 4; ++i)
+    for(size_t j = 0; j < 5; ++j)
+      for(size_t k = 0; k < 6; ++k)
+        __MDSPAN_OP(src, i, j, k) = double(i * 100 + j * 10 + k);
+  auto csrc = stdex::mdspan<const double, stdex::extents<4, 5, 6>, stdex::layout_left>(src);
+  stdex::copy(csrc, dst);
+  for(size_t i = 0; i < 4; ++i) {
+    for(size_t j = 0; j < 5; ++j) {
+      for(size_t k = 0; k < 6; ++k) {
+        double v = __MDSPAN_OP(dst, i, j, k);
+        ASSERT_EQ(v, double(i * 100 + j * 10 + k));
+      }
+    }
+  }
+  // The sequenced policy overload goes through the same dispatch.
+  std::vector<double> c(4 * 5 * 6, -1.0);
+  auto dst2 = stdex::mdspan<double, stdex::extents<4, 5, 6>, stdex::layout_left>(c.data());
+  stdex::copy(stdex::execution::seq, dst, dst2);
+  ASSERT_EQ(c, a);
+}
@@ -0,0 +1,146 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/linalg>
+#include <experimental/mdspan_algorithm>
+#include <complex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+namespace linalg = std::experimental::linalg;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+template <class T>
+T test_value(size_t i, size_t j, size_t salt) {
+  return T(int((i * 7 + j * 13 + salt) % 11) - 5);
+}
+
+template <class A, class B, class C>
+void reference_product(A const& a, B const& b, C const& c) {
+  for(size_t i = 0; i < c.extent(0); ++i) {
+    for(size_t j = 0; j < c.extent(1); ++j) {
+      typename C::value_type sum = 0;
+      for(size_t p = 0; p < a.extent(1); ++p) {
+        sum += __MDSPAN_OP(a, i, p) * __MDSPAN_OP(b, p, j);
+      }
+      __MDSPAN_OP(c, i, j) = sum;
+    }
+  }
+}
+
+template <class T, class LayoutA, class LayoutB, class LayoutC, class Policy>
+void check_product(Policy const& policy, size_t m, size_t n, size_t k) {
+  using mapping_a = typename LayoutA::template mapping<stdex::dextents<2>>;
+  using mapping_b = typename LayoutB::template mapping<stdex::dextents<2>>;
+  using mapping_c = typename LayoutC::template mapping<stdex::dextents<2>>;
+  std::vector<T> da(m * k), db(k * n), dc(m * n, T(99)), dr(m * n);
+  stdex::mdspan<T, stdex::dextents<2>, LayoutA> a(da.data(), mapping_a(stdex::dextents<2>(m, k)));
+  stdex::mdspan<T, stdex::dextents<2>, LayoutB> b(db.data(), mapping_b(stdex::dextents<2>(k, n)));
+  stdex::mdspan<T, stdex::dextents<2>, LayoutC> c(dc.data(), mapping_c(stdex::dextents<2>(m, n)));
+  stdex::mdspan<T, stdex::dextents<2>> r(dr.data(), m, n);
+  for(size_t i = 0; i < m; ++i) for(size_t p = 0; p < k; ++p) __MDSPAN_OP(a, i, p) = test_value<T>(i, p, 1);
+  for(size_t p = 0; p < k; ++p) for(size_t j = 0; j < n; ++j) __MDSPAN_OP(b, p, j) = test_value<T>(p, j, 2);
+
+  linalg::matrix_product(policy, a, b, c);
+  reference_product(a, b, r);
+  for(size_t i = 0; i < m; ++i) {
+    for(size_t j = 0; j < n; ++j) {
+      const T expected = __MDSPAN_OP(r, i, j);
+      const T actual = __MDSPAN_OP(c, i, j);
+      ASSERT_EQ(actual, expected) << "at (" << i << ", " << j << ") of " << m << " x " << n << " x " << k;
+    }
+  }
+}
+
+} // namespace
+
+TEST(TestLinalgMatrixProduct, test_layouts_and_edges) {
+  // Sizes around the register tile and past one kc slice of the inner
+  // dimension; small integers keep float and double sums exact.
+  const size_t sizes[][3] = {{1, 1, 1}, {5, 7, 3}, {13, 33, 17}, {40, 9, 300}, {67, 70, 520}};
+  for(auto const& s : sizes) {
+    check_product<double, stdex::layout_right, stdex::layout_right, stdex::layout_right>(stdex::execution::seq, s[0], s[1], s[2]);
+    check_product<float, stdex::layout_left, stdex::layout_right, stdex::layout_left>(stdex::execution::seq, s[0], s[1], s[2]);
+    check_product<int, stdex::layout_right, stdex::layout_left, stdex::layout_right>(stdex::execution::par, s[0], s[1], s[2]);
+    check_product<std::complex<double>, stdex::layout_left, stdex::layout_left, stdex::layout_right>(stdex::execution::par, s[0], s[1], s[2]);
+  }
+}
+
+TEST(TestLinalgMatrixProduct, test_strided_and_scaled) {
+  // A: every other column of a row-major 6 x 8 buffer.  B: column-major with
+  // a leading dimension of 6.  C: the left half of each row of an 8 x 8 buffer.
+  std::vector<double> da(6 * 8), db(4 * 6), dc(8 * 8, -1);
+  for(size_t i = 0; i < da.size(); ++i) da[i] = double(i % 5);
+  for(size_t i = 0; i < db.size(); ++i) db[i] = double(i % 3) - 1;
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>> a_map(stdex::extents<dyn, dyn>(4, 4), std::array<size_t, 2>{8, 2});
+  stdex::mdspan<double, stdex::extents<dyn, dyn>, stdex::layout_stride> as(da.data(), a_map);
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>> b_map(stdex::extents<dyn, dyn>(4, 4), std::array<size_t, 2>{1, 6});
+  stdex::mdspan<double, stdex::extents<dyn, dyn>, stdex::layout_stride> bs(db.data(), b_map);
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>> c_map(stdex::extents<dyn, dyn>(4, 4), std::array<size_t, 2>{8, 1});
+  stdex::mdspan<double, stdex::extents<dyn, dyn>, stdex::layout_stride> cs(dc.data(), c_map);
+
+  linalg::matrix_product(linalg::scaled(2.0, as), linalg::scaled(-0.5, bs), cs);
+  for(size_t i = 0; i < 4; ++i) {
+    for(size_t j = 0; j < 4; ++j) {
+      double expected = 0;
+      for(size_t p = 0; p < 4; ++p) expected -= da[i * 8 + p * 2] * db[p + j * 6];
+      ASSERT_EQ(dc[i * 8 + j], expected);
+      // the right half of each row of C's buffer is untouched
+      ASSERT_EQ(dc[i * 8 + 4 + j], -1.0);
+    }
+  }
+}
+
+TEST(TestLinalgMatrixProduct, test_empty_inner_dimension) {
+  std::vector<float> dc(6, 3.f);
+  stdex::mdspan<float, stdex::extents<2, 0>> a(nullptr);
+  stdex::mdspan<float, stdex::extents<0, 3>> b(nullptr);
+  stdex::mdspan<float, stdex::extents<2, 3>> c(dc.data());
+  linalg::matrix_product(a, b, c);
+  for(float v : dc) ASSERT_EQ(v, 0.f);
+}
@@ -0,0 +1,175 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/linalg>
+#include <experimental/mdspan_algorithm>
+#include <complex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+namespace linalg = std::experimental::linalg;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+template <class T>
+T test_value(size_t i, size_t j, size_t salt) {
+  return T(int((i * 7 + j * 13 + salt) % 11) - 5);
+}
+
+// y = A * X (+ y) one right-hand side at a time, for rank-2 X and Y.
+template <class T, class LayoutA, class Policy>
+void check_product(Policy const& policy, size_t m, size_t k, size_t nrhs, bool update) {
+  using mapping_a = typename LayoutA::template mapping<stdex::dextents<2>>;
+  std::vector<T> da(m * k), dx(k * nrhs), dy(m * nrhs);
+  stdex::mdspan<T, stdex::dextents<2>, LayoutA> a(da.data(), mapping_a(stdex::dextents<2>(m, k)));
+  stdex::mdspan<T, stdex::dextents<2>, stdex::layout_left> x(dx.data(), k, nrhs);
+  stdex::mdspan<T, stdex::dextents<2>, stdex::layout_right> y(dy.data(), m, nrhs);
+  for(size_t i = 0; i < m; ++i) for(size_t j = 0; j < k; ++j) __MDSPAN_OP(a, i, j) = test_value<T>(i, j, 1);
+  for(size_t j = 0; j < k; ++j) for(size_t r = 0; r < nrhs; ++r) __MDSPAN_OP(x, j, r) = test_value<T>(j, r, 2);
+  for(size_t i = 0; i < m; ++i) for(size_t r = 0; r < nrhs; ++r) __MDSPAN_OP(y, i, r) = test_value<T>(i, r, 3);
+
+  if(update) linalg::matrix_vector_product(policy, a, x, y, y);
+  else linalg::matrix_vector_product(policy, a, x, y);
+  for(size_t i = 0; i < m; ++i) {
+    for(size_t r = 0; r < nrhs; ++r) {
+      T expected = update ? test_value<T>(i, r, 3) : T(0);
+      for(size_t j = 0; j < k; ++j) expected += test_value<T>(i, j, 1) * test_value<T>(j, r, 2);
+      const T actual = __MDSPAN_OP(y, i, r);
+      ASSERT_EQ(actual, expected) << "at (" << i << ", " << r << ") of " << m << " x " << k << " x " << nrhs;
+    }
+  }
+
+  // The rank-1 overload on the first right-hand side.
+  std::vector<T> dv(m, T(99));
+  stdex::mdspan<T, stdex::dextents<1>> v(dv.data(), m);
+  linalg::matrix_vector_product(policy, a, stdex::submdspan(x, stdex::full_extent, 0), v);
+  for(size_t i = 0; i < m; ++i) {
+    T expected = 0;
+    for(size_t j = 0; j < k; ++j) expected += test_value<T>(i, j, 1) * test_value<T>(j, 0, 2);
+    ASSERT_EQ(dv[i], expected) << "at " << i << " of " << m << " x " << k;
+  }
+}
+
+} // namespace
+
+TEST(TestLinalgMatrixVectorProduct, test_layouts_and_edges) {
+  // Sizes around the row block of a task, the dot kernel's rows and simd
+  // width, and the column kernel's four columns; small integers keep float
+  // and double sums exact.
+  const size_t sizes[][3] = {{1, 1, 1}, {5, 7, 2}, {13, 33, 3}, {300, 9, 1}, {517, 70, 5}};
+  for(auto const& s : sizes) {
+    for(bool update : {false, true}) {
+      check_product<double, stdex::layout_right>(stdex::execution::seq, s[0], s[1], s[2], update);
+      check_product<float, stdex::layout_left>(stdex::execution::seq, s[0], s[1], s[2], update);
+      check_product<double, stdex::layout_left>(stdex::execution::par, s[0], s[1], s[2], update);
+      check_product<float, stdex::layout_right>(stdex::execution::par, s[0], s[1], s[2], update);
+      check_product<int, stdex::layout_right>(stdex::execution::par, s[0], s[1], s[2], update);
+      check_product<std::complex<double>, stdex::layout_left>(stdex::execution::seq, s[0], s[1], s[2], update);
+    }
+  }
+}
+
+TEST(TestLinalgMatrixVectorProduct, test_transposed_strided_and_scaled) {
+  // A: every other column of a row-major 6 x 8 buffer, so neither dimension
+  // has unit stride.
+  std::vector<double> da(6 * 8), dx(6), dy(4, -1);
+  for(size_t i = 0; i < da.size(); ++i) da[i] = double(i % 5);
+  for(size_t i = 0; i < dx.size(); ++i) dx[i] = double(i % 3) - 1;
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>> a_map(stdex::extents<dyn, dyn>(6, 4), std::array<size_t, 2>{8, 2});
+  stdex::mdspan<double, stdex::extents<dyn, dyn>, stdex::layout_stride> as(da.data(), a_map);
+  stdex::mdspan<double, stdex::extents<dyn>> x(dx.data(), 6);
+  stdex::mdspan<double, stdex::extents<dyn>> y(dy.data(), 4);
+
+  // y = (2 A)^T * (-0.5 x)
+  auto at = linalg::transposed(linalg::scaled(2.0, as));
+  ASSERT_EQ(at.extent(0), 4u);
+  ASSERT_EQ(at.extent(1), 6u);
+  linalg::matrix_vector_product(at, linalg::scaled(-0.5, x), y);
+  for(size_t j = 0; j < 4; ++j) {
+    double expected = 0;
+    for(size_t i = 0; i < 6; ++i) expected -= da[i * 8 + j * 2] * dx[i];
+    ASSERT_EQ(dy[j], expected);
+  }
+
+  // transposed() of layout_left / layout_right swaps the two; twice is a no-op.
+  std::vector<float> dl(3 * 5);
+  for(size_t i = 0; i < dl.size(); ++i) dl[i] = float(i);
+  stdex::mdspan<float, stdex::extents<3, dyn>, stdex::layout_left> l(dl.data(), 5);
+  auto lt = linalg::transposed(l);
+  static_assert(std::is_same<decltype(lt)::layout_type, stdex::layout_right>::value, "");
+  static_assert(decltype(lt)::extents_type::static_extent(1) == 3, "");
+  auto ltt = linalg::transposed(lt);
+  static_assert(std::is_same<decltype(ltt)::layout_type, stdex::layout_left>::value, "");
+  for(size_t i = 0; i < 3; ++i) {
+    for(size_t j = 0; j < 5; ++j) {
+      const float lij = __MDSPAN_OP(l, i, j);
+      const float ltji = __MDSPAN_OP(lt, j, i);
+      const float lttij = __MDSPAN_OP(ltt, i, j);
+      ASSERT_EQ(ltji, lij);
+      ASSERT_EQ(lttij, lij);
+    }
+  }
+
+  // y = A^T * x for a layout_left A runs the row-dot kernel on the same data.
+  std::vector<float> dv(5), dw(3, 1.f);
+  stdex::mdspan<float, stdex::extents<dyn>> v(dv.data(), 5);
+  stdex::mdspan<float, stdex::extents<dyn>> w(dw.data(), 3);
+  linalg::matrix_vector_product(stdex::execution::par, lt, w, v);
+  for(size_t j = 0; j < 5; ++j) ASSERT_EQ(dv[j], dl[j * 3] + dl[j * 3 + 1] + dl[j * 3 + 2]);
+}
+
+TEST(TestLinalgMatrixVectorProduct, test_empty_inner_dimension) {
+  std::vector<float> dy(2, 3.f), dz{1.f, 2.f};
+  stdex::mdspan<float, stdex::extents<2, 0>> a(nullptr);
+  stdex::mdspan<float, stdex::extents<0>> x(nullptr);
+  stdex::mdspan<float, stdex::extents<2>> y(dy.data()), z(dz.data());
+  linalg::matrix_vector_product(a, x, y);
+  for(float v : dy) ASSERT_EQ(v, 0.f);
+  linalg::matrix_vector_product(a, x, z, y);
+  ASSERT_EQ(dy[0], 1.f);
+  ASSERT_EQ(dy[1], 2.f);
+}
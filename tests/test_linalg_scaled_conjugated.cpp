@@ -0,0 +1,133 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/linalg>
+#include <complex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+namespace linalg = std::experimental::linalg;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestLinalgScaled, test_scaled_view_does_not_modify) {
+  std::vector<double> d = {1, 2, 3, 4, 5, 6};
+  stdex::mdspan<double, stdex::extents<2, 3>> m(d.data());
+  auto s = linalg::scaled(2.0, m);
+  static_assert(std::is_same<decltype(s)::element_type, const double>::value, "");
+  static_assert(std::is_same<decltype(s)::reference, double>::value, "");
+  ASSERT_EQ((__MDSPAN_OP(s, 1, 2)), 12.0);
+  ASSERT_EQ((__MDSPAN_OP(s, 0, 0)), 2.0);
+  ASSERT_EQ(d[5], 6.0);
+  auto ss = linalg::scaled(3, s);
+  ASSERT_EQ((__MDSPAN_OP(ss, 1, 0)), 24.0);
+  ASSERT_EQ(linalg::detail::__scaling_factor(ss), 6.0);
+  ASSERT_EQ(linalg::detail::__unscaled(ss).data(), d.data());
+}
+
+TEST(TestLinalgScaled, test_scaled_submdspan) {
+  std::vector<int> d = {1, 2, 3, 4, 5, 6};
+  stdex::mdspan<int, stdex::extents<dyn, dyn>> m(d.data(), 2, 3);
+  auto row = stdex::submdspan(linalg::scaled(10, m), 1, stdex::full_extent);
+  ASSERT_EQ(row.extent(0), 3);
+  ASSERT_EQ((__MDSPAN_OP(row, 2)), 60);
+}
+
+TEST(TestLinalgConjugated, test_conjugated_view) {
+  using c_t = std::complex<double>;
+  std::vector<c_t> d = {{1, 2}, {3, -4}};
+  stdex::mdspan<c_t, stdex::extents<2>> v(d.data());
+  auto c = linalg::conjugated(v);
+  ASSERT_EQ((__MDSPAN_OP(c, 0)), c_t(1, -2));
+  ASSERT_EQ((__MDSPAN_OP(c, 1)), c_t(3, 4));
+  auto cc = linalg::conjugated(c);
+  static_assert(std::is_same<decltype(cc), decltype(v)>::value, "");
+  ASSERT_EQ((__MDSPAN_OP(cc, 0)), c_t(1, 2));
+
+  std::vector<double> r = {1, -2};
+  stdex::mdspan<double, stdex::extents<2>> rv(r.data());
+  ASSERT_EQ((__MDSPAN_OP(linalg::conjugated(rv), 1)), -2.0);
+}
+
+TEST(TestLinalgBlas1, test_dot_scaled) {
+  std::vector<double> x = {1, 2, 3, 4}, y = {4, 3, 2, 1};
+  stdex::mdspan<double, stdex::extents<dyn>> vx(x.data(), 4), vy(y.data(), 4);
+  ASSERT_EQ(linalg::dot(vx, vy), 20.0);
+  ASSERT_EQ(linalg::dot(linalg::scaled(2.0, vx), vy), 40.0);
+  ASSERT_EQ(linalg::dot(linalg::scaled(2.0, vx), linalg::scaled(-0.5, vy), 1.0), -19.0);
+
+  using c_t = std::complex<double>;
+  std::vector<c_t> a = {{0, 1}, {2, 0}}, b = {{0, 1}, {1, 1}};
+  stdex::mdspan<c_t, stdex::extents<2>> va(a.data()), vb(b.data());
+  // conj(i) * i + 2 * (1 + i) = 1 + 2 + 2i
+  ASSERT_EQ(linalg::dotc(va, vb), c_t(3, 2));
+  ASSERT_EQ(linalg::dot(va, vb), c_t(1, 2));
+}
+
+TEST(TestLinalgBlas1, test_add_scaled_single_pass) {
+  std::vector<double> x = {1, 2, 3, 4, 5, 6}, y = {6, 5, 4, 3, 2, 1}, z(6, 0);
+  stdex::mdspan<double, stdex::extents<2, 3>> mx(x.data()), my(y.data()), mz(z.data());
+  linalg::add(linalg::scaled(2.0, mx), linalg::scaled(-1.0, my), mz);
+  for(size_t i = 0; i < 6; ++i) {
+    ASSERT_EQ(z[i], 2.0 * x[i] - y[i]);
+  }
+  // In-place accumulation: y = y + 3 * x
+  linalg::add(my, linalg::scaled(3.0, mx), my);
+  ASSERT_EQ(y[0], 9.0);
+  ASSERT_EQ(y[5], 19.0);
+
+  // Mixed layouts
+  stdex::mdspan<double, stdex::extents<2, 3>, stdex::layout_left> lx(x.data());
+  linalg::add(lx, mx, mz);
+  ASSERT_EQ((__MDSPAN_OP(mz, 0, 1)), x[2] + x[1]);
+}
+
+TEST(TestLinalgBlas1, test_scale_in_place) {
+  std::vector<float> x = {1, 2, 3, 4};
+  stdex::mdspan<float, stdex::extents<2, 2>> m(x.data());
+  linalg::scale(0.5f, m);
+  ASSERT_EQ(x[3], 2.0f);
+  ASSERT_EQ(x[0], 0.5f);
+}
@@ -0,0 +1,119 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdarray>
+#include <experimental/mdspan_memory>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestMdarray, test_sized_from_mapping) {
+  stdex::mdarray<int, stdex::extents<dyn, 4, dyn>> a(3, 5);
+  ASSERT_EQ(a.rank(), 3);
+  ASSERT_EQ(a.extent(0), 3);
+  ASSERT_EQ(a.extent(1), 4);
+  ASSERT_EQ(a.extent(2), 5);
+  ASSERT_EQ(a.size(), 60);
+  ASSERT_EQ(a.container().size(), 60);
+  __MDSPAN_OP(a, 2, 3, 4) = 7;
+  ASSERT_EQ(a.data()[59], 7);
+
+  stdex::layout_stride::mapping<stdex::extents<2, 3>> strided(
+    stdex::extents<2, 3>(), std::array<size_t, 2>{8, 1});
+  stdex::mdarray<double, stdex::extents<2, 3>, stdex::layout_stride> s(strided);
+  ASSERT_EQ(s.container().size(), strided.required_span_size());
+  ASSERT_FALSE(s.is_contiguous());
+
+  stdex::mdarray<float, stdex::extents<3, 3>> fixed;
+  ASSERT_EQ(fixed.container().size(), 9);
+}
+
+TEST(TestMdarray, test_move_does_not_copy) {
+  stdex::mdarray<int, stdex::dextents<2>> a(100, 100);
+  const int* storage = a.data();
+  auto b = std::move(a);
+  ASSERT_EQ(b.data(), storage);
+  auto c = std::move(b).extract_container();
+  ASSERT_EQ(c.data(), storage);
+  static_assert(std::is_nothrow_move_constructible<stdex::mdarray<int, stdex::dextents<2>>>::value, "");
+}
+
+TEST(TestMdarray, test_to_mdspan) {
+  stdex::mdarray<int, stdex::extents<dyn, dyn>, stdex::layout_left> a(2, 3);
+  for(size_t i = 0; i < 2; ++i)
+    for(size_t j = 0; j < 3; ++j)
+      __MDSPAN_OP(a, i, j) = int(10 * i + j);
+  stdex::mdspan<int, stdex::extents<dyn, dyn>, stdex::layout_left> m = a;
+  ASSERT_EQ(m.data(), a.data());
+  ASSERT_EQ((__MDSPAN_OP(m, 1, 2)), 12);
+  const auto& ca = a;
+  auto cm = ca.to_mdspan();
+  static_assert(std::is_same<decltype(cm)::element_type, const int>::value, "");
+  ASSERT_EQ((__MDSPAN_OP(cm, 1, 0)), 10);
+  // mdspan-sized: the only state beyond the container is the mapping
+  static_assert(sizeof(decltype(a.to_mdspan())) == sizeof(int*) + sizeof(a.mapping()), "");
+
+  stdex::mdarray<int, stdex::extents<dyn, dyn>> r(m);
+  ASSERT_EQ((__MDSPAN_OP(r, 1, 2)), 12);
+  ASSERT_EQ(r.data()[1 * 3 + 2], 12);
+  stdex::mdarray<double, stdex::extents<dyn, 3>> d(m);
+  ASSERT_EQ(d.data()[1 * 3 + 1], 11.0);
+}
+
+TEST(TestMdarray, test_aligned_allocator) {
+  using arr_t = stdex::aligned_mdarray<double, stdex::dextents<2>, stdex::layout_right, 128>;
+  arr_t a(stdex::dextents<2>(17, 9), stdex::aligned_allocator<double, 128>());
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % 128, 0u);
+  ASSERT_EQ(a.container().size(), 17 * 9);
+  arr_t b(5, 5);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 128, 0u);
+  b = a;
+  ASSERT_EQ(b.extent(0), 17);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 128, 0u);
+}
@@ -0,0 +1,172 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_memory>
+
+#include <gtest/gtest.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+struct temp_file {
+  std::string path;
+  temp_file() {
+    char name[] = "/tmp/mdspan_mmap_XXXXXX";
+    int fd = ::mkstemp(name);
+    EXPECT_GE(fd, 0);
+    ::close(fd);
+    path = name;
+  }
+  ~temp_file() { std::remove(path.c_str()); }
+};
+
+} // end anonymous namespace
+
+TEST(TestMMapMDSpan, test_mmap_mdspan_create_and_reopen) {
+  temp_file file;
+  {
+    auto m = stdex::make_mmap_mdspan<double, stdex::extents<dyn, 4>>(file.path, stdex::mmap_mode::create, 3);
+    ASSERT_TRUE(m.is_mapped());
+    ASSERT_EQ(m.size_bytes(), 12 * sizeof(double));
+    auto v = m.view();
+    for(size_t i = 0; i < 3; ++i)
+      for(size_t j = 0; j < 4; ++j)
+        __MDSPAN_OP(v, i, j) = double(i * 10 + j);
+    m.sync();
+  }
+  {
+    auto m = stdex::make_mmap_mdspan<const double, stdex::extents<dyn, 4>>(file.path, stdex::mmap_mode::read_only, 3);
+    stdex::mdspan<const double, stdex::extents<dyn, 4>> v = m;
+    ASSERT_EQ((__MDSPAN_OP(v, 2, 3)), 23.0);
+    ASSERT_EQ((__MDSPAN_OP(v, 1, 0)), 10.0);
+  }
+  // The same bytes viewed through layout_left are the transpose.
+  {
+    auto m = stdex::make_mmap_mdspan<const double, stdex::extents<4, dyn>, stdex::layout_left>(file.path, stdex::mmap_mode::read_only, 3);
+    ASSERT_EQ((__MDSPAN_OP(m.view(), 3, 2)), 23.0);
+  }
+  // create on a larger existing file maps a prefix and never shrinks it.
+  {
+    auto m = stdex::make_mmap_mdspan<double, stdex::extents<dyn, 4>>(file.path, stdex::mmap_mode::create, 1);
+    ASSERT_EQ((__MDSPAN_OP(m.view(), 0, 3)), 3.0);
+  }
+  {
+    // The default mode follows the element type: read_only for const.
+    using ext_t = stdex::extents<3, 4>;
+    stdex::mmap_mdspan<const double, ext_t> m(file.path, stdex::layout_right::mapping<ext_t>());
+    ASSERT_EQ((__MDSPAN_OP(m.view(), 2, 3)), 23.0);
+    static_assert(stdex::mmap_mdspan<const double, ext_t>::default_mode() == stdex::mmap_mode::read_only, "");
+    static_assert(stdex::mmap_mdspan<double, ext_t>::default_mode() == stdex::mmap_mode::read_write, "");
+  }
+}
+
+TEST(TestMMapMDSpan, test_mmap_mdspan_copy_on_write_and_offset) {
+  temp_file file;
+  using ext_t = stdex::extents<8>;
+  {
+    stdex::mmap_options opts;
+    opts.offset = 12;  // not page aligned
+    opts.populate = true;
+    stdex::mmap_mdspan<int, ext_t> m(file.path, stdex::layout_right::mapping<ext_t>(), stdex::mmap_mode::create, opts);
+    for(size_t i = 0; i < 8; ++i) __MDSPAN_OP(m.view(), i) = int(i);
+  }
+  stdex::mmap_options opts;
+  opts.offset = 12;
+  {
+    stdex::mmap_mdspan<int, ext_t> m(file.path, stdex::layout_right::mapping<ext_t>(), stdex::mmap_mode::copy_on_write, opts);
+    ASSERT_EQ((__MDSPAN_OP(m.view(), 5)), 5);
+    __MDSPAN_OP(m.view(), 5) = 42;
+    ASSERT_EQ((__MDSPAN_OP(m.view(), 5)), 42);
+  }
+  {
+    stdex::mmap_mdspan<int, ext_t> m(file.path, stdex::layout_right::mapping<ext_t>(), stdex::mmap_mode::read_write, opts);
+    ASSERT_EQ((__MDSPAN_OP(m.view(), 5)), 5);
+    stdex::mmap_mdspan<int, ext_t> moved(std::move(m));
+    ASSERT_FALSE(m.is_mapped());
+    ASSERT_EQ((__MDSPAN_OP(moved.view(), 7)), 7);
+  }
+}
+
+TEST(TestMMapMDSpan, test_mmap_mdspan_strided_huge_page_aligned) {
+  temp_file file;
+  using ext_t = stdex::extents<dyn, dyn>;
+  {
+    auto m = stdex::make_mmap_mdspan<float, ext_t>(file.path, stdex::mmap_mode::create, 16, 16);
+    for(size_t i = 0; i < 16; ++i)
+      for(size_t j = 0; j < 16; ++j)
+        __MDSPAN_OP(m.view(), i, j) = float(i * 16 + j);
+  }
+  stdex::mmap_options opts;
+  opts.huge_page_aligned = true;
+  // Every other column: a non-contiguous layout gets the random-access hint.
+  stdex::layout_stride::mapping<ext_t> map(ext_t(16, 8), std::array<size_t, 2>{16, 2});
+  stdex::mmap_mdspan<const float, ext_t, stdex::layout_stride> m(file.path, map, stdex::mmap_mode::read_only, opts);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(m.data()) % (2u << 20), 0u);
+  ASSERT_EQ((__MDSPAN_OP(m.view(), 3, 5)), float(3 * 16 + 10));
+}
+
+TEST(TestMMapMDSpan, test_mmap_mdspan_errors) {
+  ASSERT_THROW(
+    (stdex::make_mmap_mdspan<const int, stdex::extents<4>>("/nonexistent/mdspan_mmap", stdex::mmap_mode::read_only)),
+    std::system_error);
+  temp_file file;
+  ASSERT_THROW(
+    (stdex::make_mmap_mdspan<const int, stdex::extents<4>>(file.path, stdex::mmap_mode::read_only)),
+    std::runtime_error);
+  ASSERT_THROW(
+    (stdex::make_mmap_mdspan<int, stdex::extents<4>>(file.path, stdex::mmap_mode::read_only)),
+    std::invalid_argument);
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+size_t page_elements() { return size_t(sysconf(_SC_PAGESIZE)) / sizeof(double); }
+}
+
+TEST(TestNumaAllocator, test_allocation_does_not_touch) {
+  const size_t rows = 64;
+  stdex::numa_mdarray<double, stdex::extents<dyn, dyn>> a(
+    stdex::extents<dyn, dyn>(rows, page_elements()), stdex::numa_allocator<double>());
+  auto before = stdex::numa_page_distribution(a.to_mdspan());
+  ASSERT_EQ(before.total_pages, rows);
+  ASSERT_EQ(before.untouched_pages, rows);
+
+  // touch half the rows, as one worker of a two-way partition would
+  stdex::first_touch_rows(a.to_mdspan(), 0, rows / 2);
+  auto half = stdex::numa_page_distribution(a.to_mdspan());
+  ASSERT_EQ(half.touched_pages(), rows / 2);
+  ASSERT_EQ(std::accumulate(half.pages_per_node.begin(), half.pages_per_node.end(), size_t(0)), rows / 2);
+  ASSERT_EQ((__MDSPAN_OP(a, rows / 2 - 1, 0)), 0.0);
+
+  std::thread worker([&] { stdex::first_touch_rows(a.to_mdspan(), rows / 2, rows); });
+  worker.join();
+  ASSERT_EQ(stdex::numa_page_distribution(a.to_mdspan()).untouched_pages, 0u);
+}
+
+TEST(TestNumaAllocator, test_first_touch_whole_span) {
+  stdex::numa_mdarray<float, stdex::dextents<3>, stdex::layout_left> a(
+    stdex::dextents<3>(100, 30, 20), stdex::numa_allocator<float>());
+  stdex::first_touch(a.to_mdspan());
+  auto report = stdex::numa_page_distribution(a.to_mdspan());
+  ASSERT_EQ(report.untouched_pages, 0u);
+  ASSERT_GE(report.pages_per_node.size(), 1u);
+  ASSERT_EQ((__MDSPAN_OP(a, 99, 29, 19)), 0.0f);
+}
+
+TEST(TestNumaAllocator, test_first_touch_rows_follow_layout) {
+  // layout_left pages are split along the last dimension, so touching the
+  // first half of its indices touches the first half of the pages.
+  const size_t cols = 16;
+  stdex::numa_mdarray<double, stdex::extents<dyn, dyn>, stdex::layout_left> a(
+    stdex::extents<dyn, dyn>(page_elements(), cols), stdex::numa_allocator<double>());
+  ASSERT_EQ(stdex::first_touch_dim(a.to_mdspan()), 1u);
+  stdex::first_touch_rows(a.to_mdspan(), 0, cols / 2);
+  auto report = stdex::numa_page_distribution(a.to_mdspan());
+  ASSERT_EQ(report.total_pages, cols);
+  ASSERT_EQ(report.touched_pages(), cols / 2);
+
+  // A strided view: the dimension with the largest stride.
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>> map(
+    stdex::extents<dyn, dyn>(4, 6), std::array<size_t, 2>{1, 8});
+  std::vector<double> d(6 * 8, 1.0);
+  stdex::mdspan<double, stdex::extents<dyn, dyn>, stdex::layout_stride> s(d.data(), map);
+  ASSERT_EQ(stdex::first_touch_dim(s), 1u);
+  stdex::first_touch_rows(s, 2, 4);
+  ASSERT_EQ(d[2 * 8 + 3], 0.0);
+  ASSERT_EQ(d[3 * 8 + 3], 0.0);
+  ASSERT_EQ(d[1 * 8 + 3], 1.0);
+  ASSERT_EQ(d[2 * 8 + 4], 1.0);
+}
+
+TEST(TestNumaAllocator, test_bind_and_interleave_policies) {
+  stdex::numa_policy bind;
+  bind.placement = stdex::numa_placement::bind;
+  bind.node = 0;
+  stdex::numa_mdarray<double, stdex::dextents<1>> b(stdex::dextents<1>(8 * page_elements()),
+                                                     stdex::numa_allocator<double>(bind));
+  stdex::first_touch(b.to_mdspan());
+  auto rb = stdex::numa_page_distribution(b.to_mdspan());
+  ASSERT_EQ(rb.pages_per_node[0], 8u);
+
+  stdex::numa_policy il;
+  il.placement = stdex::numa_placement::interleave;
+  std::vector<int, stdex::numa_allocator<int>> v(10000, 7, stdex::numa_allocator<int>(il));
+  ASSERT_EQ(v[9999], 7);
+  ASSERT_EQ(stdex::numa_page_distribution(v.data(), v.size() * sizeof(int)).untouched_pages, 0u);
+  ASSERT_TRUE(stdex::numa_allocator<int>(il) != stdex::numa_allocator<int>(bind));
+}
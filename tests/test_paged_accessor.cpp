@@ -0,0 +1,180 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_accessors>
+
+#include <gtest/gtest.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+struct temp_file {
+  std::string path;
+  temp_file() {
+    char name[] = "/tmp/mdspan_paged_XXXXXX";
+    int fd = ::mkstemp(name);
+    EXPECT_GE(fd, 0);
+    ::close(fd);
+    path = name;
+  }
+  ~temp_file() { std::remove(path.c_str()); }
+};
+
+} // end anonymous namespace
+
+TEST(TestPagedAccessor, test_paged_accessor_write_read_back) {
+  temp_file file;
+  {
+    // 10 x 10 ints in pages of 16 elements, at most 2 resident at once.
+    stdex::page_cache<int> cache(file.path, 16, 2, stdex::page_cache_mode::create, 100);
+    auto m = stdex::make_paged_mdspan<int, stdex::extents<dyn, dyn>>(cache, 10, 10);
+    for(size_t i = 0; i < 10; ++i)
+      for(size_t j = 0; j < 10; ++j)
+        __MDSPAN_OP(m, i, j) = int(i * 10 + j);
+    __MDSPAN_OP(m, 3, 3) += 1000;
+    ASSERT_LE(cache.resident_pages(), 2);
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.misses, 8);  // ceil(100 / 16) pages in order, then page 2 again
+    ASSERT_EQ(stats.evictions, 6);
+    ASSERT_EQ(stats.writebacks, 6);
+  }
+  stdex::page_cache<int> cache(file.path, 16, 3);
+  ASSERT_EQ(cache.size(), 100);
+  auto m = stdex::make_paged_mdspan<const int, stdex::extents<dyn, dyn>>(cache, 10, 10);
+  ASSERT_EQ((__MDSPAN_OP(m, 9, 9)), 99);
+  ASSERT_EQ((__MDSPAN_OP(m, 3, 3)), 1033);
+  // Column access through a submdspan
+  auto col = stdex::submdspan(m, stdex::full_extent, 4);
+  int sum = 0;
+  for(size_t i = 0; i < 10; ++i) sum += __MDSPAN_OP(col, i);
+  ASSERT_EQ(sum, 450 + 40);
+  ASSERT_THROW(cache.store(0, 1), std::logic_error);
+}
+
+TEST(TestPagedAccessor, test_paged_accessor_lru_and_pinning) {
+  temp_file file;
+  stdex::page_cache<double> cache(file.path, 4, 2, stdex::page_cache_mode::create, 16);
+  auto m = stdex::make_paged_mdspan<double, stdex::extents<16>>(cache);
+  {
+    auto pinned = cache.pin(0, true);
+    ASSERT_TRUE(bool(pinned));
+    pinned.data()[1] = 7.0;
+    __MDSPAN_OP(m, 4) = 1.0;   // page 1
+    __MDSPAN_OP(m, 8) = 2.0;   // page 2 evicts page 1, not the pinned page 0
+    ASSERT_EQ((double(__MDSPAN_OP(m, 1))), 7.0);
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.evictions, 1);
+    ASSERT_EQ(stats.hits, 1);
+    auto pinned2 = cache.pin(2);
+    // Both resident pages are pinned now.
+    ASSERT_THROW(double(__MDSPAN_OP(m, 12)), std::runtime_error);
+  }
+  ASSERT_EQ((double(__MDSPAN_OP(m, 12))), 0.0);
+  ASSERT_EQ((double(__MDSPAN_OP(m, 4))), 1.0);
+  cache.flush();
+  ASSERT_EQ((double(__MDSPAN_OP(m, 1))), 7.0);
+}
+
+TEST(TestPagedAccessor, test_paged_accessor_threads) {
+  temp_file file;
+  constexpr size_t n = 4096;
+  stdex::page_cache<int> cache(file.path, 64, 8, stdex::page_cache_mode::create, n);
+  auto m = stdex::make_paged_mdspan<int, stdex::extents<dyn>>(cache, n);
+  std::vector<std::thread> threads;
+  for(size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([=] {
+      for(size_t i = t; i < n; i += 4) __MDSPAN_OP(m, i) = int(i);
+    });
+  }
+  for(auto& t : threads) t.join();
+  long long sum = 0;
+  for(size_t i = 0; i < n; ++i) sum += __MDSPAN_OP(m, i);
+  ASSERT_EQ(sum, (long long)(n) * (n - 1) / 2);
+}
+
+TEST(TestPagedAccessor, test_paged_accessor_flush_during_stores) {
+  temp_file file;
+  constexpr size_t n = 1024;
+  {
+    stdex::page_cache<int> cache(file.path, 64, 16, stdex::page_cache_mode::create, n);
+    std::atomic<bool> done{false};
+    std::thread flusher([&] { while(!done.load()) cache.flush(); });
+    for(int round = 1; round <= 20; ++round) {
+      for(size_t i = 0; i < n; ++i) cache.store(i, round * int(i));
+    }
+    done = true;
+    flusher.join();
+    cache.flush();
+  }
+  // Every page holds the last round, none was left marked clean.
+  stdex::page_cache<int> cache(file.path, 64, 16);
+  for(size_t i = 0; i < n; ++i) ASSERT_EQ(cache.load(i), 20 * int(i));
+}
+
+TEST(TestPagedAccessor, test_paged_accessor_create_never_shrinks) {
+  temp_file file;
+  {
+    stdex::page_cache<int> cache(file.path, 8, 2, stdex::page_cache_mode::create, 20);
+    for(size_t i = 0; i < 20; ++i) cache.store(i, int(i));
+  }
+  // Reopening with create and the default element count keeps the file.
+  stdex::page_cache<int> cache(file.path, 8, 2, stdex::page_cache_mode::create);
+  ASSERT_EQ(cache.size(), 20);
+  ASSERT_EQ(cache.load(19), 19);
+  ASSERT_THROW(cache.load(24), std::out_of_range);
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+template <class Policy>
+void check_fill_copy_transform(Policy policy) {
+  std::vector<int> a(7 * 5 * 3), b(a.size()), c(a.size());
+  stdex::mdspan<int, stdex::extents<dyn, 5, 3>> ma(a.data(), 7);
+  stdex::mdspan<int, stdex::extents<dyn, 5, 3>, stdex::layout_left> mb(b.data(), 7);
+  stdex::mdspan<int, stdex::dextents<3>> mc(c.data(), 7, 5, 3);
+
+  stdex::fill(policy, ma, 3);
+  ASSERT_EQ(std::accumulate(a.begin(), a.end(), 0), 3 * int(a.size()));
+
+  std::iota(a.begin(), a.end(), 0);
+  stdex::copy(policy, ma, mb);
+  stdex::for_each_index(ma.extents(), [&](size_t i, size_t j, size_t k) {
+    const int copied = __MDSPAN_OP(mb, i, j, k);
+    const int original = __MDSPAN_OP(ma, i, j, k);
+    ASSERT_EQ(copied, original);
+  });
+
+  stdex::transform(policy, ma, mb, mc, [](int x, int y) { return x + 2 * y; });
+  stdex::transform(policy, mc, mc, [](int x) { return x / 3; });
+  for(size_t n = 0; n < c.size(); ++n) ASSERT_EQ(c[n], int(n));
+
+  stdex::for_each(policy, mb, [](int& x) { x = -x; });
+  ASSERT_EQ(std::accumulate(b.begin(), b.end(), 0), -std::accumulate(a.begin(), a.end(), 0));
+}
+
+TEST(TestParallelAlgorithms, test_fill_copy_transform_seq) {
+  check_fill_copy_transform(stdex::execution::seq);
+}
+
+TEST(TestParallelAlgorithms, test_fill_copy_transform_par) {
+  check_fill_copy_transform(stdex::execution::par);
+  check_fill_copy_transform(stdex::execution::par.with_threads(4));
+  check_fill_copy_transform(stdex::execution::par_unseq.with_threads(3));
+}
+
+TEST(TestParallelAlgorithms, test_reduce) {
+  std::vector<double> a(64 * 33);
+  std::iota(a.begin(), a.end(), 1.0);
+  stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left> m(a.data(), 64, 33);
+  const double expected = 0.5 * double(a.size()) * double(a.size() + 1);
+  ASSERT_EQ(stdex::reduce(stdex::execution::seq, m), expected);
+  ASSERT_EQ(stdex::reduce(stdex::execution::par.with_threads(5), m, 10.0), expected + 10.0);
+  const double largest = stdex::reduce(stdex::execution::par_unseq, m, 0.0,
+    [](double x, double y) { return x > y ? x : y; });
+  ASSERT_EQ(largest, double(a.size()));
+
+  stdex::mdspan<double, stdex::extents<dyn, 0>> empty(a.data(), 4);
+  ASSERT_EQ(stdex::reduce(stdex::execution::par, empty, 7.0), 7.0);
+
+  stdex::mdspan<double, stdex::extents<>> scalar(a.data());
+  ASSERT_EQ(stdex::reduce(stdex::execution::par, scalar, 1.0), 2.0);
+}
+
+TEST(TestParallelAlgorithms, test_for_each_index_layout_stride) {
+  // dimension 1 has the largest stride, so slabs are split along it
+  using exts_t = stdex::dextents<3>;
+  std::vector<std::atomic<int>> hits(3 * 40 * 2);
+  for(auto& h : hits) h = 0;
+  stdex::layout_stride::mapping<exts_t> map(exts_t(3, 40, 2), std::array<size_t, 3>{{2, 6, 1}});
+  stdex::for_each_index(stdex::execution::par.with_threads(4), map, [&](size_t i, size_t j, size_t k) {
+    hits[map(i, j, k)]++;
+  });
+  for(auto& h : hits) ASSERT_EQ(h.load(), 1);
+
+  size_t count = 0;
+  stdex::for_each_index(stdex::execution::seq, stdex::extents<2, dyn>(9), [&](size_t, size_t) { ++count; });
+  ASSERT_EQ(count, 18u);
+}
+
+TEST(TestParallelAlgorithms, test_slab_plan_keeps_cache_lines_apart) {
+  // rows of 3 floats: a slab boundary lands on a line boundary only every 16 rows
+  stdex::layout_right::mapping<stdex::dextents<2>> map(stdex::dextents<2>(100, 3));
+  auto plan = stdex::detail::__plan_slabs(map, 4, sizeof(float));
+  ASSERT_EQ(plan.dim, 0u);
+  ASSERT_EQ(plan.length % 16, 0u);
+  ASSERT_EQ(plan.count, (100 + plan.length - 1) / plan.length);
+
+  stdex::layout_left::mapping<stdex::dextents<2>> lmap(stdex::dextents<2>(32, 100));
+  auto lplan = stdex::detail::__plan_slabs(lmap, 4, sizeof(double));
+  ASSERT_EQ(lplan.dim, 1u);
+  ASSERT_EQ(lplan.length, 25u);
+}
+
+TEST(TestParallelAlgorithms, test_thread_pool) {
+  stdex::detail::__thread_pool pool(4);
+  ASSERT_EQ(pool.size(), 4u);
+  std::vector<std::atomic<int>> hits(1000);
+  for(auto& h : hits) h = 0;
+  for(int rep = 0; rep < 20; ++rep) {
+    pool.run(hits.size(), [&](size_t i) {
+      hits[i]++;
+      // nested loops run inline on the calling worker
+      if(i == 0) pool.run(3, [&](size_t) { hits[1]++; });
+    });
+  }
+  ASSERT_EQ(hits[0].load(), 20);
+  ASSERT_EQ(hits[1].load(), 80);
+  for(size_t i = 2; i < hits.size(); ++i) ASSERT_EQ(hits[i].load(), 20);
+}
+
+TEST(TestParallelAlgorithms, test_thread_pool_exceptions) {
+  stdex::detail::__thread_pool pool(4);
+  for(int rep = 0; rep < 20; ++rep) {
+    std::atomic<int> running{0};
+    ASSERT_THROW(pool.run(1000, [&](size_t i) {
+      running++;
+      std::this_thread::yield();
+      running--;
+      if(i % 97 == 13) throw std::runtime_error("body failed");
+    }), std::runtime_error);
+    // Every iteration that started has finished before run() rethrows.
+    ASSERT_EQ(running.load(), 0);
+  }
+  // The pool is still usable, and the caller is no longer marked as inside a
+  // loop (which would make the next run serial).
+  std::vector<std::atomic<int>> hits(1000);
+  for(auto& h : hits) h = 0;
+  std::atomic<size_t> off_caller{0};
+  const auto caller = std::this_thread::get_id();
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  pool.run(hits.size(), [&](size_t i) {
+    hits[i]++;
+    if(std::this_thread::get_id() != caller) off_caller++;
+    // Give the workers a chance to join in, even on a single core.
+    else while(off_caller.load() == 0 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+  });
+  for(auto& h : hits) ASSERT_EQ(h.load(), 1);
+  ASSERT_GT(off_caller.load(), 0u);
+}
@@ -0,0 +1,171 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+// Not default_accessor, so reduce takes the element-by-element path.
+template <class T>
+struct other_accessor : stdex::default_accessor<T> {
+  using offset_policy = other_accessor;
+};
+
+TEST(TestReduce, test_reduce_layouts) {
+  std::vector<int> a(40 * 19 * 5);
+  for(size_t k = 0; k < a.size(); ++k) a[k] = int(k % 97) - 40;
+  auto right = stdex::mdspan<int, stdex::dextents<3>>(a.data(), 37, 19, 5);
+  auto left = stdex::mdspan<int, stdex::dextents<3>, stdex::layout_left>(a.data(), 37, 19, 5);
+  // every dimension strided, padding between the rows of dimension 0
+  auto padded = stdex::mdspan<int, stdex::dextents<3>, stdex::layout_stride>(
+    a.data(), stdex::layout_stride::mapping<stdex::dextents<3>>(
+      stdex::dextents<3>(37, 19, 5), std::array<size_t, 3>{5, 200, 1}));
+  auto other = stdex::mdspan<int, stdex::dextents<3>, stdex::layout_right, other_accessor<int>>(a.data(), 37, 19, 5);
+
+  int expected = 0;
+  for(size_t k = 0; k < 37 * 19 * 5; ++k) expected += a[k];
+  int expected_padded = 0;
+  stdex::for_each_index(padded.extents(), [&](size_t i, size_t j, size_t k) {
+    expected_padded += a[i * 5 + j * 200 + k];
+  });
+
+  ASSERT_EQ(stdex::reduce(right), expected);
+  ASSERT_EQ(stdex::reduce(left, 3), expected + 3);
+  ASSERT_EQ(stdex::reduce(padded, 0, std::plus<>()), expected_padded);
+  ASSERT_EQ(stdex::reduce(other), expected);
+  ASSERT_EQ(stdex::reduce(stdex::execution::par.with_threads(3), left), expected);
+  ASSERT_EQ(stdex::reduce(stdex::execution::par.with_threads(4), padded, 0), expected_padded);
+  ASSERT_EQ(stdex::reduce(right, -1000, [](int x, int y) { return x > y ? x : y; }), 56);
+  ASSERT_EQ(stdex::reduce(other, 1000, [](int x, int y) { return x < y ? x : y; }), -40);
+
+  auto empty = stdex::mdspan<int, stdex::extents<dyn, 0>>(a.data(), 4);
+  ASSERT_EQ(stdex::reduce(empty, 7), 7);
+  ASSERT_EQ(stdex::reduce(empty, 7, std::plus<>(), stdex::deterministic), 7);
+  auto scalar = stdex::mdspan<int, stdex::extents<>>(a.data());
+  ASSERT_EQ(stdex::reduce(scalar, 1), a[0] + 1);
+}
+
+TEST(TestReduce, test_reduce_deterministic_is_bitwise_reproducible) {
+  std::vector<float> a(64 * 50 * 31);
+  for(size_t k = 0; k < a.size(); ++k) a[k] = 1.0f / float(k % 1013 + 1) - 0.0005f * float(k % 7);
+  auto m = stdex::mdspan<float, stdex::dextents<3>, stdex::layout_left>(a.data(), 64, 50, 31);
+
+  const float reference = stdex::reduce(m, 0.5f, std::plus<>(), stdex::deterministic);
+  double exact = 0.5;
+  for(float x : a) exact += double(x);
+  ASSERT_NEAR(double(reference), exact, 1e-5 * double(a.size()) * 1e-3);
+
+  for(size_t threads = 1; threads <= 7; ++threads) {
+    const float r = stdex::reduce(stdex::execution::par.with_threads(threads), m, 0.5f, std::plus<>(), stdex::deterministic);
+    ASSERT_EQ(std::memcmp(&r, &reference, sizeof(float)), 0) << threads;
+  }
+  const float r = stdex::reduce(stdex::execution::par_unseq, m, 0.5f, std::plus<>(), stdex::deterministic);
+  ASSERT_EQ(std::memcmp(&r, &reference, sizeof(float)), 0);
+}
+
+template <size_t R, class Src>
+void check_reduce_axis(Src src) {
+  using dst_extents = stdex::dextents<2>;
+  std::array<size_t, 2> e;
+  for(size_t r = 0, o = 0; r < 3; ++r) if(r != R) e[o++] = src.extent(r);
+  std::vector<long> expected(e[0] * e[1], 10);
+  stdex::for_each_index(src.extents(), [&](size_t i, size_t j, size_t k) {
+    const size_t idx[3] = {i, j, k};
+    size_t o[2];
+    for(size_t r = 0, n = 0; r < 3; ++r) if(r != R) o[n++] = idx[r];
+    expected[o[0] * e[1] + o[1]] += __MDSPAN_OP(src, i, j, k);
+  });
+
+  std::vector<long> b(e[0] * e[1], -1);
+  auto right = stdex::mdspan<long, dst_extents>(b.data(), e[0], e[1]);
+  stdex::reduce_axis<R>(src, right, 10l, std::plus<>());
+  ASSERT_EQ(b, expected) << R;
+
+  std::vector<long> c(e[0] * e[1], -1);
+  auto left = stdex::mdspan<long, dst_extents, stdex::layout_left>(c.data(), e[0], e[1]);
+  stdex::reduce_axis<R>(stdex::execution::par.with_threads(3), src, left, 10l, std::plus<>());
+  for(size_t i = 0; i < e[0]; ++i) {
+    for(size_t j = 0; j < e[1]; ++j) {
+      long v = __MDSPAN_OP(left, i, j);
+      ASSERT_EQ(v, expected[i * e[1] + j]) << R;
+    }
+  }
+}
+
+TEST(TestReduce, test_reduce_axis) {
+  std::vector<long> a(7 * 5 * 9);
+  for(size_t k = 0; k < a.size(); ++k) a[k] = long(k * k % 31);
+  auto right = stdex::mdspan<long, stdex::dextents<3>>(a.data(), 7, 5, 9);
+  auto left = stdex::mdspan<long, stdex::extents<7, dyn, 9>, stdex::layout_left>(a.data(), 5);
+  auto other = stdex::mdspan<long, stdex::dextents<3>, stdex::layout_right, other_accessor<long>>(a.data(), 7, 5, 9);
+  check_reduce_axis<0>(right);
+  check_reduce_axis<1>(right);
+  check_reduce_axis<2>(right);
+  check_reduce_axis<0>(left);
+  check_reduce_axis<1>(left);
+  check_reduce_axis<2>(left);
+  check_reduce_axis<0>(other);
+  check_reduce_axis<2>(other);
+
+  // rank 1 to rank 0, and an empty reduced dimension
+  long total = 0;
+  auto line = stdex::mdspan<long, stdex::dextents<1>>(a.data(), 100);
+  auto out = stdex::mdspan<long, stdex::extents<>>(&total);
+  stdex::reduce_axis<0>(line, out);
+  long expected = 0;
+  for(size_t k = 0; k < 100; ++k) expected += a[k];
+  ASSERT_EQ(total, expected);
+
+  std::vector<long> d(6, -1);
+  auto empty = stdex::mdspan<long, stdex::dextents<2>>(a.data(), 6, 0);
+  stdex::reduce_axis<1>(stdex::execution::par, empty, stdex::mdspan<long, stdex::dextents<1>>(d.data(), 6), 4l, std::plus<>());
+  ASSERT_EQ(d, std::vector<long>(6, 4));
+}
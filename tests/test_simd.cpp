@@ -0,0 +1,156 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_simd>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+
+// Not default_accessor, so load_simd/store_simd go element by element.
+template <class T>
+struct other_accessor : stdex::default_accessor<T> {
+  using offset_policy = other_accessor;
+};
+
+TEST(TestSimd, test_simd_contiguous) {
+  std::vector<float> a(4 * 16), b(4 * 16, 0.f);
+  for(size_t k = 0; k < a.size(); ++k) a[k] = float(k);
+  auto x = stdex::mdspan<float, stdex::dextents<2>>(a.data(), 4, 16);
+  auto y = stdex::mdspan<float, stdex::dextents<2>>(b.data(), 4, 16);
+  for(size_t i = 0; i < 4; ++i) {
+    for(size_t k = 0; k < 16; k += 8) {
+      stdex::simd_batch<float, 8> v = stdex::load_simd<8>(x, i, k);
+      v = v + v;
+      stdex::store_simd<8>(y, v, i, k);
+    }
+  }
+  for(size_t k = 0; k < a.size(); ++k) ASSERT_EQ(b[k], 2.f * a[k]);
+}
+
+TEST(TestSimd, test_simd_tail) {
+  // A 3 x 6 window inside a 3 x 8 array: the second batch of each row has two
+  // lanes, the columns past the window must be left alone.
+  std::vector<int> a(3 * 8), b(3 * 8, -1);
+  for(size_t k = 0; k < a.size(); ++k) a[k] = int(k);
+  using map_t = stdex::layout_stride::mapping<stdex::dextents<2>>;
+  map_t map(stdex::dextents<2>(3, 6), std::array<size_t, 2>{8, 1});
+  auto x = stdex::mdspan<int, stdex::dextents<2>, stdex::layout_stride>(a.data(), map);
+  auto y = stdex::mdspan<int, stdex::dextents<2>, stdex::layout_stride>(b.data(), map);
+  for(size_t i = 0; i < 3; ++i) {
+    auto v = stdex::load_simd<4>(x, i, 4);
+    int l0 = v[0], l1 = v[1], l2 = v[2], l3 = v[3];
+    ASSERT_EQ(l0, int(i * 8 + 4));
+    ASSERT_EQ(l1, int(i * 8 + 5));
+    ASSERT_EQ(l2, 0);
+    ASSERT_EQ(l3, 0);
+    stdex::store_simd<4>(y, stdex::load_simd<4>(x, i, 0), i, 0);
+    stdex::store_simd<4>(y, v, i, 4);
+  }
+  for(size_t i = 0; i < 3; ++i) {
+    for(size_t k = 0; k < 8; ++k) ASSERT_EQ(b[i * 8 + k], k < 6 ? a[i * 8 + k] : -1);
+  }
+}
+
+TEST(TestSimd, test_simd_strided) {
+  std::vector<double> a(5 * 7), b(5 * 7, 0.);
+  for(size_t k = 0; k < a.size(); ++k) a[k] = double(k);
+  auto x = stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left>(a.data(), 5, 7);
+  auto y = stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left>(b.data(), 5, 7);
+  // along the last dimension of layout_left: a gather with stride 5
+  for(size_t i = 0; i < 5; ++i) {
+    auto v = stdex::load_simd<4, 1>(x, i, 4);
+    for(size_t l = 0; l < 3; ++l) {
+      double e = v[l];
+      double expected = __MDSPAN_OP(x, i, 4 + l);
+      ASSERT_EQ(e, expected);
+    }
+    stdex::store_simd<4, 1>(y, stdex::load_simd<4, 1>(x, i, 0), i, 0);
+    stdex::store_simd<4, 1>(y, v, i, 4);
+  }
+  for(size_t k = 0; k < a.size(); ++k) ASSERT_EQ(b[k], a[k]);
+
+  // along dimension 0 of layout_left: contiguous, three lanes then a tail of two
+  std::fill(b.begin(), b.end(), 0.);
+  for(size_t j = 0; j < 7; ++j) {
+    stdex::store_simd<3, 0>(y, stdex::load_simd<3, 0>(x, 0, j), 0, j);
+    stdex::store_simd<3, 0>(y, stdex::load_simd<3, 0>(x, 3, j), 3, j);
+  }
+  for(size_t k = 0; k < a.size(); ++k) ASSERT_EQ(b[k], a[k]);
+
+  // without Dim, layout_left runs along dimension 0 as well
+  std::fill(b.begin(), b.end(), 0.);
+  for(size_t j = 0; j < 7; ++j) {
+    auto v = stdex::load_simd<4>(x, 1, j);
+    for(size_t l = 0; l < 4; ++l) {
+      double e = v[l];
+      double expected = __MDSPAN_OP(x, 1 + l, j);
+      ASSERT_EQ(e, expected);
+    }
+    stdex::store_simd<4>(y, v, 1, j);
+  }
+  for(size_t j = 0; j < 7; ++j) {
+    for(size_t i = 0; i < 5; ++i) {
+      double expected = i == 0 ? 0. : __MDSPAN_OP(x, i, j);
+      ASSERT_EQ(__MDSPAN_OP(y, i, j), expected);
+    }
+  }
+}
+
+TEST(TestSimd, test_simd_accessor) {
+  std::vector<int> a(2 * 3 * 5), b(2 * 3 * 5, 0);
+  for(size_t k = 0; k < a.size(); ++k) a[k] = int(k) * 3;
+  using mdspan_t = stdex::mdspan<int, stdex::dextents<3>, stdex::layout_right, other_accessor<int>>;
+  auto x = mdspan_t(a.data(), 2, 3, 5);
+  auto y = mdspan_t(b.data(), 2, 3, 5);
+  for(size_t i = 0; i < 2; ++i) {
+    for(size_t k = 0; k < 5; ++k) {
+      stdex::store_simd<2, 1>(y, stdex::load_simd<2, 1>(x, i, 0, k), i, 0, k);
+      stdex::store_simd<2, 1>(y, stdex::load_simd<2, 1>(x, i, 2, k), i, 2, k);
+    }
+  }
+  for(size_t k = 0; k < a.size(); ++k) ASSERT_EQ(b[k], a[k]);
+}
@@ -0,0 +1,137 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdarray>
+#include <experimental/mdspan_memory>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+
+using mat3_t = stdex::static_mdarray<float, stdex::extents<3, 3>>;
+
+TEST(TestStaticMdarray, test_inline_storage) {
+  static_assert(std::is_trivially_copyable<mat3_t>::value, "");
+  static_assert(std::is_same<mat3_t::container_type, std::array<float, 9>>::value, "");
+#if defined(_MDSPAN_USE_ATTRIBUTE_NO_UNIQUE_ADDRESS)
+  static_assert(sizeof(mat3_t) == 9 * sizeof(float), "");
+#endif
+  mat3_t a;
+  ASSERT_EQ(a.size(), 9);
+  ASSERT_EQ((__MDSPAN_OP(a, 2, 2)), 0.0f);
+  __MDSPAN_OP(a, 1, 2) = 4.0f;
+  mat3_t b = a;
+  ASSERT_NE(b.data(), a.data());
+  ASSERT_EQ((__MDSPAN_OP(b, 1, 2)), 4.0f);
+  auto v = b.to_mdspan();
+  ASSERT_EQ(v.data(), b.data());
+  ASSERT_EQ((__MDSPAN_OP(v, 1, 2)), 4.0f);
+}
+
+TEST(TestStaticMdarray, test_batch_view) {
+  std::vector<mat3_t> batch(4);
+  __MDSPAN_OP(batch[2], 0, 1) = 5.0f;
+  auto view = stdex::batch_view(batch.data(), batch.size());
+  static_assert(std::is_same<decltype(view)::layout_type, stdex::layout_right>::value, "");
+  ASSERT_EQ(view.extent(0), 4);
+  ASSERT_EQ(view.extent(1), 3);
+  ASSERT_EQ((__MDSPAN_OP(view, 2, 0, 1)), 5.0f);
+  __MDSPAN_OP(view, 3, 2, 1) = 6.0f;
+  ASSERT_EQ((__MDSPAN_OP(batch[3], 2, 1)), 6.0f);
+
+  using lmat_t = stdex::static_mdarray<double, stdex::extents<2, 3>, stdex::layout_left>;
+  std::vector<lmat_t> lbatch(3);
+  __MDSPAN_OP(lbatch[1], 1, 2) = 7.0;
+  const lmat_t* cfirst = lbatch.data();
+  auto lview = stdex::batch_view(cfirst, lbatch.size());
+  static_assert(std::is_same<decltype(lview)::element_type, const double>::value, "");
+  ASSERT_EQ(lview.stride(0), 6);
+  ASSERT_EQ(lview.stride(1), 1);
+  ASSERT_EQ(lview.stride(2), 2);
+  ASSERT_EQ((__MDSPAN_OP(lview, 1, 1, 2)), 7.0);
+}
+
+TEST(TestStaticMdarray, test_batched_add) {
+  const size_t n = 1001;
+  std::vector<mat3_t> a(n), b(n), c(n);
+  for(size_t m = 0; m < n; ++m) {
+    for(size_t i = 0; i < 3; ++i) {
+      for(size_t j = 0; j < 3; ++j) {
+        __MDSPAN_OP(a[m], i, j) = float(m + i);
+        __MDSPAN_OP(b[m], i, j) = float(j);
+      }
+    }
+  }
+  stdex::batched_add(a.data(), b.data(), c.data(), n);
+  for(size_t m = 0; m < n; m += 97) {
+    ASSERT_EQ((__MDSPAN_OP(c[m], 2, 1)), float(m + 2 + 1));
+  }
+  // in place
+  stdex::batched_add(c.data(), b.data(), c.data(), n);
+  ASSERT_EQ((__MDSPAN_OP(c[n - 1], 0, 2)), float(n - 1 + 4));
+}
+
+TEST(TestStaticMdarray, test_batched_matrix_product) {
+  using a_t = stdex::static_mdarray<int, stdex::extents<2, 3>>;
+  using b_t = stdex::static_mdarray<int, stdex::extents<3, 2>>;
+  using c_t = stdex::static_mdarray<int, stdex::extents<2, 2>>;
+  std::vector<a_t> a(2);
+  std::vector<b_t> b(2);
+  std::vector<c_t> c(2);
+  for(size_t m = 0; m < 2; ++m) {
+    for(size_t i = 0; i < 2; ++i)
+      for(size_t k = 0; k < 3; ++k)
+        __MDSPAN_OP(a[m], i, k) = int(i * 3 + k + m);
+    for(size_t k = 0; k < 3; ++k)
+      for(size_t j = 0; j < 2; ++j)
+        __MDSPAN_OP(b[m], k, j) = int(k == j);
+  }
+  stdex::batched_matrix_product(a.data(), b.data(), c.data(), 2);
+  // b selects the first two columns of a
+  ASSERT_EQ((__MDSPAN_OP(c[0], 1, 1)), 4);
+  ASSERT_EQ((__MDSPAN_OP(c[1], 1, 0)), 4);
+  ASSERT_EQ((__MDSPAN_OP(c[1], 0, 1)), 2);
+}
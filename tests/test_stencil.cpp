@@ -0,0 +1,160 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_algorithm>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+
+namespace {
+
+// The neighborhood the plain reference sweep below hands to the kernels.
+template <class MDSpan>
+struct reference_neighborhood {
+  MDSpan m;
+  std::array<size_t, MDSpan::extents_type::rank()> idx;
+
+  template <class... Offsets>
+  double operator()(Offsets... ds) const {
+    std::array<ptrdiff_t, sizeof...(Offsets)> d{{ptrdiff_t(ds)...}};
+    std::array<size_t, sizeof...(Offsets)> at;
+    for(size_t r = 0; r < at.size(); ++r) at[r] = size_t(ptrdiff_t(idx[r]) + d[r]);
+    return m.accessor().access(m.data(), stdex::detail::__offset(m.mapping(), at));
+  }
+  std::array<size_t, MDSpan::extents_type::rank()> const& index() const { return idx; }
+};
+
+template <size_t Radius, class MDSpan, class F>
+MDSpan reference_sweep(MDSpan a, MDSpan b, size_t steps, F f) {
+  constexpr size_t rank = MDSpan::extents_type::rank();
+  for(size_t s = 0; s < steps; ++s) {
+    stdex::for_each_index(a.extents(), [&](auto... is) {
+      std::array<size_t, rank> idx{{size_t(is)...}};
+      bool interior = true;
+      for(size_t r = 0; r < rank; ++r) interior = interior && idx[r] >= Radius && idx[r] + Radius < a.extent(r);
+      double& out = b.accessor().access(b.data(), stdex::detail::__offset(b.mapping(), idx));
+      out = interior ? f(reference_neighborhood<MDSpan>{a, idx}) : a.accessor().access(a.data(), stdex::detail::__offset(a.mapping(), idx));
+    });
+    std::swap(a, b);
+  }
+  return a;
+}
+
+struct heat_2d {
+  template <class NB>
+  double operator()(NB const& nb) const {
+    // depends on the position so that misplaced points show up
+    const double w = 0.1 + 0.01 * double(nb.index()[0] % 3) + 0.02 * double(nb.index()[1] % 5);
+    return (1 - 4 * w) * nb(0, 0) + w * (nb(-1, 0) + nb(1, 0) + nb(0, -1) + nb(0, 1));
+  }
+};
+
+struct box_3d {
+  template <class NB>
+  double operator()(NB const& nb) const {
+    double sum = 0;
+    for(int i = -1; i <= 1; ++i)
+      for(int j = -1; j <= 1; ++j)
+        for(int k = -1; k <= 1; ++k) sum += nb(i, j, k);
+    return sum / 27 + 0.001 * double(nb.index()[2]);
+  }
+};
+
+struct wide_1d {
+  template <class NB>
+  double operator()(NB const& nb) const {
+    return 0.5 * nb(0) + 0.2 * (nb(-1) + nb(1)) + 0.05 * (nb(-2) + nb(2));
+  }
+};
+
+void fill(std::vector<double>& storage) {
+  for(size_t k = 0; k < storage.size(); ++k) storage[k] = double((k * 37) % 101) / 10;
+}
+
+} // end anonymous namespace
+
+TEST(TestStencil, test_stencil_2d) {
+  using mdspan_t = stdex::mdspan<double, stdex::dextents<2>>;
+  const size_t n0 = 23, n1 = 17;
+  for(size_t steps : {0, 1, 5, 8}) {
+    for(stdex::stencil_blocking blocking : {stdex::stencil_blocking{1, 0}, stdex::stencil_blocking{3, 0},
+                                            stdex::stencil_blocking{4, 5}, stdex::stencil_blocking{8, 1}}) {
+      std::vector<double> a(n0 * n1), b(n0 * n1, -1.), ra(n0 * n1), rb(n0 * n1, -1.);
+      fill(a);
+      ra = a;
+      auto expected = reference_sweep<1>(mdspan_t(ra.data(), n0, n1), mdspan_t(rb.data(), n0, n1), steps, heat_2d());
+      auto result = stdex::stencil_sweep<1>(stdex::execution::par, mdspan_t(a.data(), n0, n1), mdspan_t(b.data(), n0, n1),
+                                            steps, heat_2d(), blocking);
+      for(size_t k = 0; k < n0 * n1; ++k) ASSERT_NEAR(result.data()[k], expected.data()[k], 1e-12) << k;
+    }
+  }
+}
+
+TEST(TestStencil, test_stencil_3d_layout_left) {
+  using mdspan_t = stdex::mdspan<double, stdex::dextents<3>, stdex::layout_left>;
+  const size_t n0 = 11, n1 = 14, n2 = 9;
+  for(stdex::stencil_blocking blocking : {stdex::stencil_blocking{1, 0}, stdex::stencil_blocking{4, 3}}) {
+    std::vector<double> a(n0 * n1 * n2), b(n0 * n1 * n2, -1.), ra(n0 * n1 * n2), rb(n0 * n1 * n2, -1.);
+    fill(a);
+    ra = a;
+    auto expected = reference_sweep<1>(mdspan_t(ra.data(), n0, n1, n2), mdspan_t(rb.data(), n0, n1, n2), 7, box_3d());
+    auto result = stdex::stencil_sweep<1>(mdspan_t(a.data(), n0, n1, n2), mdspan_t(b.data(), n0, n1, n2),
+                                          7, box_3d(), blocking);
+    for(size_t k = 0; k < n0 * n1 * n2; ++k) ASSERT_NEAR(result.data()[k], expected.data()[k], 1e-12) << k;
+  }
+}
+
+TEST(TestStencil, test_stencil_1d_radius_2) {
+  using mdspan_t = stdex::mdspan<double, stdex::dextents<1>>;
+  const size_t n = 40;
+  std::vector<double> a(n), b(n, -1.), ra(n), rb(n, -1.);
+  fill(a);
+  ra = a;
+  auto expected = reference_sweep<2>(mdspan_t(ra.data(), n), mdspan_t(rb.data(), n), 6, wide_1d());
+  auto result = stdex::stencil_sweep<2>(stdex::execution::seq, mdspan_t(a.data(), n), mdspan_t(b.data(), n), 6, wide_1d());
+  for(size_t k = 0; k < n; ++k) ASSERT_NEAR(result.data()[k], expected.data()[k], 1e-12) << k;
+}
@@ -0,0 +1,165 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestWorkStealing, test_deque_owner_is_lifo_thief_is_fifo) {
+  stdex::detail::__chase_lev_deque<int> d(2);
+  std::vector<int> items(100);
+  for(int i = 0; i < 100; ++i) { items[i] = i; d.push(&items[i]); }
+  ASSERT_EQ(*d.take(), 99);
+  ASSERT_EQ(*d.steal(), 0);
+  ASSERT_EQ(*d.steal(), 1);
+  int taken = 3;
+  while(d.take() != nullptr) ++taken;
+  ASSERT_EQ(taken, 100);
+  ASSERT_TRUE(d.empty());
+  ASSERT_EQ(d.steal(), nullptr);
+}
+
+TEST(TestWorkStealing, test_deque_concurrent_steal) {
+  // every item is taken or stolen exactly once
+  stdex::detail::__chase_lev_deque<int> d;
+  const int n = 20000;
+  std::vector<int> items(n);
+  std::vector<std::atomic<int>> seen(n);
+  for(auto& s : seen) s = 0;
+  std::atomic<int> consumed{0};
+  std::vector<std::thread> thieves;
+  for(int t = 0; t < 3; ++t) {
+    thieves.emplace_back([&] {
+      while(consumed.load() < n) {
+        if(int* p = d.steal()) { seen[*p]++; consumed++; }
+      }
+    });
+  }
+  for(int i = 0; i < n; ++i) {
+    items[i] = i;
+    d.push(&items[i]);
+    if(i % 3 == 0) {
+      if(int* p = d.take()) { seen[*p]++; consumed++; }
+    }
+  }
+  while(int* p = d.take()) { seen[*p]++; consumed++; }
+  for(auto& t : thieves) t.join();
+  ASSERT_EQ(consumed.load(), n);
+  for(auto& s : seen) ASSERT_EQ(s.load(), 1);
+}
+
+template <class Policy>
+void check_tiles_cover_once(Policy policy) {
+  std::vector<std::atomic<int>> hits(37 * 23 * 5);
+  for(auto& h : hits) h = 0;
+  stdex::extents<dyn, 23, 5> exts(37);
+  stdex::layout_right::mapping<decltype(exts)> map(exts);
+  std::atomic<size_t> tiles{0};
+  stdex::for_each_tile(policy, exts, 100, [&](std::array<size_t, 3> const& lo, std::array<size_t, 3> const& hi) {
+    size_t volume = 1;
+    for(size_t r = 0; r < 3; ++r) volume *= hi[r] - lo[r];
+    ASSERT_LE(volume, 100u);
+    ASSERT_GT(volume, 0u);
+    for(size_t i = lo[0]; i < hi[0]; ++i)
+      for(size_t j = lo[1]; j < hi[1]; ++j)
+        for(size_t k = lo[2]; k < hi[2]; ++k) hits[map(i, j, k)]++;
+    tiles++;
+  });
+  ASSERT_GE(tiles.load(), hits.size() / 100);
+  for(auto& h : hits) ASSERT_EQ(h.load(), 1);
+}
+
+TEST(TestWorkStealing, test_tiles_cover_extents_once) {
+  check_tiles_cover_once(stdex::execution::seq);
+  check_tiles_cover_once(stdex::execution::par);
+  check_tiles_cover_once(stdex::execution::par.with_threads(4));
+}
+
+TEST(TestWorkStealing, test_tiles_are_submdspans) {
+  std::vector<int> buf(64 * 40, 0);
+  stdex::mdspan<int, stdex::dextents<2>, stdex::layout_left> m(buf.data(), 64, 40);
+  stdex::for_each_tile(stdex::execution::par.with_threads(3), m, 256, [](auto sub, std::array<size_t, 2> const& origin) {
+    // layout_left splits the last (slowest) dimension first, so tiles keep whole columns
+    ASSERT_EQ(sub.extent(0), 64u);
+    for(size_t j = 0; j < sub.extent(1); ++j)
+      for(size_t i = 0; i < sub.extent(0); ++i)
+        sub[std::array<size_t, 2>{{i, j}}] += int(origin[1] + j);
+  });
+  for(size_t j = 0; j < 40; ++j)
+    for(size_t i = 0; i < 64; ++i) ASSERT_EQ(buf[i + 64 * j], int(j));
+}
+
+TEST(TestWorkStealing, test_tile_cuts_respect_cache_lines) {
+  // rows of 3 floats: cuts along dimension 0 land on multiples of 16 rows
+  std::vector<float> buf(100 * 3);
+  stdex::mdspan<float, stdex::extents<dyn, 3>> m(buf.data(), 100);
+  std::atomic<int> bad{0};
+  stdex::for_each_tile(stdex::execution::par.with_threads(4), m, 100, [&](auto, std::array<size_t, 2> const& origin) {
+    if(origin[0] % 16 != 0) bad++;
+  });
+  ASSERT_EQ(bad.load(), 0);
+}
+
+TEST(TestWorkStealing, test_tile_exceptions) {
+  // One throwing tile stops the others and reaches the caller instead of
+  // leaving the workers waiting for its indices.
+  for(int rep = 0; rep < 10; ++rep) {
+    std::atomic<int> thrown{0};
+    ASSERT_THROW(stdex::for_each_tile(stdex::execution::par.with_threads(4), stdex::dextents<2>(256, 256), 64,
+      [&](std::array<size_t, 2> const& lo, std::array<size_t, 2> const&) {
+        if(lo[0] >= 128 && thrown.exchange(1) == 0) throw std::runtime_error("tile failed");
+      }), std::runtime_error);
+  }
+  ASSERT_THROW(stdex::for_each_tile(stdex::execution::seq, stdex::dextents<1>(100), 10,
+    [](std::array<size_t, 1> const& lo, std::array<size_t, 1> const&) {
+      if(lo[0] == 50) throw std::runtime_error("tile failed");
+    }), std::runtime_error);
+}